@@ -0,0 +1,212 @@
+// Compares two Google Benchmark JSON reports and fails on regressions:
+//   s21_bench_compare baseline.json current.json [threshold_percent]
+// Every benchmark of both reports is listed with the change of its real
+// time. The exit status is 1 when one got slower than the threshold (10%
+// by default) allows, 2 when a report cannot be read. When a report has
+// repetitions, the median aggregate stands for the benchmark, and a
+// slowdown within twice the standard deviations of both runs is put down
+// to noise rather than reported.
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+struct Result {
+  double nanoseconds = 0;
+  double stddev = 0;
+  bool median = false;
+};
+
+using Report = std::map<std::string, Result>;
+
+// Reader for the flat objects of the "benchmarks" array; counters are
+// written as plain fields of the object, so nothing nests deeper.
+class Parser {
+ public:
+  explicit Parser(const std::string& text) : text_(text), position_(0) {}
+
+  Report Parse() {
+    const std::size_t key = text_.find("\"benchmarks\"");
+    if (key == std::string::npos) Fail("no benchmarks");
+    position_ = key + 12;
+    Expect(':');
+    Expect('[');
+    Report report;
+    Skip();
+    if (Peek() == ']') return report;
+    do {
+      Add(ParseObject(), report);
+    } while (Accept(','));
+    Expect(']');
+    return report;
+  }
+
+ private:
+  using Object = std::map<std::string, std::string>;
+
+  const std::string& text_;
+  std::size_t position_;
+
+  [[noreturn]] void Fail(const std::string& what) const {
+    throw std::runtime_error(what + " at byte " + std::to_string(position_));
+  }
+
+  void Skip() {
+    while (position_ < text_.size() &&
+           std::isspace(static_cast<unsigned char>(text_[position_]))) {
+      ++position_;
+    }
+  }
+
+  char Peek() {
+    Skip();
+    return position_ < text_.size() ? text_[position_] : '\0';
+  }
+
+  bool Accept(char c) {
+    if (Peek() != c) return false;
+    ++position_;
+    return true;
+  }
+
+  void Expect(char c) {
+    if (!Accept(c)) Fail(std::string("expected '") + c + "'");
+  }
+
+  std::string ParseString() {
+    Expect('"');
+    std::string value;
+    while (position_ < text_.size() && text_[position_] != '"') {
+      if (text_[position_] == '\\') ++position_;
+      if (position_ < text_.size()) value += text_[position_++];
+    }
+    Expect('"');
+    return value;
+  }
+
+  // Numbers, true, false and null, kept as their text
+  std::string ParseScalar() {
+    const std::size_t start = position_;
+    while (position_ < text_.size() && text_[position_] != ',' &&
+           text_[position_] != '}' &&
+           !std::isspace(static_cast<unsigned char>(text_[position_]))) {
+      ++position_;
+    }
+    if (start == position_) Fail("expected a value");
+    return text_.substr(start, position_ - start);
+  }
+
+  Object ParseObject() {
+    Expect('{');
+    Object object;
+    if (Accept('}')) return object;
+    do {
+      std::string key = ParseString();
+      Expect(':');
+      object[key] = Peek() == '"' ? ParseString() : ParseScalar();
+    } while (Accept(','));
+    Expect('}');
+    return object;
+  }
+
+  static double Nanoseconds(const Object& object) {
+    static const std::map<std::string, double> kUnits = {
+        {"ns", 1}, {"us", 1e3}, {"ms", 1e6}, {"s", 1e9}};
+    const auto unit = object.find("time_unit");
+    const auto scale = kUnits.find(unit == object.end() ? "ns" : unit->second);
+    return std::strtod(object.at("real_time").c_str(), nullptr) *
+           (scale == kUnits.end() ? 1 : scale->second);
+  }
+
+  static void Add(const Object& object, Report& report) {
+    const auto run_type = object.find("run_type");
+    const bool aggregate =
+        run_type != object.end() && run_type->second == "aggregate";
+    if (object.count("error_occurred") || !object.count("real_time")) return;
+    const std::string& name =
+        object.at(object.count("run_name") ? "run_name" : "name");
+    Result& result = report[name];
+    if (aggregate && object.at("aggregate_name") == "stddev") {
+      result.stddev = Nanoseconds(object);
+      return;
+    }
+    if (aggregate && object.at("aggregate_name") != "median") return;
+    if (result.median && !aggregate) return;
+    result.nanoseconds = Nanoseconds(object);
+    result.median = aggregate;
+  }
+};
+
+Report Load(const char* path) {
+  std::ifstream stream(path);
+  if (!stream) throw std::runtime_error(std::string("cannot open ") + path);
+  std::ostringstream text;
+  text << stream.rdbuf();
+  try {
+    return Parser(text.str()).Parse();
+  } catch (const std::runtime_error& error) {
+    throw std::runtime_error(std::string(path) + ": " + error.what());
+  }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc < 3 || argc > 4) {
+    std::fprintf(stderr, "usage: %s baseline.json current.json [percent]\n",
+                 argv[0]);
+    return 2;
+  }
+  const double threshold = argc == 4 ? std::strtod(argv[3], nullptr) : 10.0;
+  Report baseline;
+  Report current;
+  try {
+    baseline = Load(argv[1]);
+    current = Load(argv[2]);
+  } catch (const std::exception& error) {
+    std::fprintf(stderr, "%s\n", error.what());
+    return 2;
+  }
+  int regressions = 0;
+  std::printf("%-44s %14s %14s %9s\n", "Benchmark", "Baseline, ns",
+              "Current, ns", "Change");
+  for (const auto& [name, result] : current) {
+    const auto old = baseline.find(name);
+    if (old == baseline.end()) {
+      std::printf("%-44s %14s %14.1f %9s\n", name.c_str(), "-",
+                  result.nanoseconds, "new");
+      continue;
+    }
+    const double change =
+        old->second.nanoseconds > 0
+            ? (result.nanoseconds / old->second.nanoseconds - 1) * 100
+            : 0;
+    const double noise = 2 * (old->second.stddev + result.stddev);
+    const bool regressed =
+        change > threshold &&
+        result.nanoseconds - old->second.nanoseconds > noise;
+    regressions += regressed;
+    std::printf("%-44s %14.1f %14.1f %+8.1f%%%s\n", name.c_str(),
+                old->second.nanoseconds, result.nanoseconds, change,
+                regressed ? "  REGRESSION" : "");
+  }
+  for (const auto& [name, result] : baseline) {
+    if (!current.count(name)) {
+      std::printf("%-44s %14.1f %14s %9s\n", name.c_str(), result.nanoseconds,
+                  "-", "gone");
+    }
+  }
+  if (regressions > 0) {
+    std::printf("%d benchmark(s) slower than the baseline by more than %g%%\n",
+                regressions, threshold);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,485 @@
+#include "s21_cholesky.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <stdexcept>
+
+#include "s21_gemm.h"
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+// Panel width of the blocked factorisation; below kBlockedMin columns the
+// unblocked loop is already cache resident.
+constexpr int kPanel = 64;
+constexpr int kBlockedMin = 256;
+
+template <typename T>
+T* RowOf(T* a, int lda, int i) {
+  return a + static_cast<std::ptrdiff_t>(i) * lda;
+}
+
+template <typename T>
+T Conj(T value) {
+  return value;
+}
+
+template <typename R>
+std::complex<R> Conj(std::complex<R> value) {
+  return std::conj(value);
+}
+
+// Factors the diagonal block [begin, end) of a, updating only the columns
+// before end.
+template <typename T>
+bool FactorDiagonal(T* a, int lda, int begin, int end) {
+  using Real = typename S21MatrixTraits<T>::Real;
+  const S21BasicSimdKernels<T>& simd = S21SimdActive<T>();
+  for (int k = begin; k < end; ++k) {
+    T* row_k = RowOf(a, lda, k);
+    const Real pivot = std::real(row_k[k]);
+    if (!(pivot > Real(0))) return false;
+    const Real root = std::sqrt(pivot);
+    row_k[k] = root;
+    simd.scale(row_k + k + 1, T(Real(1) / root), end - k - 1);
+    S21ParallelFor(k + 1, end, end - k,
+                   [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+                     for (int i = static_cast<int>(first); i < last; ++i) {
+                       const T factor = Conj(row_k[i]);
+                       if (factor == T(0)) continue;
+                       simd.axpy(RowOf(a, lda, i) + i, -factor, row_k + i,
+                                 end - i);
+                     }
+                   });
+  }
+  return true;
+}
+
+// U12 = U11^-H * A12 for the factored diagonal block U11; the columns of A12
+// are independent, so slices of them are solved in parallel.
+template <typename T>
+void SolveRightPanel(int n, T* a, int lda, int col_begin, int col_end) {
+  const S21BasicSimdKernels<T>& simd = S21SimdActive<T>();
+  const int width = col_end - col_begin;
+  S21ParallelFor(
+      col_end, n, 0.5 * width * width,
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        const std::size_t count = static_cast<std::size_t>(end - begin);
+        for (int k = col_begin; k < col_end; ++k) {
+          T* row_k = RowOf(a, lda, k);
+          simd.scale(row_k + begin, T(1) / row_k[k], count);
+          for (int i = k + 1; i < col_end; ++i) {
+            const T factor = Conj(row_k[i]);
+            if (factor == T(0)) continue;
+            simd.axpy(RowOf(a, lda, i) + begin, -factor, row_k + begin,
+                      count);
+          }
+        }
+      });
+}
+
+// U^H * Y = B, then D^-1 when the factor has a unit diagonal, then U * X = Y,
+// on the nrhs columns of b starting at b[0].
+template <typename T>
+void SolveColumns(int n, const T* u, int lda, bool unit, int nrhs, T* b,
+                  int ldb) {
+  const S21BasicSimdKernels<T>& simd = S21SimdActive<T>();
+  for (int k = 0; k < n; ++k) {
+    const T* u_k = RowOf(u, lda, k);
+    T* b_k = RowOf(b, ldb, k);
+    if (!unit) simd.scale(b_k, T(1) / u_k[k], nrhs);
+    for (int i = k + 1; i < n; ++i) {
+      const T factor = Conj(u_k[i]);
+      if (factor == T(0)) continue;
+      simd.axpy(RowOf(b, ldb, i), -factor, b_k, nrhs);
+    }
+  }
+  for (int i = n - 1; i >= 0; --i) {
+    const T* u_i = RowOf(u, lda, i);
+    T* b_i = RowOf(b, ldb, i);
+    if (unit) simd.scale(b_i, T(1) / u_i[i], nrhs);
+    for (int k = i + 1; k < n; ++k) {
+      if (u_i[k] == T(0)) continue;
+      simd.axpy(b_i, -u_i[k], RowOf(b, ldb, k), nrhs);
+    }
+    if (!unit) simd.scale(b_i, T(1) / u_i[i], nrhs);
+  }
+}
+
+template <typename T>
+void Solve(int n, const T* u, int lda, bool unit, int nrhs, T* b, int ldb) {
+  S21ParallelFor(0, nrhs, static_cast<double>(n) * n,
+                 [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                   SolveColumns(n, u, lda, unit, static_cast<int>(end - begin),
+                                b + begin, ldb);
+                 });
+}
+
+// Sets the strict upper triangle of the n x n matrix x to the conjugate
+// transpose of its strict lower triangle.
+template <typename T>
+void MirrorLower(S21BasicMatrix<T>& x) {
+  for (int i = 0; i < x.GetRows(); ++i) {
+    for (int j = 0; j < i; ++j) x[j][i] = Conj(x[i][j]);
+  }
+}
+
+}  // namespace
+
+template <typename T>
+bool S21CholeskyFactor(int n, T* a, int lda) {
+  if (n < kBlockedMin) return FactorDiagonal(a, lda, 0, n);
+  // The conjugate transpose of the panel U12, the left operand of the
+  // trailing update A22 -= U12^H * U12
+  std::vector<T> panel(static_cast<std::size_t>(n) * kPanel);
+  for (int kb = 0; kb < n; kb += kPanel) {
+    const int kb_end = std::min(n, kb + kPanel);
+    const int width = kb_end - kb;
+    if (!FactorDiagonal(a, lda, kb, kb_end)) return false;
+    if (kb_end == n) break;
+    SolveRightPanel(n, a, lda, kb, kb_end);
+    const int m = n - kb_end;
+    for (int k = 0; k < width; ++k) {
+      const T* row = RowOf(a, lda, kb + k) + kb_end;
+      for (int i = 0; i < m; ++i) panel[i * width + k] = Conj(row[i]);
+    }
+    // Strips of rows of A22 from their diagonal on: the upper triangle and
+    // a little of the lower one, which is not referenced.
+    for (int row = 0; row < m; row += kPanel) {
+      const int rows = std::min(kPanel, m - row);
+      S21Gemm(rows, m - row, width, T(-1), panel.data() + row * width, width,
+              RowOf(a, lda, kb) + kb_end + row, lda, T(1),
+              RowOf(a, lda, kb_end + row) + kb_end + row, lda);
+    }
+  }
+  return true;
+}
+
+template <typename T>
+void S21CholeskySolve(int n, const T* u, int lda, int nrhs, T* b, int ldb) {
+  Solve(n, u, lda, false, nrhs, b, ldb);
+}
+
+template <typename T>
+bool S21CholeskyUpdate(int n, T* u, int lda, T* x, bool downdate) {
+  using Real = typename S21MatrixTraits<T>::Real;
+  const S21BasicSimdKernels<T>& simd = S21SimdActive<T>();
+  const Real sign = downdate ? Real(-1) : Real(1);
+  // Row k of U is the conjugate of column k of L, so the rotations run on
+  // y = conj(x) and stay on contiguous rows.
+  for (int i = 0; i < n; ++i) x[i] = Conj(x[i]);
+  for (int k = 0; k < n; ++k) {
+    T* row_k = RowOf(u, lda, k);
+    const Real diagonal = std::real(row_k[k]);
+    const Real magnitude = std::abs(x[k]);
+    const Real square = diagonal * diagonal + sign * magnitude * magnitude;
+    if (!(square > Real(0))) return false;
+    const Real root = std::sqrt(square);
+    const Real c = root / diagonal;
+    const T s = Conj(x[k]) / diagonal;
+    const int count = n - k - 1;
+    row_k[k] = root;
+    // u_k = (u_k + sign * s * y) / c, then y = c * y - conj(s) * u_k
+    simd.axpy(row_k + k + 1, T(sign) * s, x + k + 1, count);
+    simd.scale(row_k + k + 1, T(Real(1) / c), count);
+    simd.scale(x + k + 1, T(c), count);
+    simd.axpy(x + k + 1, -Conj(s), row_k + k + 1, count);
+  }
+  return true;
+}
+
+template <typename T>
+bool S21LdltFactor(int n, T* a, int lda) {
+  const S21BasicSimdKernels<T>& simd = S21SimdActive<T>();
+  for (int k = 0; k < n; ++k) {
+    T* row_k = RowOf(a, lda, k);
+    if (row_k[k] == T(0)) return false;
+    const T inverse_pivot = T(1) / row_k[k];
+    S21ParallelFor(k + 1, n, n - k,
+                   [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                     for (int i = static_cast<int>(begin); i < end; ++i) {
+                       const T factor = Conj(row_k[i]) * inverse_pivot;
+                       if (factor == T(0)) continue;
+                       simd.axpy(RowOf(a, lda, i) + i, -factor, row_k + i,
+                                 n - i);
+                     }
+                   });
+    simd.scale(row_k + k + 1, inverse_pivot, n - k - 1);
+  }
+  return true;
+}
+
+template <typename T>
+void S21LdltSolve(int n, const T* ldlt, int lda, int nrhs, T* b, int ldb) {
+  Solve(n, ldlt, lda, true, nrhs, b, ldb);
+}
+
+template <typename T>
+bool S21IsHermitian(const S21BasicMatrix<T>& matrix) {
+  if (matrix.GetRows() != matrix.GetCols()) return false;
+  for (int i = 0; i < matrix.GetRows(); ++i) {
+    for (int j = i; j < matrix.GetCols(); ++j) {
+      if (matrix[i][j] != Conj(matrix[j][i])) return false;
+    }
+  }
+  return true;
+}
+
+template bool S21CholeskyFactor(int, float*, int);
+template bool S21CholeskyFactor(int, double*, int);
+template bool S21CholeskyFactor(int, long double*, int);
+template bool S21CholeskyFactor(int, std::complex<double>*, int);
+template void S21CholeskySolve(int, const float*, int, int, float*, int);
+template void S21CholeskySolve(int, const double*, int, int, double*, int);
+template void S21CholeskySolve(int, const long double*, int, int,
+                               long double*, int);
+template void S21CholeskySolve(int, const std::complex<double>*, int, int,
+                               std::complex<double>*, int);
+template bool S21CholeskyUpdate(int, float*, int, float*, bool);
+template bool S21CholeskyUpdate(int, double*, int, double*, bool);
+template bool S21CholeskyUpdate(int, long double*, int, long double*, bool);
+template bool S21CholeskyUpdate(int, std::complex<double>*, int,
+                                std::complex<double>*, bool);
+template bool S21LdltFactor(int, float*, int);
+template bool S21LdltFactor(int, double*, int);
+template bool S21LdltFactor(int, long double*, int);
+template bool S21LdltFactor(int, std::complex<double>*, int);
+template void S21LdltSolve(int, const float*, int, int, float*, int);
+template void S21LdltSolve(int, const double*, int, int, double*, int);
+template void S21LdltSolve(int, const long double*, int, int, long double*,
+                           int);
+template void S21LdltSolve(int, const std::complex<double>*, int, int,
+                           std::complex<double>*, int);
+template bool S21IsHermitian(const S21BasicMatrix<float>&);
+template bool S21IsHermitian(const S21BasicMatrix<double>&);
+template bool S21IsHermitian(const S21BasicMatrix<long double>&);
+template bool S21IsHermitian(const S21BasicMatrix<std::complex<double>>&);
+
+// S21BasicCholesky
+
+template <typename T>
+S21BasicCholesky<T>::S21BasicCholesky(const S21BasicMatrix<T>& matrix)
+    : factors_(matrix, matrix.GetResource()), positive_definite_(true) {
+  if (matrix.GetRows() != matrix.GetCols()) {
+    throw std::out_of_range("The matrix isn't square");
+  }
+  if (factors_.data()) {
+    positive_definite_ = S21CholeskyFactor(
+        factors_.GetRows(), factors_.data(), factors_.stride());
+  }
+}
+
+template <typename T>
+bool S21BasicCholesky<T>::IsPositiveDefinite() const {
+  return positive_definite_;
+}
+
+template <typename T>
+T S21BasicCholesky<T>::Determinant() const {
+  CheckSolvable();
+  const int n = GetSize();
+  T root = n > 0 ? T(1) : T(0);
+  for (int i = 0; i < n; ++i) root *= factors_[i][i];
+  return root * root;
+}
+
+template <typename T>
+void S21BasicCholesky<T>::Update(const std::vector<T>& x) {
+  RankOne(x, false);
+}
+
+template <typename T>
+bool S21BasicCholesky<T>::Downdate(const std::vector<T>& x) {
+  RankOne(x, true);
+  return positive_definite_;
+}
+
+template <typename T>
+std::vector<T> S21BasicCholesky<T>::Solve(const std::vector<T>& b) const {
+  if (static_cast<int>(b.size()) != GetSize()) {
+    throw std::out_of_range("Different size of matrix");
+  }
+  CheckSolvable();
+  std::vector<T> x(b);
+  S21CholeskySolve(GetSize(), factors_.data(), factors_.stride(), 1, x.data(),
+                   1);
+  return x;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicCholesky<T>::Solve(
+    const S21BasicMatrix<T>& b) const {
+  if (b.GetRows() != GetSize()) {
+    throw std::out_of_range("Different size of matrix");
+  }
+  CheckSolvable();
+  S21BasicMatrix<T> x(b, factors_.GetResource());
+  if (x.data()) {
+    S21CholeskySolve(GetSize(), factors_.data(), factors_.stride(),
+                     x.GetCols(), x.data(), x.stride());
+  }
+  return x;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicCholesky<T>::Inverse() const {
+  CheckSolvable();
+  const int n = GetSize();
+  const S21BasicSimdKernels<T>& simd = S21SimdActive<T>();
+  // V = L^-1, lower triangular, row by row: v_i = (e_i - sum l_ik v_k) / l_ii
+  // with l_ik = conj(u_ki). Its columns are independent, so slices of them
+  // are computed in parallel. V is scratch and skips the resource.
+  std::vector<T> v(static_cast<std::size_t>(n) * n);
+  S21ParallelFor(
+      0, n, 0.5 * n * n, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        const int first = static_cast<int>(begin);
+        for (int i = first; i < n; ++i) {
+          const int last = std::min(static_cast<int>(end), i + 1);
+          T* v_i = RowOf(v.data(), n, i);
+          for (int k = first; k < i; ++k) {
+            const T factor = Conj(factors_[k][i]);
+            if (factor == T(0)) continue;
+            simd.axpy(v_i + first, -factor, RowOf(v.data(), n, k) + first,
+                      std::min(last, k + 1) - first);
+          }
+          if (i < end) v_i[i] += T(1);
+          simd.scale(v_i + first, T(1) / factors_[i][i], last - first);
+        }
+      });
+  // A^-1 = V^H * V, whose row i up to the diagonal is the sum over k >= i
+  // of conj(v_ki) times row k of V.
+  S21BasicMatrix<T> inverse(n, n, factors_.GetResource());
+  S21ParallelFor(0, n, 0.25 * n * n,
+                 [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                   for (int i = static_cast<int>(begin); i < end; ++i) {
+                     for (int k = i; k < n; ++k) {
+                       const T* v_k = RowOf(v.data(), n, k);
+                       simd.axpy(inverse[i], Conj(v_k[i]), v_k, i + 1);
+                     }
+                   }
+                 });
+  MirrorLower(inverse);
+  return inverse;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicCholesky<T>::GetL() const {
+  const int n = GetSize();
+  S21BasicMatrix<T> lower(n, n, factors_.GetResource());
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j <= i; ++j) lower[i][j] = Conj(factors_[j][i]);
+  }
+  return lower;
+}
+
+template <typename T>
+int S21BasicCholesky<T>::GetSize() const {
+  return factors_.GetRows();
+}
+
+template <typename T>
+void S21BasicCholesky<T>::CheckSolvable() const {
+  if (!positive_definite_) {
+    throw std::invalid_argument("The matrix isn't positive definite");
+  }
+}
+
+template <typename T>
+void S21BasicCholesky<T>::RankOne(const std::vector<T>& x, bool downdate) {
+  if (static_cast<int>(x.size()) != GetSize()) {
+    throw std::out_of_range("Different size of matrix");
+  }
+  CheckSolvable();
+  std::vector<T> work(x);
+  positive_definite_ = S21CholeskyUpdate(GetSize(), factors_.data(),
+                                         factors_.stride(), work.data(),
+                                         downdate);
+}
+
+// S21BasicLDLT
+
+template <typename T>
+S21BasicLDLT<T>::S21BasicLDLT(const S21BasicMatrix<T>& matrix)
+    : factors_(matrix, matrix.GetResource()), singular_(false) {
+  if (matrix.GetRows() != matrix.GetCols()) {
+    throw std::out_of_range("The matrix isn't square");
+  }
+  if (factors_.data()) {
+    singular_ = !S21LdltFactor(factors_.GetRows(), factors_.data(),
+                               factors_.stride());
+  }
+}
+
+template <typename T>
+bool S21BasicLDLT<T>::IsSingular() const {
+  return singular_;
+}
+
+template <typename T>
+T S21BasicLDLT<T>::Determinant() const {
+  CheckSolvable();
+  const int n = GetSize();
+  T det = n > 0 ? T(1) : T(0);
+  for (int i = 0; i < n; ++i) det *= factors_[i][i];
+  return det;
+}
+
+template <typename T>
+std::vector<T> S21BasicLDLT<T>::Solve(const std::vector<T>& b) const {
+  if (static_cast<int>(b.size()) != GetSize()) {
+    throw std::out_of_range("Different size of matrix");
+  }
+  CheckSolvable();
+  std::vector<T> x(b);
+  S21LdltSolve(GetSize(), factors_.data(), factors_.stride(), 1, x.data(), 1);
+  return x;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicLDLT<T>::Solve(const S21BasicMatrix<T>& b) const {
+  if (b.GetRows() != GetSize()) {
+    throw std::out_of_range("Different size of matrix");
+  }
+  CheckSolvable();
+  S21BasicMatrix<T> x(b, factors_.GetResource());
+  if (x.data()) {
+    S21LdltSolve(GetSize(), factors_.data(), factors_.stride(), x.GetCols(),
+                 x.data(), x.stride());
+  }
+  return x;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicLDLT<T>::Inverse() const {
+  const int n = GetSize();
+  CheckSolvable();
+  S21BasicMatrix<T> inverse(n, n, factors_.GetResource());
+  for (int i = 0; i < n; ++i) inverse[i][i] = 1;
+  S21LdltSolve(n, factors_.data(), factors_.stride(), n, inverse.data(),
+               inverse.stride());
+  return inverse;
+}
+
+template <typename T>
+int S21BasicLDLT<T>::GetSize() const {
+  return factors_.GetRows();
+}
+
+template <typename T>
+void S21BasicLDLT<T>::CheckSolvable() const {
+  if (singular_) {
+    throw std::invalid_argument("the Determinant of the matrix is 0");
+  }
+}
+
+template class S21BasicCholesky<float>;
+template class S21BasicCholesky<double>;
+template class S21BasicCholesky<long double>;
+template class S21BasicCholesky<std::complex<double>>;
+template class S21BasicLDLT<float>;
+template class S21BasicLDLT<double>;
+template class S21BasicLDLT<long double>;
+template class S21BasicLDLT<std::complex<double>>;
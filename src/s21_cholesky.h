@@ -0,0 +1,121 @@
+#ifndef SRC_S21_CHOLESKY_H_
+#define SRC_S21_CHOLESKY_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+#include "s21_matrix_traits.h"
+
+// Factorisations of symmetric (for complex elements, Hermitian) matrices.
+// Both read only the upper triangle and keep their factor there, as the
+// upper factor U = L^H: with rows contiguous, every update of the
+// right-looking algorithms is then a unit-stride row operation, just as in
+// S21LuFactor. The strict lower triangle is scratch space: it is never read
+// and the blocked Cholesky overwrites part of it.
+
+// In-place Cholesky factorisation A = U^H * U of the row-major n x n matrix
+// a with leading dimension lda, blocked above a few hundred rows so the
+// trailing updates run through S21Gemm. Returns false, leaving a partly
+// factored, when A is not positive definite.
+template <typename T>
+bool S21CholeskyFactor(int n, T* a, int lda);
+
+// Overwrites the n x nrhs right-hand sides b with the solution of
+// U^H * U * X = B for the factor of S21CholeskyFactor.
+template <typename T>
+void S21CholeskySolve(int n, const T* u, int lda, int nrhs, T* b, int ldb);
+
+// Turns the factor U of A into that of A + x * x^H, or of A - x * x^H when
+// downdate, in O(n^2) through a sequence of plane rotations. x is used as
+// workspace. Returns false, with u partly updated, when the downdated
+// matrix is not positive definite.
+template <typename T>
+bool S21CholeskyUpdate(int n, T* u, int lda, T* x, bool downdate);
+
+// In-place A = U^H * D * U with a unit upper triangular U, D on the
+// diagonal. There is no pivoting: it returns false at the first zero pivot,
+// so it suits matrices whose leading minors are all nonzero (definite and
+// quasi-definite ones); other symmetric matrices need LU.
+template <typename T>
+bool S21LdltFactor(int n, T* a, int lda);
+
+template <typename T>
+void S21LdltSolve(int n, const T* ldlt, int lda, int nrhs, T* b, int ldb);
+
+// True when a equals its (conjugate) transpose exactly, as a covariance
+// matrix assembled symmetrically does.
+template <typename T>
+bool S21IsHermitian(const S21BasicMatrix<T>& matrix);
+
+// Cholesky factorisation of a symmetric positive definite S21BasicMatrix,
+// computed once in the constructor, in half the operations of S21BasicLU
+// and without pivoting. Like S21BasicLU, the constructor accepts any square
+// matrix; the queries throw std::invalid_argument when it turned out not to
+// be positive definite.
+template <typename T>
+class S21BasicCholesky {
+ public:
+  using Real = typename S21MatrixTraits<T>::Real;
+
+  explicit S21BasicCholesky(const S21BasicMatrix<T>& matrix);
+  // Operations
+  bool IsPositiveDefinite() const;
+  T Determinant() const;
+  std::vector<T> Solve(const std::vector<T>& b) const;
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T>& b) const;
+  // Through L^-1 rather than n solves, about twice as fast as
+  // S21BasicLU::Inverse; the result is exactly Hermitian.
+  S21BasicMatrix<T> Inverse() const;
+  // The lower triangular factor L of A = L * L^H
+  S21BasicMatrix<T> GetL() const;
+  // Refresh the factorisation for A + x * x^H or A - x * x^H in O(n^2),
+  // as a sliding covariance estimate needs. A downdate that leaves the
+  // matrix indefinite returns false, and the queries throw from then on.
+  void Update(const std::vector<T>& x);
+  bool Downdate(const std::vector<T>& x);
+  // Accessors
+  int GetSize() const;
+
+ private:
+  S21BasicMatrix<T> factors_;
+  bool positive_definite_;
+  // Additional
+  void CheckSolvable() const;
+  void RankOne(const std::vector<T>& x, bool downdate);
+};
+
+// LDL^T factorisation of a symmetric S21BasicMatrix, see S21LdltFactor.
+// The queries throw std::invalid_argument when a pivot was zero.
+template <typename T>
+class S21BasicLDLT {
+ public:
+  explicit S21BasicLDLT(const S21BasicMatrix<T>& matrix);
+  // Operations
+  bool IsSingular() const;
+  T Determinant() const;
+  std::vector<T> Solve(const std::vector<T>& b) const;
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T>& b) const;
+  S21BasicMatrix<T> Inverse() const;
+  // Accessors
+  int GetSize() const;
+
+ private:
+  S21BasicMatrix<T> factors_;
+  bool singular_;
+  // Additional
+  void CheckSolvable() const;
+};
+
+extern template class S21BasicCholesky<float>;
+extern template class S21BasicCholesky<double>;
+extern template class S21BasicCholesky<long double>;
+extern template class S21BasicCholesky<std::complex<double>>;
+extern template class S21BasicLDLT<float>;
+extern template class S21BasicLDLT<double>;
+extern template class S21BasicLDLT<long double>;
+extern template class S21BasicLDLT<std::complex<double>>;
+
+using S21Cholesky = S21BasicCholesky<double>;
+using S21LDLT = S21BasicLDLT<double>;
+
+#endif  // SRC_S21_CHOLESKY_H_
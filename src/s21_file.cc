@@ -0,0 +1,175 @@
+#include "s21_file.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+namespace {
+
+[[noreturn]] void ThrowSystemError(const std::string& what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+int Flags(S21File::Mode mode) {
+  switch (mode) {
+    case S21File::Mode::kRead:
+      return O_RDONLY;
+    case S21File::Mode::kReadWrite:
+      return O_RDWR;
+    case S21File::Mode::kCreate:
+      break;
+  }
+  return O_RDWR | O_CREAT | O_TRUNC;
+}
+
+}  // namespace
+
+// S21File
+
+S21File::S21File(const std::string& path, Mode mode) : fd_(-1), path_(path) {
+  do {
+    fd_ = open(path.c_str(), Flags(mode) | O_CLOEXEC, 0644);
+  } while (fd_ < 0 && errno == EINTR);
+  if (fd_ < 0) ThrowSystemError(path);
+}
+
+S21File::S21File(S21File&& other) noexcept
+    : fd_(std::exchange(other.fd_, -1)), path_(std::move(other.path_)) {}
+
+S21File::~S21File() { Close(); }
+
+S21File& S21File::operator=(S21File&& other) noexcept {
+  if (this != &other) {
+    Close();
+    fd_ = std::exchange(other.fd_, -1);
+    path_ = std::move(other.path_);
+  }
+  return *this;
+}
+
+void S21File::ReadAt(void* data, std::size_t size,
+                     std::uint64_t offset) const {
+  char* bytes = static_cast<char*>(data);
+  while (size > 0) {
+    const ssize_t read =
+        pread(fd_, bytes, size, static_cast<off_t>(offset));
+    if (read < 0) {
+      if (errno == EINTR) continue;
+      ThrowSystemError(path_);
+    }
+    if (read == 0) throw std::invalid_argument("The file is truncated");
+    bytes += read;
+    size -= static_cast<std::size_t>(read);
+    offset += static_cast<std::uint64_t>(read);
+  }
+}
+
+void S21File::WriteAt(const void* data, std::size_t size,
+                      std::uint64_t offset) const {
+  const char* bytes = static_cast<const char*>(data);
+  while (size > 0) {
+    const ssize_t written =
+        pwrite(fd_, bytes, size, static_cast<off_t>(offset));
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      ThrowSystemError(path_);
+    }
+    bytes += written;
+    size -= static_cast<std::size_t>(written);
+    offset += static_cast<std::uint64_t>(written);
+  }
+}
+
+std::uint64_t S21File::Size() const {
+  struct stat status;
+  if (fstat(fd_, &status) != 0) ThrowSystemError(path_);
+  return static_cast<std::uint64_t>(status.st_size);
+}
+
+void S21File::Resize(std::uint64_t size) const {
+  int result;
+  do {
+    result = ftruncate(fd_, static_cast<off_t>(size));
+  } while (result != 0 && errno == EINTR);
+  if (result != 0) ThrowSystemError(path_);
+}
+
+int S21File::Get() const { return fd_; }
+
+const std::string& S21File::GetPath() const { return path_; }
+
+void S21File::Close() {
+  if (fd_ >= 0) {
+    close(fd_);
+    fd_ = -1;
+  }
+}
+
+// S21Checksum
+
+S21Checksum::S21Checksum() : hash_(0xcbf29ce484222325ULL), pending_(0) {}
+
+void S21Checksum::Update(const void* data, std::size_t size) {
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  while (size > 0 && pending_ > 0) {
+    tail_[pending_++] = *bytes++;
+    --size;
+    if (pending_ == 8) {
+      Mix(tail_);
+      pending_ = 0;
+    }
+  }
+  for (; size >= 8; size -= 8, bytes += 8) Mix(bytes);
+  std::memcpy(tail_, bytes, size);
+  pending_ = size;
+}
+
+void S21Checksum::UpdateZeros(std::uint64_t size) {
+  const unsigned char zero = 0;
+  for (; size > 0 && pending_ > 0; --size) Update(&zero, 1);
+  // Mixing a zero word only multiplies by the prime, so whole words come
+  // down to one power of it.
+  std::uint64_t factor = 1;
+  std::uint64_t power = kPrime;
+  for (std::uint64_t words = size / 8; words > 0; words >>= 1) {
+    if (words & 1) factor *= power;
+    power *= power;
+  }
+  hash_ *= factor;
+  pending_ = static_cast<std::size_t>(size % 8);
+  std::memset(tail_, 0, pending_);
+}
+
+std::uint64_t S21Checksum::Final() {
+  if (pending_ > 0) {
+    std::memset(tail_ + pending_, 0, 8 - pending_);
+    Mix(tail_);
+    pending_ = 0;
+  }
+  return hash_;
+}
+
+void S21Checksum::Mix(const unsigned char* word_bytes) {
+  std::uint64_t word;
+  std::memcpy(&word, word_bytes, 8);
+  if (!S21LittleEndianHost()) {
+    unsigned char swapped[8];
+    std::reverse_copy(word_bytes, word_bytes + 8, swapped);
+    std::memcpy(&word, swapped, 8);
+  }
+  hash_ = (hash_ ^ word) * kPrime;
+}
+
+bool S21LittleEndianHost() {
+  const std::uint32_t one = 1;
+  unsigned char first;
+  std::memcpy(&first, &one, 1);
+  return first == 1;
+}
@@ -0,0 +1,64 @@
+#ifndef SRC_S21_FILE_H_
+#define SRC_S21_FILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// POSIX file behind the matrix files of s21_matrix_io.h and
+// s21_out_of_core.h. Reads and writes are positioned, so two threads may
+// transfer different ranges of one file at the same time, and they retry
+// on EINTR and short transfers. Failures of the system throw
+// std::system_error with errno and the path; reading past the end of the
+// file throws std::invalid_argument.
+class S21File {
+ public:
+  enum class Mode { kRead, kReadWrite, kCreate };
+
+  // kCreate creates the file or truncates an existing one.
+  S21File(const std::string& path, Mode mode);
+  S21File(const S21File&) = delete;
+  S21File(S21File&& other) noexcept;
+  ~S21File();
+  S21File& operator=(const S21File&) = delete;
+  S21File& operator=(S21File&& other) noexcept;
+
+  void ReadAt(void* data, std::size_t size, std::uint64_t offset) const;
+  void WriteAt(const void* data, std::size_t size, std::uint64_t offset) const;
+  std::uint64_t Size() const;
+  // Grows or shrinks the file; new bytes read as zeros and take no disk
+  // space until written.
+  void Resize(std::uint64_t size) const;
+  int Get() const;
+  const std::string& GetPath() const;
+
+ private:
+  int fd_;
+  std::string path_;
+  // Additional
+  void Close();
+};
+
+// FNV-1a over 64-bit little-endian words, fed in pieces of any length; the
+// last word is padded with zero bytes.
+class S21Checksum {
+ public:
+  S21Checksum();
+  void Update(const void* data, std::size_t size);
+  // Update with size zero bytes, in O(log size) without touching memory
+  void UpdateZeros(std::uint64_t size);
+  std::uint64_t Final();
+
+ private:
+  static constexpr std::uint64_t kPrime = 0x100000001b3ULL;
+
+  std::uint64_t hash_;
+  unsigned char tail_[8];
+  std::size_t pending_;
+  // Additional
+  void Mix(const unsigned char* word_bytes);
+};
+
+bool S21LittleEndianHost();
+
+#endif  // SRC_S21_FILE_H_
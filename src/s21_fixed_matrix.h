@@ -0,0 +1,340 @@
+#ifndef SRC_S21_FIXED_MATRIX_H_
+#define SRC_S21_FIXED_MATRIX_H_
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+#include "s21_matrix_oop.h"
+#include "s21_matrix_traits.h"
+
+// Compile-time sized companion of S21BasicMatrix for small transforms. Elements
+// live inline in a std::array, so there is no allocation, every loop has a
+// constant trip count the compiler unrolls, and a shape mismatch is a
+// compile error instead of an exception. Every operation is constexpr for
+// real element types; with std::complex elements the ones that need a
+// magnitude (EqMatrix, and Determinant and InverseMatrix past 4 x 4) run at
+// run time only, through std::abs.
+template <int R, int C, typename T = double>
+class S21FixedMatrix {
+  static_assert(R > 0 && C > 0, "S21FixedMatrix needs positive dimensions");
+
+ public:
+  using Real = typename S21MatrixTraits<T>::Real;
+
+  // Constructors
+  constexpr S21FixedMatrix() : matrix_{} {}
+  // Row-major element list, e.g. S21FixedMatrix<2, 2>({1, 2, 3, 4})
+  constexpr explicit S21FixedMatrix(const std::array<T, R * C>& elements)
+      : matrix_(elements) {}
+  // Throws std::out_of_range when other is not R x C
+  explicit S21FixedMatrix(const S21BasicMatrixView<const T>& other)
+      : matrix_{} {
+    if (other.GetRows() != R || other.GetCols() != C) {
+      throw std::out_of_range("Different size of matrix");
+    }
+    for (int i = 0; i < R; ++i) {
+      for (int j = 0; j < C; ++j) {
+        At(i, j) = other.Coeff(i, j);
+      }
+    }
+  }
+  static constexpr S21FixedMatrix Identity() {
+    static_assert(R == C, "The matrix isn't square");
+    S21FixedMatrix result;
+    for (int i = 0; i < R; ++i) result.At(i, i) = T(1);
+    return result;
+  }
+  // Operations
+  // Elements may differ by S21MatrixTraits<T>::kEpsilon
+  constexpr bool EqMatrix(const S21FixedMatrix& other) const {
+    bool status_of_equality = true;
+    for (int k = 0; k < R * C; ++k) {
+      if (Abs(matrix_[k] - other.matrix_[k]) >
+          S21MatrixTraits<T>::kEpsilon) {
+        status_of_equality = false;
+      }
+    }
+    return status_of_equality;
+  }
+  constexpr void SumMatrix(const S21FixedMatrix& other) {
+    for (int k = 0; k < R * C; ++k) matrix_[k] += other.matrix_[k];
+  }
+  constexpr void SubMatrix(const S21FixedMatrix& other) {
+    for (int k = 0; k < R * C; ++k) matrix_[k] -= other.matrix_[k];
+  }
+  constexpr void MulNumber(T number) {
+    for (int k = 0; k < R * C; ++k) matrix_[k] *= number;
+  }
+  // In-place product keeps the shape, so other must be C x C
+  constexpr void MulMatrix(const S21FixedMatrix<C, C, T>& other) {
+    *this = *this * other;
+  }
+  constexpr S21FixedMatrix<C, R, T> Transpose() const {
+    S21FixedMatrix<C, R, T> result;
+    for (int i = 0; i < R; ++i) {
+      for (int j = 0; j < C; ++j) result.At(j, i) = At(i, j);
+    }
+    return result;
+  }
+  constexpr S21FixedMatrix CalcComplements() const {
+    static_assert(R == C, "The matrix isn't square");
+    // A 1 x 1 matrix has no minors and gets 0, as S21BasicMatrix does
+    S21FixedMatrix result;
+    if constexpr (R > 1) {
+      for (int i = 0; i < R; ++i) {
+        for (int j = 0; j < C; ++j) {
+          const T minor = Minor(i, j).Determinant();
+          result.At(i, j) = ((i + j) % 2) ? -minor : minor;
+        }
+      }
+    }
+    return result;
+  }
+  constexpr T Determinant() const {
+    static_assert(R == C, "The matrix isn't square");
+    if constexpr (R == 1) {
+      return At(0, 0);
+    } else if constexpr (R == 2) {
+      return At(0, 0) * At(1, 1) - At(1, 0) * At(0, 1);
+    } else if constexpr (R == 3) {
+      return At(0, 0) * (At(1, 1) * At(2, 2) - At(2, 1) * At(1, 2)) -
+             At(0, 1) * (At(1, 0) * At(2, 2) - At(2, 0) * At(1, 2)) +
+             At(0, 2) * (At(1, 0) * At(2, 1) - At(2, 0) * At(1, 1));
+    } else if constexpr (R == 4) {
+      const Minors4 m = Minors();
+      return m.s0 * m.c5 - m.s1 * m.c4 + m.s2 * m.c3 + m.s3 * m.c2 -
+             m.s4 * m.c1 + m.s5 * m.c0;
+    } else {
+      return Eliminate(nullptr);
+    }
+  }
+  // Throws std::invalid_argument for a singular matrix
+  constexpr S21FixedMatrix InverseMatrix() const {
+    static_assert(R == C, "The matrix isn't square");
+    S21FixedMatrix result;
+    T det = T(0);
+    if constexpr (R == 4) {
+      // Adjugate from the 2x2 minors of the top and bottom row pairs.
+      const Minors4 m = Minors();
+      det = m.s0 * m.c5 - m.s1 * m.c4 + m.s2 * m.c3 + m.s3 * m.c2 -
+            m.s4 * m.c1 + m.s5 * m.c0;
+      result = S21FixedMatrix({
+          At(1, 1) * m.c5 - At(1, 2) * m.c4 + At(1, 3) * m.c3,
+          -At(0, 1) * m.c5 + At(0, 2) * m.c4 - At(0, 3) * m.c3,
+          At(3, 1) * m.s5 - At(3, 2) * m.s4 + At(3, 3) * m.s3,
+          -At(2, 1) * m.s5 + At(2, 2) * m.s4 - At(2, 3) * m.s3,
+          -At(1, 0) * m.c5 + At(1, 2) * m.c2 - At(1, 3) * m.c1,
+          At(0, 0) * m.c5 - At(0, 2) * m.c2 + At(0, 3) * m.c1,
+          -At(3, 0) * m.s5 + At(3, 2) * m.s2 - At(3, 3) * m.s1,
+          At(2, 0) * m.s5 - At(2, 2) * m.s2 + At(2, 3) * m.s1,
+          At(1, 0) * m.c4 - At(1, 1) * m.c2 + At(1, 3) * m.c0,
+          -At(0, 0) * m.c4 + At(0, 1) * m.c2 - At(0, 3) * m.c0,
+          At(3, 0) * m.s4 - At(3, 1) * m.s2 + At(3, 3) * m.s0,
+          -At(2, 0) * m.s4 + At(2, 1) * m.s2 - At(2, 3) * m.s0,
+          -At(1, 0) * m.c3 + At(1, 1) * m.c1 - At(1, 2) * m.c0,
+          At(0, 0) * m.c3 - At(0, 1) * m.c1 + At(0, 2) * m.c0,
+          -At(3, 0) * m.s3 + At(3, 1) * m.s1 - At(3, 2) * m.s0,
+          At(2, 0) * m.s3 - At(2, 1) * m.s1 + At(2, 2) * m.s0,
+      });
+    } else if constexpr (R == 1) {
+      det = At(0, 0);
+      result.At(0, 0) = T(1);
+    } else if constexpr (R <= 3) {
+      det = Determinant();
+      result = CalcComplements().Transpose();
+    } else {
+      result = Identity();
+      det = Eliminate(&result);
+    }
+    if (det == T(0)) {
+      throw std::invalid_argument("the Determinant of the matrix is 0");
+    }
+    if constexpr (R <= 4) result.MulNumber(T(1) / det);
+    return result;
+  }
+  // Submatrix with row i and column j removed
+  constexpr S21FixedMatrix<R - 1, C - 1, T> Minor(int i, int j) const {
+    S21FixedMatrix<R - 1, C - 1, T> result;
+    for (int r = 0, k = 0; r < R; ++r) {
+      if (r == i) continue;
+      for (int c = 0, t = 0; c < C; ++c) {
+        if (c == j) continue;
+        result.At(k, t++) = At(r, c);
+      }
+      ++k;
+    }
+    return result;
+  }
+  // Overloadings opertators
+  constexpr S21FixedMatrix operator+(const S21FixedMatrix& other) const {
+    S21FixedMatrix result(*this);
+    result.SumMatrix(other);
+    return result;
+  }
+  constexpr S21FixedMatrix operator-(const S21FixedMatrix& other) const {
+    S21FixedMatrix result(*this);
+    result.SubMatrix(other);
+    return result;
+  }
+  template <int K>
+  constexpr S21FixedMatrix<R, K, T> operator*(
+      const S21FixedMatrix<C, K, T>& other) const {
+    S21FixedMatrix<R, K, T> result;
+    for (int i = 0; i < R; ++i) {
+      for (int p = 0; p < C; ++p) {
+        const T a_ip = At(i, p);
+        for (int j = 0; j < K; ++j) result.At(i, j) += a_ip * other.At(p, j);
+      }
+    }
+    return result;
+  }
+  constexpr S21FixedMatrix operator*(T number) const {
+    S21FixedMatrix result(*this);
+    result.MulNumber(number);
+    return result;
+  }
+  constexpr bool operator==(const S21FixedMatrix& other) const {
+    return EqMatrix(other);
+  }
+  constexpr S21FixedMatrix& operator+=(const S21FixedMatrix& other) {
+    SumMatrix(other);
+    return *this;
+  }
+  constexpr S21FixedMatrix& operator-=(const S21FixedMatrix& other) {
+    SubMatrix(other);
+    return *this;
+  }
+  constexpr S21FixedMatrix& operator*=(const S21FixedMatrix<C, C, T>& other) {
+    MulMatrix(other);
+    return *this;
+  }
+  constexpr S21FixedMatrix& operator*=(T number) {
+    MulNumber(number);
+    return *this;
+  }
+  constexpr T& operator()(int i, int j) {
+    CheckIndex(i, j);
+    return At(i, j);
+  }
+  constexpr const T& operator()(int i, int j) const {
+    CheckIndex(i, j);
+    return At(i, j);
+  }
+  // Unchecked element access
+  constexpr T& At(int i, int j) { return matrix_[i * C + j]; }
+  constexpr const T& At(int i, int j) const { return matrix_[i * C + j]; }
+  // Accessors
+  static constexpr int GetRows() { return R; }
+  static constexpr int GetCols() { return C; }
+  constexpr T* data() { return matrix_.data(); }
+  constexpr const T* data() const { return matrix_.data(); }
+  // Copies into a heap-backed S21BasicMatrix
+  S21BasicMatrix<T> ToMatrix() const {
+    S21BasicMatrix<T> result(R, C);
+    for (int i = 0; i < R; ++i) {
+      for (int j = 0; j < C; ++j) {
+        result.data()[i * result.stride() + j] = At(i, j);
+      }
+    }
+    return result;
+  }
+
+ private:
+  std::array<T, R * C> matrix_;
+
+  // 2x2 minors of rows 0-1 (s) and rows 2-3 (c), by column pair.
+  struct Minors4 {
+    T s0, s1, s2, s3, s4, s5;
+    T c0, c1, c2, c3, c4, c5;
+  };
+
+  constexpr Minors4 Minors() const {
+    return {At(0, 0) * At(1, 1) - At(1, 0) * At(0, 1),
+            At(0, 0) * At(1, 2) - At(1, 0) * At(0, 2),
+            At(0, 0) * At(1, 3) - At(1, 0) * At(0, 3),
+            At(0, 1) * At(1, 2) - At(1, 1) * At(0, 2),
+            At(0, 1) * At(1, 3) - At(1, 1) * At(0, 3),
+            At(0, 2) * At(1, 3) - At(1, 2) * At(0, 3),
+            At(2, 0) * At(3, 1) - At(3, 0) * At(2, 1),
+            At(2, 0) * At(3, 2) - At(3, 0) * At(2, 2),
+            At(2, 0) * At(3, 3) - At(3, 0) * At(2, 3),
+            At(2, 1) * At(3, 2) - At(3, 1) * At(2, 2),
+            At(2, 1) * At(3, 3) - At(3, 1) * At(2, 3),
+            At(2, 2) * At(3, 3) - At(3, 2) * At(2, 3)};
+  }
+
+  // Gauss-Jordan elimination with partial pivoting on a copy, for sizes
+  // past the closed forms. Returns the determinant; when inverse is given
+  // (holding the identity) the same row operations turn it into A^-1.
+  constexpr T Eliminate(S21FixedMatrix* inverse) const {
+    S21FixedMatrix a(*this);
+    T det = T(1);
+    for (int k = 0; k < R && det != T(0); ++k) {
+      int pivot = k;
+      for (int i = k + 1; i < R; ++i) {
+        if (Abs(a.At(i, k)) > Abs(a.At(pivot, k))) pivot = i;
+      }
+      if (a.At(pivot, k) == T(0)) {
+        det = T(0);
+        continue;
+      }
+      if (pivot != k) {
+        a.SwapRows(k, pivot);
+        if (inverse) inverse->SwapRows(k, pivot);
+        det = -det;
+      }
+      const T pivot_value = a.At(k, k);
+      det *= pivot_value;
+      for (int i = 0; i < R; ++i) {
+        if (i == k || (!inverse && i < k)) continue;
+        const T factor = a.At(i, k) / pivot_value;
+        for (int j = k; j < C; ++j) a.At(i, j) -= factor * a.At(k, j);
+        if (inverse) {
+          for (int j = 0; j < C; ++j) {
+            inverse->At(i, j) -= factor * inverse->At(k, j);
+          }
+        }
+      }
+    }
+    if (inverse && det != T(0)) {
+      for (int i = 0; i < R; ++i) {
+        const T scale = T(1) / a.At(i, i);
+        for (int j = 0; j < C; ++j) inverse->At(i, j) *= scale;
+      }
+    }
+    return det;
+  }
+
+  constexpr void SwapRows(int first, int second) {
+    for (int j = 0; j < C; ++j) {
+      const T value = At(first, j);
+      At(first, j) = At(second, j);
+      At(second, j) = value;
+    }
+  }
+
+  static constexpr Real Abs(T value) {
+    if constexpr (std::is_same<T, Real>::value) {
+      return value < T(0) ? -value : value;
+    } else {
+      return std::abs(value);
+    }
+  }
+
+  static constexpr void CheckIndex(int i, int j) {
+    if (R <= i || i < 0 || C <= j || j < 0) {
+      throw std::out_of_range("The index out of matrix limit");
+    }
+  }
+};
+
+template <int R, int C, typename T>
+constexpr S21FixedMatrix<R, C, T> operator*(T number,
+                                            const S21FixedMatrix<R, C, T>& m) {
+  return m * number;
+}
+
+#endif  // SRC_S21_FIXED_MATRIX_H_
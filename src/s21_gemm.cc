@@ -0,0 +1,241 @@
+#include "s21_gemm.h"
+
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <new>
+
+#include "s21_thread_pool.h"
+
+namespace {
+
+// Register tile computed by one micro-kernel call: kMr x kNr accumulators.
+// A row of the tile is one 64-byte line of T, so float gets twice the
+// columns of double.
+constexpr int kMr = 4;
+template <typename T>
+constexpr int kNr = static_cast<int>(64 / sizeof(T));
+// Cache blocking: a kKc x kNr sliver of B stays in L1, the packed
+// kMc x kKc block of A in L2 and the packed kKc x kNc panel of B in L3.
+constexpr int kMc = 128;
+constexpr int kKc = 256;
+constexpr int kNc = 2048;
+// Below this many multiply-adds packing costs more than it saves.
+constexpr long kSmallProduct = 32L * 32L * 32L;
+
+constexpr std::size_t kBufferAlignment = 64;
+
+template <typename T>
+T* AllocateBuffer(std::size_t size) {
+  return static_cast<T*>(
+      ::operator new(size * sizeof(T), std::align_val_t(kBufferAlignment)));
+}
+
+// Packing buffers are allocated once per thread and element type, and
+// reused by every call.
+template <typename T>
+struct PackBuffers {
+  PackBuffers()
+      : a(AllocateBuffer<T>(static_cast<std::size_t>(kMc) * kKc)),
+        b(AllocateBuffer<T>(static_cast<std::size_t>(kKc) * kNc)) {}
+  ~PackBuffers() {
+    ::operator delete(a, std::align_val_t(kBufferAlignment));
+    ::operator delete(b, std::align_val_t(kBufferAlignment));
+  }
+  PackBuffers(const PackBuffers&) = delete;
+  PackBuffers& operator=(const PackBuffers&) = delete;
+
+  T* a;
+  T* b;
+  bool b_claimed = false;
+};
+
+template <typename T>
+PackBuffers<T>& ThreadPackBuffers() {
+  thread_local PackBuffers<T> buffers;
+  return buffers;
+}
+
+// The packed panel of B is read by every task of a call, so the calling
+// thread's buffer is claimed for the whole call. A nested S21Gemm on the same
+// thread, run while the outer call waits for its tasks, gets its own buffer.
+template <typename T>
+class PanelB {
+ public:
+  PanelB() : buffers_(ThreadPackBuffers<T>()), owned_(nullptr) {
+    if (buffers_.b_claimed) {
+      owned_ = AllocateBuffer<T>(static_cast<std::size_t>(kKc) * kNc);
+    } else {
+      buffers_.b_claimed = true;
+    }
+  }
+  ~PanelB() {
+    if (owned_) {
+      ::operator delete(owned_, std::align_val_t(kBufferAlignment));
+    } else {
+      buffers_.b_claimed = false;
+    }
+  }
+  PanelB(const PanelB&) = delete;
+  PanelB& operator=(const PanelB&) = delete;
+
+  T* get() const { return owned_ ? owned_ : buffers_.b; }
+
+ private:
+  PackBuffers<T>& buffers_;
+  T* owned_;
+};
+
+template <typename T>
+void ScaleC(int m, int n, T beta, T* c, int ldc) {
+  if (beta == T(1)) return;
+  for (int i = 0; i < m; ++i) {
+    T* row = c + static_cast<std::ptrdiff_t>(i) * ldc;
+    if (beta == T(0)) {
+      std::fill(row, row + n, T(0));
+    } else {
+      for (int j = 0; j < n; ++j) row[j] *= beta;
+    }
+  }
+}
+
+// Every kernel below reads operands of type In and computes in T; In is T
+// except for the mixed-precision product, where float operands are widened
+// as they are read (or packed) and accumulate in double.
+
+// Straight i-k-j loop for products too small to amortise packing; the inner
+// loop walks rows of B and C so every access is unit-stride.
+template <typename In, typename T>
+void SmallGemm(int m, int n, int k, T alpha, const In* a, int lda,
+               const In* b, int ldb, T* c, int ldc) {
+  for (int i = 0; i < m; ++i) {
+    const In* a_row = a + static_cast<std::ptrdiff_t>(i) * lda;
+    T* c_row = c + static_cast<std::ptrdiff_t>(i) * ldc;
+    for (int p = 0; p < k; ++p) {
+      const T a_ip = alpha * static_cast<T>(a_row[p]);
+      const In* b_row = b + static_cast<std::ptrdiff_t>(p) * ldb;
+      for (int j = 0; j < n; ++j) c_row[j] += a_ip * static_cast<T>(b_row[j]);
+    }
+  }
+}
+
+// Packs an mc x kc block of A into kMr-row micro-panels stored k-major, so
+// the micro-kernel reads kMr consecutive values per step. Short panels are
+// zero-padded.
+template <typename In, typename T>
+void PackA(int mc, int kc, const In* a, int lda, T* packed) {
+  for (int ir = 0; ir < mc; ir += kMr) {
+    const int mr = std::min(kMr, mc - ir);
+    for (int p = 0; p < kc; ++p) {
+      for (int i = 0; i < kMr; ++i) {
+        const std::ptrdiff_t row = ir + i;
+        *packed++ = i < mr ? static_cast<T>(a[row * lda + p]) : T(0);
+      }
+    }
+  }
+}
+
+// Packs a kc x nc panel of B into kNr-column micro-panels stored k-major.
+template <typename In, typename T>
+void PackB(int kc, int nc, const In* b, int ldb, T* packed) {
+  for (int jr = 0; jr < nc; jr += kNr<T>) {
+    const int nr = std::min(kNr<T>, nc - jr);
+    for (int p = 0; p < kc; ++p) {
+      const In* b_row = b + static_cast<std::ptrdiff_t>(p) * ldb + jr;
+      for (int j = 0; j < kNr<T>; ++j) {
+        *packed++ = j < nr ? static_cast<T>(b_row[j]) : T(0);
+      }
+    }
+  }
+}
+
+// C[0:mr, 0:nr] += alpha * Apanel * Bpanel, accumulating the full
+// kMr x kNr tile in registers over the whole kc depth.
+template <typename T>
+void MicroKernel(int kc, const T* a, const T* b, T alpha, T* c, int ldc,
+                 int mr, int nr) {
+  T acc[kMr][kNr<T>] = {};
+  for (int p = 0; p < kc; ++p) {
+    for (int i = 0; i < kMr; ++i) {
+      const T a_ip = a[i];
+      for (int j = 0; j < kNr<T>; ++j) acc[i][j] += a_ip * b[j];
+    }
+    a += kMr;
+    b += kNr<T>;
+  }
+  for (int i = 0; i < mr; ++i) {
+    T* c_row = c + static_cast<std::ptrdiff_t>(i) * ldc;
+    for (int j = 0; j < nr; ++j) c_row[j] += alpha * acc[i][j];
+  }
+}
+
+template <typename In, typename T>
+void Gemm(int m, int n, int k, T alpha, const In* a, int lda, const In* b,
+          int ldb, T beta, T* c, int ldc) {
+  if (m <= 0 || n <= 0) return;
+  ScaleC(m, n, beta, c, ldc);
+  if (k <= 0 || alpha == T(0)) return;
+  if (static_cast<long>(m) * n * k <= kSmallProduct) {
+    SmallGemm(m, n, k, alpha, a, lda, b, ldb, c, ldc);
+    return;
+  }
+  const PanelB<T> panel_b;
+  T* packed_b = panel_b.get();
+  for (int jc = 0; jc < n; jc += kNc) {
+    const int nc = std::min(kNc, n - jc);
+    for (int pc = 0; pc < k; pc += kKc) {
+      const int kc = std::min(kKc, k - pc);
+      PackB(kc, nc, b + static_cast<std::ptrdiff_t>(pc) * ldb + jc, ldb,
+            packed_b);
+      // Row blocks of C are independent: each task packs its own slice of
+      // A into its thread's buffer and shares the packed panel of B.
+      const int m_panels = (m + kMr - 1) / kMr;
+      S21ParallelFor(
+          0, m_panels, 2.0 * kMr * kc * nc,
+          [&](std::ptrdiff_t panel_begin, std::ptrdiff_t panel_end) {
+            T* packed_a = ThreadPackBuffers<T>().a;
+            const int row_end = std::min(m, static_cast<int>(panel_end) * kMr);
+            for (int ic = static_cast<int>(panel_begin) * kMr; ic < row_end;
+                 ic += kMc) {
+              const int mc = std::min(kMc, row_end - ic);
+              PackA(mc, kc, a + static_cast<std::ptrdiff_t>(ic) * lda + pc,
+                    lda, packed_a);
+              for (int jr = 0; jr < nc; jr += kNr<T>) {
+                for (int ir = 0; ir < mc; ir += kMr) {
+                  MicroKernel(
+                      kc, packed_a + static_cast<std::ptrdiff_t>(ir) * kc,
+                      packed_b + static_cast<std::ptrdiff_t>(jr) * kc, alpha,
+                      c + static_cast<std::ptrdiff_t>(ic + ir) * ldc + jc + jr,
+                      ldc, std::min(kMr, mc - ir), std::min(kNr<T>, nc - jr));
+                }
+              }
+            }
+          });
+    }
+  }
+}
+
+}  // namespace
+
+template <typename T>
+void S21Gemm(int m, int n, int k, T alpha, const T* a, int lda, const T* b,
+             int ldb, T beta, T* c, int ldc) {
+  Gemm(m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+}
+
+void S21GemmMixed(int m, int n, int k, double alpha, const float* a, int lda,
+                  const float* b, int ldb, double beta, double* c, int ldc) {
+  Gemm(m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+}
+
+template void S21Gemm(int, int, int, float, const float*, int, const float*,
+                      int, float, float*, int);
+template void S21Gemm(int, int, int, double, const double*, int,
+                      const double*, int, double, double*, int);
+template void S21Gemm(int, int, int, long double, const long double*, int,
+                      const long double*, int, long double, long double*,
+                      int);
+template void S21Gemm(int, int, int, std::complex<double>,
+                      const std::complex<double>*, int,
+                      const std::complex<double>*, int, std::complex<double>,
+                      std::complex<double>*, int);
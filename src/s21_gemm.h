@@ -0,0 +1,20 @@
+#ifndef SRC_S21_GEMM_H_
+#define SRC_S21_GEMM_H_
+
+// Raw-pointer GEMM kernel behind S21BasicMatrix::Gemm and MulMatrix.
+// Computes C = alpha * A * B + beta * C for row-major operands where A is
+// m x k, B is k x n and C is m x n, each addressed through its own leading
+// dimension (distance in elements between the starts of adjacent rows).
+// C must not overlap A or B. Defined for float, double, long double and
+// std::complex<double>.
+template <typename T>
+void S21Gemm(int m, int n, int k, T alpha, const T* a, int lda, const T* b,
+             int ldb, T beta, T* c, int ldc);
+
+// The same product for float operands, accumulated and stored in double.
+// Operands are widened while they are packed, so they are read at float
+// bandwidth and never copied whole.
+void S21GemmMixed(int m, int n, int k, double alpha, const float* a, int lda,
+                  const float* b, int ldb, double beta, double* c, int ldc);
+
+#endif  // SRC_S21_GEMM_H_
@@ -0,0 +1,323 @@
+#include "s21_incremental.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+#include "s21_lu.h"
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+template <typename T>
+typename S21MatrixTraits<T>::Real MaxAbs(const T* values, int count) {
+  typename S21MatrixTraits<T>::Real largest = 0;
+  for (int i = 0; i < count; ++i) {
+    largest = std::max(largest, std::abs(values[i]));
+  }
+  return largest;
+}
+
+template <typename T>
+typename S21MatrixTraits<T>::Real MaxAbs(const S21BasicMatrix<T>& matrix) {
+  typename S21MatrixTraits<T>::Real largest = 0;
+  for (int i = 0; i < matrix.GetRows(); ++i) {
+    largest = std::max(largest, MaxAbs(matrix[i], matrix.GetCols()));
+  }
+  return largest;
+}
+
+}  // namespace
+
+template <typename T>
+S21BasicIncrementalInverse<T>::S21BasicIncrementalInverse(
+    S21BasicMatrix<T>& matrix)
+    : matrix_(&matrix),
+      inverse_(matrix.GetResource()),
+      determinant_(0),
+      singular_(false),
+      current_(false),
+      version_(matrix.GetVersion()),
+      error_(0),
+      tolerance_(std::sqrt(std::numeric_limits<Real>::epsilon())),
+      updates_(0),
+      refactors_(0) {
+  if (matrix.GetRows() != matrix.GetCols()) {
+    throw std::out_of_range("The matrix isn't square");
+  }
+}
+
+// Updates
+
+template <typename T>
+void S21BasicIncrementalInverse<T>::RankOneUpdate(const std::vector<T>& u,
+                                                  const std::vector<T>& v) {
+  const int n = Size();
+  if (static_cast<int>(u.size()) != n || static_cast<int>(v.size()) != n) {
+    throw std::out_of_range("Different size of matrix");
+  }
+  const bool updatable = Updatable();
+  const S21BasicSimdKernels<T>& simd = S21SimdActive<T>();
+  S21BasicMatrix<T>& a = *matrix_;
+  for (int i = 0; i < n; ++i) {
+    if (u[i] != T(0)) simd.axpy(a[i], u[i], v.data(), n);
+  }
+  if (updatable) {
+    UpdateCachesRankOne(u, v);
+  } else {
+    current_ = false;
+  }
+}
+
+template <typename T>
+void S21BasicIncrementalInverse<T>::LowRankUpdate(const S21BasicMatrix<T>& u,
+                                                  const S21BasicMatrix<T>& v) {
+  const int n = Size();
+  if (u.GetRows() != n || v.GetRows() != n || u.GetCols() != v.GetCols()) {
+    throw std::out_of_range("Different size of matrix");
+  }
+  if (u.GetCols() == 0) return;
+  const bool updatable = Updatable();
+  S21BasicMatrix<T>::Gemm(T(1), u, v.View().Transposed(), T(1),
+                          matrix_->View());
+  if (updatable) {
+    UpdateCaches(u, v);
+  } else {
+    current_ = false;
+  }
+}
+
+template <typename T>
+void S21BasicIncrementalInverse<T>::ReplaceRow(int i,
+                                               const std::vector<T>& row) {
+  const int n = Size();
+  if (i < 0 || i >= n) throw std::out_of_range("The index out of matrix limit");
+  if (static_cast<int>(row.size()) != n) {
+    throw std::out_of_range("Different size of matrix");
+  }
+  const bool updatable = Updatable();
+  std::vector<T> u(n);
+  std::vector<T> v(row);
+  u[i] = 1;
+  T* target = (*matrix_)[i];
+  for (int j = 0; j < n; ++j) v[j] -= target[j];
+  // Copied rather than added, so the row comes out exactly as given
+  std::copy(row.begin(), row.end(), target);
+  if (updatable) {
+    UpdateCachesRankOne(u, v);
+  } else {
+    current_ = false;
+  }
+}
+
+template <typename T>
+void S21BasicIncrementalInverse<T>::ReplaceCol(int j,
+                                               const std::vector<T>& col) {
+  const int n = Size();
+  if (j < 0 || j >= n) throw std::out_of_range("The index out of matrix limit");
+  if (static_cast<int>(col.size()) != n) {
+    throw std::out_of_range("Different size of matrix");
+  }
+  const bool updatable = Updatable();
+  std::vector<T> u(col);
+  std::vector<T> v(n);
+  v[j] = 1;
+  for (int i = 0; i < n; ++i) {
+    T& target = (*matrix_)[i][j];
+    u[i] -= target;
+    target = col[i];
+  }
+  if (updatable) {
+    UpdateCachesRankOne(u, v);
+  } else {
+    current_ = false;
+  }
+}
+
+// Queries
+
+template <typename T>
+T S21BasicIncrementalInverse<T>::Determinant() {
+  Refresh();
+  return determinant_;
+}
+
+template <typename T>
+bool S21BasicIncrementalInverse<T>::IsSingular() {
+  Refresh();
+  return singular_;
+}
+
+template <typename T>
+const S21BasicMatrix<T>& S21BasicIncrementalInverse<T>::Inverse() {
+  Refresh();
+  if (singular_) {
+    throw std::invalid_argument("the Determinant of the matrix is 0");
+  }
+  return inverse_;
+}
+
+template <typename T>
+std::vector<T> S21BasicIncrementalInverse<T>::Solve(const std::vector<T>& b) {
+  const int n = Size();
+  if (static_cast<int>(b.size()) != n) {
+    throw std::out_of_range("Different size of matrix");
+  }
+  const S21BasicMatrix<T>& inverse = Inverse();
+  std::vector<T> x(n);
+  S21ParallelFor(0, n, n, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    for (std::ptrdiff_t i = begin; i < end; ++i) {
+      const T* row = inverse[static_cast<int>(i)];
+      T sum = 0;
+      for (int j = 0; j < n; ++j) sum += row[j] * b[j];
+      x[i] = sum;
+    }
+  });
+  return x;
+}
+
+template <typename T>
+void S21BasicIncrementalInverse<T>::Refactor() {
+  Size();
+  const S21BasicLU<T> lu(*matrix_);
+  singular_ = lu.IsSingular();
+  determinant_ = singular_ ? T(0) : lu.Determinant();
+  if (!singular_) inverse_ = lu.Inverse();
+  version_ = matrix_->GetVersion();
+  current_ = true;
+  error_ = 0;
+  updates_ = 0;
+  ++refactors_;
+}
+
+template <typename T>
+void S21BasicIncrementalInverse<T>::SetTolerance(Real tolerance) {
+  tolerance_ = tolerance;
+  if (error_ > tolerance_) current_ = false;
+}
+
+template <typename T>
+typename S21BasicIncrementalInverse<T>::Real
+S21BasicIncrementalInverse<T>::GetTolerance() const {
+  return tolerance_;
+}
+
+template <typename T>
+typename S21BasicIncrementalInverse<T>::Real
+S21BasicIncrementalInverse<T>::GetErrorEstimate() const {
+  return error_;
+}
+
+template <typename T>
+int S21BasicIncrementalInverse<T>::GetUpdateCount() const {
+  return updates_;
+}
+
+template <typename T>
+int S21BasicIncrementalInverse<T>::GetRefactorCount() const {
+  return refactors_;
+}
+
+// Additional
+
+template <typename T>
+int S21BasicIncrementalInverse<T>::Size() const {
+  if (matrix_->GetRows() != matrix_->GetCols()) {
+    throw std::out_of_range("The matrix isn't square");
+  }
+  return matrix_->GetRows();
+}
+
+template <typename T>
+bool S21BasicIncrementalInverse<T>::Updatable() const {
+  return current_ && !singular_ && matrix_->GetVersion() == version_;
+}
+
+template <typename T>
+void S21BasicIncrementalInverse<T>::Refresh() {
+  if (!current_ || matrix_->GetVersion() != version_) Refactor();
+}
+
+template <typename T>
+void S21BasicIncrementalInverse<T>::UpdateCaches(const S21BasicMatrix<T>& u,
+                                                 const S21BasicMatrix<T>& v) {
+  const int n = inverse_.GetRows();
+  const int k = u.GetCols();
+  std::pmr::memory_resource* resource = inverse_.GetResource();
+  // W = A^-1 U, Z = V^T A^-1 and the capacitance matrix C = I + V^T W
+  S21BasicMatrix<T> w(n, k, resource);
+  S21BasicMatrix<T> z(k, n, resource);
+  S21BasicMatrix<T> capacitance(k, k, resource);
+  S21BasicMatrix<T>::Gemm(T(1), inverse_, u, T(0), w);
+  S21BasicMatrix<T>::Gemm(T(1), v.View().Transposed(), inverse_, T(0), z);
+  for (int i = 0; i < k; ++i) capacitance[i][i] = 1;
+  S21BasicMatrix<T>::Gemm(T(1), v.View().Transposed(), w, T(1), capacitance);
+  const S21BasicLU<T> lu(capacitance);
+  if (lu.IsSingular()) {
+    // So is the updated matrix; the refactor will find out for itself
+    current_ = false;
+    return;
+  }
+  const S21BasicMatrix<T> x = lu.Solve(z);
+  determinant_ *= lu.Determinant();
+  const Real before = MaxAbs(inverse_);
+  S21BasicMatrix<T>::Gemm(T(-1), w, x, T(1), inverse_);
+  AddError(k * MaxAbs(w) * MaxAbs(x) / std::min(before, MaxAbs(inverse_)));
+}
+
+template <typename T>
+void S21BasicIncrementalInverse<T>::UpdateCachesRankOne(
+    const std::vector<T>& u, const std::vector<T>& v) {
+  const int n = inverse_.GetRows();
+  const S21BasicSimdKernels<T>& simd = S21SimdActive<T>();
+  // w = A^-1 u by rows, z = v^T A^-1 by slices of columns
+  std::vector<T> w(n);
+  std::vector<T> z(n);
+  S21ParallelFor(0, n, 2.0 * n, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    for (std::ptrdiff_t i = begin; i < end; ++i) {
+      const T* row = inverse_[static_cast<int>(i)];
+      T sum = 0;
+      for (int j = 0; j < n; ++j) sum += row[j] * u[j];
+      w[i] = sum;
+    }
+    for (int i = 0; i < n; ++i) {
+      if (v[i] == T(0)) continue;
+      simd.axpy(z.data() + begin, v[i], inverse_[i] + begin,
+                static_cast<std::size_t>(end - begin));
+    }
+  });
+  T denominator = 1;
+  for (int i = 0; i < n; ++i) denominator += v[i] * w[i];
+  if (denominator == T(0)) {
+    current_ = false;
+    return;
+  }
+  determinant_ *= denominator;
+  const Real before = MaxAbs(inverse_);
+  S21ParallelFor(0, n, n, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    for (std::ptrdiff_t i = begin; i < end; ++i) {
+      if (w[i] == T(0)) continue;
+      simd.axpy(inverse_[static_cast<int>(i)], -w[i] / denominator, z.data(),
+                n);
+    }
+  });
+  AddError(MaxAbs(w.data(), n) * MaxAbs(z.data(), n) /
+           (std::abs(denominator) * std::min(before, MaxAbs(inverse_))));
+}
+
+template <typename T>
+void S21BasicIncrementalInverse<T>::AddError(Real growth) {
+  error_ += inverse_.GetRows() * std::numeric_limits<Real>::epsilon() *
+            (1 + growth);
+  ++updates_;
+  if (!(error_ <= tolerance_)) current_ = false;
+}
+
+template class S21BasicIncrementalInverse<float>;
+template class S21BasicIncrementalInverse<double>;
+template class S21BasicIncrementalInverse<long double>;
+template class S21BasicIncrementalInverse<std::complex<double>>;
@@ -0,0 +1,99 @@
+#ifndef SRC_S21_INCREMENTAL_H_
+#define SRC_S21_INCREMENTAL_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+#include "s21_matrix_traits.h"
+
+// Keeps the inverse and determinant of a square S21BasicMatrix current
+// while the matrix changes by low-rank updates, for online estimators that
+// need both after every tick. The updates go through the companion, which
+// applies them to the matrix and to its caches in O(n^2 k) by the
+// Sherman-Morrison-Woodbury formula and the matrix determinant lemma:
+//
+//   (A + U V^T)^-1 = A^-1 - A^-1 U (I + V^T A^-1 U)^-1 V^T A^-1
+//   det(A + U V^T) = det(A) * det(I + V^T A^-1 U)
+//
+// The caches are rebuilt from an LU factorisation, in O(n^3), by the next
+// query after any of these:
+// - the matrix changed other than through the companion: it was assigned,
+//   resized, changed by an in-place operation or written through the
+//   non-const operator(), all of which bump S21BasicMatrix::GetVersion;
+// - the update made the matrix singular, or came while it was;
+// - the estimated error of the cached inverse passed the tolerance.
+// Any use of the non-const operator() counts as a write, so read the
+// matrix through a const reference between updates. Writes through
+// at_unchecked, operator[], iterators, data() or views are not seen: call
+// Refactor after them.
+//
+// Each update adds about n * epsilon times its growth factor to the
+// estimate: the size of the correction over the smaller of the old and the
+// updated inverse. The formula loses digits where the correction dwarfs the
+// old inverse, as the matrix nears singular, or mostly cancels it. The
+// matrix must outlive the companion.
+template <typename T>
+class S21BasicIncrementalInverse {
+ public:
+  using Real = typename S21MatrixTraits<T>::Real;
+
+  explicit S21BasicIncrementalInverse(S21BasicMatrix<T>& matrix);
+  // Updates
+  // A += u * v^T, without conjugation for complex elements
+  void RankOneUpdate(const std::vector<T>& u, const std::vector<T>& v);
+  // A += U * V^T for n x k matrices U and V
+  void LowRankUpdate(const S21BasicMatrix<T>& u, const S21BasicMatrix<T>& v);
+  // Replace row i or column j of A, which is a rank-1 update
+  void ReplaceRow(int i, const std::vector<T>& row);
+  void ReplaceCol(int j, const std::vector<T>& col);
+  // Queries, which refactor first when the caches are stale
+  T Determinant();
+  bool IsSingular();
+  // Throws std::invalid_argument when the matrix is singular
+  const S21BasicMatrix<T>& Inverse();
+  std::vector<T> Solve(const std::vector<T>& b);
+  // Rebuilds the caches now
+  void Refactor();
+  // Relative error of the cached inverse that triggers a refactor; the
+  // default is the square root of epsilon
+  void SetTolerance(Real tolerance);
+  Real GetTolerance() const;
+  Real GetErrorEstimate() const;
+  // Updates applied to the caches since they were last rebuilt
+  int GetUpdateCount() const;
+  // Number of times the caches were rebuilt
+  int GetRefactorCount() const;
+
+ private:
+  S21BasicMatrix<T>* matrix_;
+  S21BasicMatrix<T> inverse_;
+  T determinant_;
+  bool singular_;
+  // Whether inverse_ and determinant_ describe the matrix at version_
+  bool current_;
+  std::uint64_t version_;
+  Real error_;
+  Real tolerance_;
+  int updates_;
+  int refactors_;
+  // Additional
+  // Order of the matrix, which throws once it is no longer square
+  int Size() const;
+  // Whether an update may go to the caches instead of leaving them stale
+  bool Updatable() const;
+  void Refresh();
+  // The cache half of A += U * V^T, with the matrix already updated
+  void UpdateCaches(const S21BasicMatrix<T>& u, const S21BasicMatrix<T>& v);
+  void UpdateCachesRankOne(const std::vector<T>& u, const std::vector<T>& v);
+  void AddError(Real growth);
+};
+
+extern template class S21BasicIncrementalInverse<float>;
+extern template class S21BasicIncrementalInverse<double>;
+extern template class S21BasicIncrementalInverse<long double>;
+extern template class S21BasicIncrementalInverse<std::complex<double>>;
+
+using S21IncrementalInverse = S21BasicIncrementalInverse<double>;
+
+#endif  // SRC_S21_INCREMENTAL_H_
@@ -0,0 +1,272 @@
+#include "s21_lu.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <stdexcept>
+
+#include "s21_gemm.h"
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+// Panel width of the blocked factorisation; below kBlockedMin columns the
+// unblocked loop is already cache resident.
+constexpr int kPanel = 64;
+constexpr int kBlockedMin = 256;
+
+template <typename T>
+T* RowOf(T* a, int lda, int i) {
+  return a + static_cast<std::ptrdiff_t>(i) * lda;
+}
+
+// Factors columns [col_begin, col_end) of rows [col_begin, n), swapping whole
+// rows so that the permutation also reaches the already factored L columns
+// on the left and the not yet updated columns on the right.
+template <typename T>
+int FactorPanel(int n, T* a, int lda, int* pivots, int col_begin,
+                int col_end) {
+  using Real = typename S21MatrixTraits<T>::Real;
+  const S21BasicSimdKernels<T>& simd = S21SimdActive<T>();
+  int sign = 1;
+  for (int k = col_begin; k < col_end; ++k) {
+    int pivot = k;
+    Real pivot_value = std::abs(RowOf(a, lda, k)[k]);
+    for (int i = k + 1; i < n; ++i) {
+      const Real value = std::abs(RowOf(a, lda, i)[k]);
+      if (value > pivot_value) {
+        pivot = i;
+        pivot_value = value;
+      }
+    }
+    pivots[k] = pivot;
+    if (pivot != k) {
+      std::swap_ranges(RowOf(a, lda, k), RowOf(a, lda, k) + n,
+                       RowOf(a, lda, pivot));
+      sign = -sign;
+    }
+    if (pivot_value == Real(0)) continue;
+    const T* row_k = RowOf(a, lda, k);
+    const T inverse_pivot = T(1) / row_k[k];
+    S21ParallelFor(k + 1, n, col_end - k,
+                   [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                     for (int i = static_cast<int>(begin); i < end; ++i) {
+                       T* row_i = RowOf(a, lda, i);
+                       const T factor = row_i[k] * inverse_pivot;
+                       row_i[k] = factor;
+                       if (factor == T(0)) continue;
+                       simd.axpy(row_i + k + 1, -factor, row_k + k + 1,
+                                 col_end - k - 1);
+                     }
+                   });
+  }
+  return sign;
+}
+
+// U12 = L11^-1 * A12 for the unit lower triangular diagonal block L11. The
+// columns of A12 are independent, so slices of them are solved in parallel.
+template <typename T>
+void SolveUpperPanel(int n, T* a, int lda, int col_begin, int col_end) {
+  const S21BasicSimdKernels<T>& simd = S21SimdActive<T>();
+  const int width = col_end - col_begin;
+  S21ParallelFor(
+      col_end, n, 0.5 * width * width,
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (int k = col_begin; k < col_end; ++k) {
+          const T* row_k = RowOf(a, lda, k);
+          for (int i = k + 1; i < col_end; ++i) {
+            T* row_i = RowOf(a, lda, i);
+            const T factor = row_i[k];
+            if (factor == T(0)) continue;
+            simd.axpy(row_i + begin, -factor, row_k + begin,
+                      static_cast<std::size_t>(end - begin));
+          }
+        }
+      });
+}
+
+// S21LuSolve on the nrhs columns of b starting at b[0].
+template <typename T>
+void SolveColumns(int n, const T* lu, int lda, const int* pivots, int nrhs,
+                  T* b, int ldb) {
+  for (int k = 0; k < n; ++k) {
+    if (pivots[k] != k) {
+      std::swap_ranges(RowOf(b, ldb, k), RowOf(b, ldb, k) + nrhs,
+                       RowOf(b, ldb, pivots[k]));
+    }
+  }
+  // Both sweeps update whole rows of B, so every inner loop is unit-stride
+  // no matter how many right-hand sides there are.
+  for (int i = 1; i < n; ++i) {
+    const T* lu_row = lu + static_cast<std::ptrdiff_t>(i) * lda;
+    T* b_row = RowOf(b, ldb, i);
+    for (int k = 0; k < i; ++k) {
+      const T factor = lu_row[k];
+      if (factor == T(0)) continue;
+      const T* b_k = RowOf(b, ldb, k);
+      for (int j = 0; j < nrhs; ++j) b_row[j] -= factor * b_k[j];
+    }
+  }
+  for (int i = n - 1; i >= 0; --i) {
+    const T* lu_row = lu + static_cast<std::ptrdiff_t>(i) * lda;
+    T* b_row = RowOf(b, ldb, i);
+    for (int k = i + 1; k < n; ++k) {
+      const T factor = lu_row[k];
+      if (factor == T(0)) continue;
+      const T* b_k = RowOf(b, ldb, k);
+      for (int j = 0; j < nrhs; ++j) b_row[j] -= factor * b_k[j];
+    }
+    const T inverse_pivot = T(1) / lu_row[i];
+    for (int j = 0; j < nrhs; ++j) b_row[j] *= inverse_pivot;
+  }
+}
+
+}  // namespace
+
+template <typename T>
+int S21LuFactor(int n, T* a, int lda, int* pivots) {
+  if (n < kBlockedMin) return FactorPanel(n, a, lda, pivots, 0, n);
+  int sign = 1;
+  for (int kb = 0; kb < n; kb += kPanel) {
+    const int kb_end = std::min(n, kb + kPanel);
+    sign *= FactorPanel(n, a, lda, pivots, kb, kb_end);
+    if (kb_end < n) {
+      SolveUpperPanel(n, a, lda, kb, kb_end);
+      // A22 -= L21 * U12
+      S21Gemm(n - kb_end, n - kb_end, kb_end - kb, T(-1),
+              RowOf(a, lda, kb_end) + kb, lda, RowOf(a, lda, kb) + kb_end, lda,
+              T(1), RowOf(a, lda, kb_end) + kb_end, lda);
+    }
+  }
+  return sign;
+}
+
+template <typename T>
+void S21LuSolve(int n, const T* lu, int lda, const int* pivots, int nrhs, T* b,
+                int ldb) {
+  // Right-hand sides are independent; each task solves a slice of columns.
+  S21ParallelFor(0, nrhs, static_cast<double>(n) * n,
+                 [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                   SolveColumns(n, lu, lda, pivots,
+                                static_cast<int>(end - begin), b + begin, ldb);
+                 });
+}
+
+template int S21LuFactor(int, float*, int, int*);
+template int S21LuFactor(int, double*, int, int*);
+template int S21LuFactor(int, long double*, int, int*);
+template int S21LuFactor(int, std::complex<double>*, int, int*);
+template void S21LuSolve(int, const float*, int, const int*, int, float*,
+                         int);
+template void S21LuSolve(int, const double*, int, const int*, int, double*,
+                         int);
+template void S21LuSolve(int, const long double*, int, const int*, int,
+                         long double*, int);
+template void S21LuSolve(int, const std::complex<double>*, int, const int*,
+                         int, std::complex<double>*, int);
+
+// S21BasicLU
+
+template <typename T>
+S21BasicLU<T>::S21BasicLU(const S21BasicMatrix<T>& matrix)
+    : factors_(matrix, matrix.GetResource()),
+      pivots_(matrix.GetResource()),
+      sign_(1) {
+  if (matrix.GetRows() != matrix.GetCols()) {
+    throw std::out_of_range("The matrix isn't square");
+  }
+  pivots_.resize(factors_.GetRows());
+  if (factors_.data()) {
+    sign_ = S21LuFactor(factors_.GetRows(), factors_.data(), factors_.stride(),
+                        pivots_.data());
+  }
+}
+
+template <typename T>
+T S21BasicLU<T>::Determinant() const {
+  const int n = GetSize();
+  T det = n > 0 ? T(sign_) : T(0);
+  for (int i = 0; i < n && det != T(0); ++i) {
+    det *= factors_.data()[static_cast<std::ptrdiff_t>(i) * factors_.stride() +
+                           i];
+  }
+  return det;
+}
+
+template <typename T>
+bool S21BasicLU<T>::IsSingular() const {
+  return PivotRatio() == 0;
+}
+
+template <typename T>
+typename S21BasicLU<T>::Real S21BasicLU<T>::PivotRatio() const {
+  const int n = GetSize();
+  Real min_pivot = 0;
+  Real max_pivot = 0;
+  for (int i = 0; i < n; ++i) {
+    const Real pivot = std::abs(
+        factors_.data()[static_cast<std::ptrdiff_t>(i) * factors_.stride() +
+                        i]);
+    min_pivot = (i == 0) ? pivot : std::min(min_pivot, pivot);
+    max_pivot = std::max(max_pivot, pivot);
+  }
+  return max_pivot > 0 ? min_pivot / max_pivot : 0;
+}
+
+template <typename T>
+std::vector<T> S21BasicLU<T>::Solve(const std::vector<T>& b) const {
+  if (static_cast<int>(b.size()) != GetSize()) {
+    throw std::out_of_range("Different size of matrix");
+  }
+  CheckSolvable();
+  std::vector<T> x(b);
+  S21LuSolve(GetSize(), factors_.data(), factors_.stride(), pivots_.data(), 1,
+             x.data(), 1);
+  return x;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicLU<T>::Solve(const S21BasicMatrix<T>& b) const {
+  if (b.GetRows() != GetSize()) {
+    throw std::out_of_range("Different size of matrix");
+  }
+  CheckSolvable();
+  S21BasicMatrix<T> x(b, factors_.GetResource());
+  if (x.data()) {
+    S21LuSolve(GetSize(), factors_.data(), factors_.stride(), pivots_.data(),
+               x.GetCols(), x.data(), x.stride());
+  }
+  return x;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicLU<T>::Inverse() const {
+  const int n = GetSize();
+  CheckSolvable();
+  S21BasicMatrix<T> inverse(n, n, factors_.GetResource());
+  for (int i = 0; i < n; ++i) {
+    inverse.data()[static_cast<std::ptrdiff_t>(i) * inverse.stride() + i] = 1;
+  }
+  S21LuSolve(n, factors_.data(), factors_.stride(), pivots_.data(), n,
+             inverse.data(), inverse.stride());
+  return inverse;
+}
+
+template <typename T>
+int S21BasicLU<T>::GetSize() const {
+  return factors_.GetRows();
+}
+
+template <typename T>
+void S21BasicLU<T>::CheckSolvable() const {
+  if (IsSingular()) {
+    throw std::invalid_argument("the Determinant of the matrix is 0");
+  }
+}
+
+template class S21BasicLU<float>;
+template class S21BasicLU<double>;
+template class S21BasicLU<long double>;
+template class S21BasicLU<std::complex<double>>;
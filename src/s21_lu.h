@@ -0,0 +1,64 @@
+#ifndef SRC_S21_LU_H_
+#define SRC_S21_LU_H_
+
+#include <memory_resource>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+#include "s21_matrix_traits.h"
+
+// In-place LU factorisation with partial pivoting, P * A = L * U, of the
+// row-major n x n matrix a with leading dimension lda. On return the strict
+// lower triangle holds L (unit diagonal implied), the upper triangle holds U
+// and pivots[k] is the row that was swapped with row k at step k. Returns the
+// sign of the permutation (+1 or -1). A zero pivot column is skipped, so a
+// singular matrix factors without error and yields a zero on U's diagonal.
+// Defined for the element types of S21BasicMatrix.
+template <typename T>
+int S21LuFactor(int n, T* a, int lda, int* pivots);
+
+// Overwrites the n x nrhs right-hand sides b (leading dimension ldb) with the
+// solution of A * X = B, given the factors and pivots from S21LuFactor. U
+// must have a nonzero diagonal.
+template <typename T>
+void S21LuSolve(int n, const T* lu, int lda, const int* pivots, int nrhs, T* b,
+                int ldb);
+
+// PLU factorisation of a square S21BasicMatrix, computed once in the
+// constructor and then reused for any number of determinant, solve and
+// inverse queries. The factors and every result matrix live on the resource
+// of the matrix that was factored.
+template <typename T>
+class S21BasicLU {
+ public:
+  using Real = typename S21MatrixTraits<T>::Real;
+
+  explicit S21BasicLU(const S21BasicMatrix<T>& matrix);
+  // Operations
+  T Determinant() const;
+  bool IsSingular() const;
+  // Smallest over largest magnitude on U's diagonal; a cheap lower bound on
+  // how close the matrix is to singular.
+  Real PivotRatio() const;
+  std::vector<T> Solve(const std::vector<T>& b) const;
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T>& b) const;
+  S21BasicMatrix<T> Inverse() const;
+  // Accessors
+  int GetSize() const;
+
+ private:
+  S21BasicMatrix<T> factors_;
+  std::pmr::vector<int> pivots_;
+  int sign_;
+  // Additional
+  void CheckSolvable() const;
+};
+
+extern template class S21BasicLU<float>;
+extern template class S21BasicLU<double>;
+extern template class S21BasicLU<long double>;
+extern template class S21BasicLU<std::complex<double>>;
+
+using S21LU = S21BasicLU<double>;
+
+#endif  // SRC_S21_LU_H_
@@ -0,0 +1,79 @@
+#include "s21_matrix_async.h"
+
+#include <chrono>
+
+#include "s21_thread_pool.h"
+
+namespace {
+
+// How long Wait sleeps before looking for queued tasks again, in case the
+// node it waits for is queued rather than running
+constexpr std::chrono::milliseconds kWaitSlice(1);
+
+}  // namespace
+
+S21TaskNode::S21TaskNode() : pending_(0), ready_(false) {}
+
+S21TaskNode::~S21TaskNode() = default;
+
+bool S21TaskNode::Ready() const {
+  return ready_.load(std::memory_order_acquire);
+}
+
+void S21TaskNode::Wait() const {
+  while (!Ready()) {
+    if (S21RunQueuedTask()) continue;
+    std::unique_lock<std::mutex> lock(mutex_);
+    ready_condition_.wait_for(lock, kWaitSlice, [this] { return Ready(); });
+  }
+}
+
+void S21TaskNode::RethrowIfFailed() const {
+  if (error_) std::rethrow_exception(error_);
+}
+
+void S21TaskNode::Start(
+    const std::vector<std::shared_ptr<S21TaskNode>>& inputs) {
+  // One count per input plus one held until every input has been visited,
+  // so an input finishing meanwhile cannot queue the node early.
+  pending_.store(static_cast<int>(inputs.size()) + 1);
+  for (const std::shared_ptr<S21TaskNode>& input : inputs) {
+    {
+      std::lock_guard<std::mutex> lock(input->mutex_);
+      if (!input->Ready()) {
+        input->dependents_.push_back(shared_from_this());
+        continue;
+      }
+    }
+    InputReady();
+  }
+  InputReady();
+}
+
+void S21TaskNode::Finish() {
+  std::vector<std::shared_ptr<S21TaskNode>> dependents;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ready_.store(true, std::memory_order_release);
+    dependents.swap(dependents_);
+  }
+  ready_condition_.notify_all();
+  for (const std::shared_ptr<S21TaskNode>& dependent : dependents) {
+    dependent->InputReady();
+  }
+}
+
+void S21TaskNode::Execute() {
+  try {
+    Run();
+  } catch (...) {
+    error_ = std::current_exception();
+  }
+  Finish();
+}
+
+void S21TaskNode::InputReady() {
+  if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    S21Submit([node = shared_from_this()] { node->Execute(); });
+  }
+}
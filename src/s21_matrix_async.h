@@ -0,0 +1,248 @@
+#ifndef SRC_S21_MATRIX_ASYNC_H_
+#define SRC_S21_MATRIX_ASYNC_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Asynchronous S21Matrix operations. Each call returns at once with an
+// S21Future and adds a node to a task graph: the node is queued on the
+// shared thread pool as soon as the futures it reads are ready, so
+// independent operations run concurrently and a chain such as
+//
+//   S21MatrixFuture a = S21MakeReadyFuture(std::move(a_matrix));
+//   S21MatrixFuture ab = S21MulMatrixAsync(a, b);
+//   S21MatrixFuture result = S21SumMatrixAsync(S21TransposeAsync(ab), c);
+//   const S21Matrix& value = result.Get();
+//
+// needs no thread blocked between its steps. Get() helps run queued tasks
+// while it waits, so the graph also completes with a single thread. An
+// exception thrown by an operation is stored in its future and rethrown by
+// Get() there and in everything computed from it.
+//
+// Operations of one graph run on different threads and may read the same
+// matrix at once, so the matrices involved must use a thread-safe memory
+// resource, such as the default one, and S21SetThreadCount must not be
+// called while a graph is running. A node holds its inputs only until it
+// has run, so intermediate results are freed once nothing reads them.
+
+// Graph bookkeeping shared by every S21Future, whatever its result type.
+class S21TaskNode : public std::enable_shared_from_this<S21TaskNode> {
+ public:
+  virtual ~S21TaskNode();
+  S21TaskNode(const S21TaskNode&) = delete;
+  S21TaskNode& operator=(const S21TaskNode&) = delete;
+
+  bool Ready() const;
+  // Runs queued tasks, or sleeps, until the node has run
+  void Wait() const;
+  void RethrowIfFailed() const;
+  // Queues the node once every one of inputs is ready
+  void Start(const std::vector<std::shared_ptr<S21TaskNode>>& inputs);
+
+ protected:
+  S21TaskNode();
+  // Marks the node ready and releases the nodes waiting for it
+  void Finish();
+
+ private:
+  // Computes the value; an exception is stored for Get() to rethrow
+  virtual void Run() = 0;
+  void Execute();
+  void InputReady();
+
+  std::atomic<int> pending_;
+  std::atomic<bool> ready_;
+  std::exception_ptr error_;
+  mutable std::mutex mutex_;
+  mutable std::condition_variable ready_condition_;
+  std::vector<std::shared_ptr<S21TaskNode>> dependents_;
+};
+
+template <typename R>
+class S21FutureState : public S21TaskNode {
+ public:
+  const R& Value() const { return *value_; }
+
+ protected:
+  std::optional<R> value_;
+};
+
+// A value known up front, the leaves of a graph
+template <typename R>
+class S21ReadyState : public S21FutureState<R> {
+ public:
+  template <typename U>
+  explicit S21ReadyState(U&& value) {
+    this->value_.emplace(std::forward<U>(value));
+    this->Finish();
+  }
+
+ private:
+  void Run() override {}
+};
+
+template <typename R>
+class S21Future {
+ public:
+  using Value = R;
+
+  S21Future() = default;
+  explicit S21Future(std::shared_ptr<S21FutureState<R>> state)
+      : state_(std::move(state)) {}
+
+  // False for a default-constructed future
+  bool Valid() const { return static_cast<bool>(state_); }
+  bool Ready() const { return state_->Ready(); }
+  void Wait() const { state_->Wait(); }
+  // Waits for the value; rethrows the exception of the operation or of any
+  // operation it depends on. The reference lives as long as the future.
+  const R& Get() const {
+    state_->Wait();
+    state_->RethrowIfFailed();
+    return state_->Value();
+  }
+  std::shared_ptr<S21TaskNode> Node() const { return state_; }
+
+ private:
+  std::shared_ptr<S21FutureState<R>> state_;
+};
+
+// Calls function(inputs.Get()...) once the inputs are ready, then lets go
+// of them and of the function
+template <typename R, typename F, typename... Inputs>
+class S21FutureTask : public S21FutureState<R> {
+ public:
+  explicit S21FutureTask(F function, const S21Future<Inputs>&... inputs)
+      : function_(std::move(function)), inputs_(std::in_place, inputs...) {}
+
+ private:
+  void Run() override {
+    try {
+      this->value_.emplace(std::apply(
+          [this](const S21Future<Inputs>&... inputs) {
+            return (*function_)(inputs.Get()...);
+          },
+          *inputs_));
+    } catch (...) {
+      Release();
+      throw;
+    }
+    Release();
+  }
+  void Release() {
+    inputs_.reset();
+    function_.reset();
+  }
+
+  std::optional<F> function_;
+  std::optional<std::tuple<S21Future<Inputs>...>> inputs_;
+};
+
+template <typename U>
+S21Future<std::decay_t<U>> S21MakeReadyFuture(U&& value) {
+  using R = std::decay_t<U>;
+  return S21Future<R>(
+      std::make_shared<S21ReadyState<R>>(std::forward<U>(value)));
+}
+
+// The generic node: a future of function(inputs.Get()...), which runs on
+// the pool once every input is ready. function must not wait on another
+// future itself.
+template <typename F, typename... Inputs>
+auto S21Then(F function, const S21Future<Inputs>&... inputs) {
+  using R = std::decay_t<std::invoke_result_t<F&, const Inputs&...>>;
+  static_assert(!std::is_void<R>::value, "an S21Future needs a value");
+  auto state = std::make_shared<S21FutureTask<R, F, Inputs...>>(
+      std::move(function), inputs...);
+  state->Start({inputs.Node()...});
+  return S21Future<R>(std::move(state));
+}
+
+template <typename T>
+using S21BasicMatrixFuture = S21Future<S21BasicMatrix<T>>;
+using S21MatrixFuture = S21BasicMatrixFuture<double>;
+
+// The S21BasicMatrix operations as graph nodes, with the exceptions of
+// their synchronous forms
+template <typename T>
+S21BasicMatrixFuture<T> S21SumMatrixAsync(const S21BasicMatrixFuture<T>& a,
+                                          const S21BasicMatrixFuture<T>& b) {
+  return S21Then(
+      [](const S21BasicMatrix<T>& x, const S21BasicMatrix<T>& y) {
+        S21BasicMatrix<T> sum(x);
+        sum.SumMatrix(y);
+        return sum;
+      },
+      a, b);
+}
+
+template <typename T>
+S21BasicMatrixFuture<T> S21SubMatrixAsync(const S21BasicMatrixFuture<T>& a,
+                                          const S21BasicMatrixFuture<T>& b) {
+  return S21Then(
+      [](const S21BasicMatrix<T>& x, const S21BasicMatrix<T>& y) {
+        S21BasicMatrix<T> difference(x);
+        difference.SubMatrix(y);
+        return difference;
+      },
+      a, b);
+}
+
+template <typename T>
+S21BasicMatrixFuture<T> S21MulNumberAsync(const S21BasicMatrixFuture<T>& a,
+                                          T number) {
+  return S21Then(
+      [number](const S21BasicMatrix<T>& x) {
+        S21BasicMatrix<T> product(x);
+        product.MulNumber(number);
+        return product;
+      },
+      a);
+}
+
+template <typename T>
+S21BasicMatrixFuture<T> S21MulMatrixAsync(const S21BasicMatrixFuture<T>& a,
+                                          const S21BasicMatrixFuture<T>& b) {
+  return S21Then(
+      [](const S21BasicMatrix<T>& x, const S21BasicMatrix<T>& y) {
+        return x * y;
+      },
+      a, b);
+}
+
+template <typename T>
+S21BasicMatrixFuture<T> S21TransposeAsync(const S21BasicMatrixFuture<T>& a) {
+  return S21Then([](const S21BasicMatrix<T>& x) { return x.Transpose(); }, a);
+}
+
+template <typename T>
+S21BasicMatrixFuture<T> S21CalcComplementsAsync(
+    const S21BasicMatrixFuture<T>& a) {
+  return S21Then(
+      [](const S21BasicMatrix<T>& x) { return x.CalcComplements(); }, a);
+}
+
+template <typename T>
+S21Future<T> S21DeterminantAsync(const S21BasicMatrixFuture<T>& a) {
+  return S21Then([](const S21BasicMatrix<T>& x) { return x.Determinant(); },
+                 a);
+}
+
+template <typename T>
+S21BasicMatrixFuture<T> S21InverseMatrixAsync(
+    const S21BasicMatrixFuture<T>& a) {
+  return S21Then([](const S21BasicMatrix<T>& x) { return x.InverseMatrix(); },
+                 a);
+}
+
+#endif  // SRC_S21_MATRIX_ASYNC_H_
@@ -0,0 +1,610 @@
+#include "s21_matrix_batch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define S21_SIMD_X86 1
+#endif
+
+namespace {
+
+// Lane kernels. Each one handles the W matrices of one tile, whose element
+// (i, j) is the lane array at Element<W>(tile, cols, i, j). The lane
+// loops carry no dependencies between matrices, so every one of them turns
+// into a handful of full-width vector instructions. Pivoting is branchless:
+// a row is swapped lane by lane with a select, which leaves every matrix of
+// a register on its own pivot order.
+
+template <int W, typename T>
+T* Element(T* a, int cols, int i, int j) {
+  return a + (i * cols + j) * W;
+}
+
+// c += a * b, accumulated in c row by row so that the lane loops of one
+// row are independent of each other.
+template <typename T, int W>
+void MulLanes(int rows, int inner, int cols, const T* a, const T* b, T* c) {
+  for (int i = 0; i < rows; ++i) {
+    for (int k = 0; k < inner; ++k) {
+      const T* x = Element<W>(a, inner, i, k);
+      for (int j = 0; j < cols; ++j) {
+        const T* y = Element<W>(b, cols, k, j);
+        T* out = Element<W>(c, cols, i, j);
+#pragma GCC ivdep
+        for (int l = 0; l < W; ++l) out[l] += x[l] * y[l];
+      }
+    }
+  }
+}
+
+template <typename T, int W>
+void TransposeLanes(int rows, int cols, const T* a, T* out) {
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      const T* x = Element<W>(a, cols, i, j);
+      T* y = Element<W>(out, rows, j, i);
+#pragma GCC ivdep
+      for (int l = 0; l < W; ++l) y[l] = x[l];
+    }
+  }
+}
+
+// Exact cofactor expansions, the same as S21BasicMatrix uses.
+template <typename T, int W>
+void SmallDeterminantLanes(int n, const T* a, T* det) {
+  if (n == 1) {
+#pragma GCC ivdep
+    for (int l = 0; l < W; ++l) det[l] = a[l];
+  } else if (n == 2) {
+    const T* a00 = Element<W>(a, 2, 0, 0);
+    const T* a01 = Element<W>(a, 2, 0, 1);
+    const T* a10 = Element<W>(a, 2, 1, 0);
+    const T* a11 = Element<W>(a, 2, 1, 1);
+#pragma GCC ivdep
+    for (int l = 0; l < W; ++l) det[l] = a00[l] * a11[l] - a01[l] * a10[l];
+  } else {
+    const T* r0[3];
+    const T* r1[3];
+    const T* r2[3];
+    for (int j = 0; j < 3; ++j) {
+      r0[j] = Element<W>(a, 3, 0, j);
+      r1[j] = Element<W>(a, 3, 1, j);
+      r2[j] = Element<W>(a, 3, 2, j);
+    }
+#pragma GCC ivdep
+    for (int l = 0; l < W; ++l) {
+      det[l] = r0[0][l] * (r1[1][l] * r2[2][l] - r2[1][l] * r1[2][l]) -
+               r0[1][l] * (r1[0][l] * r2[2][l] - r2[0][l] * r1[2][l]) +
+               r0[2][l] * (r1[0][l] * r2[1][l] - r2[0][l] * r1[1][l]);
+    }
+  }
+}
+
+// Swaps rows k and r of a, and of x when given, in the lanes where row r
+// has the larger entry in column k, flipping sign there. Column k decides
+// every swap, so it is exchanged last.
+template <typename T, int W>
+void PivotLanes(int n, int k, int r, T* a, T* x, T* sign) {
+  const T* candidate = Element<W>(a, n, r, k);
+  const T* pivot = Element<W>(a, n, k, k);
+  auto swap_row = [&](T* m, int first) {
+    for (int c = first; c < n; ++c) {
+      T* p = Element<W>(m, n, k, c);
+      T* q = Element<W>(m, n, r, c);
+#pragma GCC ivdep
+      for (int l = 0; l < W; ++l) {
+        const bool swap = std::abs(candidate[l]) > std::abs(pivot[l]);
+        const T u = p[l];
+        const T v = q[l];
+        p[l] = swap ? v : u;
+        q[l] = swap ? u : v;
+      }
+    }
+  };
+  swap_row(a, k + 1);
+  if (x) swap_row(x, 0);
+  T* p = Element<W>(a, n, k, k);
+  T* q = Element<W>(a, n, r, k);
+#pragma GCC ivdep
+  for (int l = 0; l < W; ++l) {
+    const bool swap = std::abs(q[l]) > std::abs(p[l]);
+    const T u = p[l];
+    const T v = q[l];
+    sign[l] = swap ? -sign[l] : sign[l];
+    p[l] = swap ? v : u;
+    q[l] = swap ? u : v;
+  }
+}
+
+// LU elimination with partial pivoting, the same arithmetic as
+// S21LuFactor, leaving U in the upper triangle of a and det(a) in det.
+// When x is given, the row exchanges and eliminations are applied to it as
+// well, which turns it into L^-1 * P * x.
+template <typename T, int W>
+void EliminateLanes(int n, T* a, T* x, T* det) {
+  T scale[W];
+#pragma GCC ivdep
+  for (int l = 0; l < W; ++l) det[l] = T(1);
+  for (int k = 0; k < n; ++k) {
+    for (int r = k + 1; r < n; ++r) {
+      PivotLanes<T, W>(n, k, r, a, x, det);
+    }
+    const T* pivot = Element<W>(a, n, k, k);
+#pragma GCC ivdep
+    for (int l = 0; l < W; ++l) {
+      det[l] *= pivot[l];
+      scale[l] = pivot[l] == T(0) ? T(1) : T(1) / pivot[l];
+    }
+    for (int r = k + 1; r < n; ++r) {
+      T factor[W];
+      const T* lead = Element<W>(a, n, r, k);
+#pragma GCC ivdep
+      for (int l = 0; l < W; ++l) factor[l] = lead[l] * scale[l];
+      for (int c = k + 1; c < n; ++c) {
+        const T* p = Element<W>(a, n, k, c);
+        T* q = Element<W>(a, n, r, c);
+#pragma GCC ivdep
+        for (int l = 0; l < W; ++l) q[l] -= factor[l] * p[l];
+      }
+      for (int c = 0; x && c < n; ++c) {
+        const T* p = Element<W>(x, n, k, c);
+        T* q = Element<W>(x, n, r, c);
+#pragma GCC ivdep
+        for (int l = 0; l < W; ++l) q[l] -= factor[l] * p[l];
+      }
+    }
+  }
+}
+
+// x = U^-1 * x for the U left by EliminateLanes. A zero pivot sets its
+// lane of singular to one and is divided by as if it were one, so no inf
+// or NaN spreads to the other lanes.
+template <typename T, int W>
+void BackSubstituteLanes(int n, const T* a, T* x, T* singular) {
+  T scale[W];
+  for (int i = n - 1; i >= 0; --i) {
+    for (int k = i + 1; k < n; ++k) {
+      const T* factor = Element<W>(a, n, i, k);
+      for (int c = 0; c < n; ++c) {
+        const T* p = Element<W>(x, n, k, c);
+        T* q = Element<W>(x, n, i, c);
+#pragma GCC ivdep
+        for (int l = 0; l < W; ++l) q[l] -= factor[l] * p[l];
+      }
+    }
+    const T* pivot = Element<W>(a, n, i, i);
+#pragma GCC ivdep
+    for (int l = 0; l < W; ++l) {
+      singular[l] = pivot[l] == T(0) ? T(1) : singular[l];
+      scale[l] = pivot[l] == T(0) ? T(1) : T(1) / pivot[l];
+    }
+    for (int c = 0; c < n; ++c) {
+      T* q = Element<W>(x, n, i, c);
+#pragma GCC ivdep
+      for (int l = 0; l < W; ++l) q[l] *= scale[l];
+    }
+  }
+}
+
+// Elimination overwrites its input, so it runs on a copy of each tile,
+// kept on the stack up to this many elements.
+template <typename T>
+constexpr std::ptrdiff_t kStackTile = 16384 / sizeof(T);
+
+// Runs f compiled for the instruction set of the SIMD kernels of T: the
+// lane loops are inlined into the wrapper and vectorised at its register
+// width.
+#ifdef S21_SIMD_X86
+template <typename F>
+__attribute__((target("avx512f"), flatten)) void RunAvx512(const F& f) {
+  f();
+}
+
+template <typename F>
+__attribute__((target("avx2"), flatten)) void RunAvx2(const F& f) {
+  f();
+}
+#endif
+
+template <typename F>
+__attribute__((flatten)) void RunDefault(const F& f) {
+  f();
+}
+
+template <typename T, typename F>
+void RunLanes(const F& f) {
+#ifdef S21_SIMD_X86
+  const S21SimdLevel level = S21SimdActive<T>().level;
+  if (level == S21SimdLevel::kAvx512) {
+    RunAvx512(f);
+  } else if (level == S21SimdLevel::kAvx2) {
+    RunAvx2(f);
+  } else {
+    RunDefault(f);
+  }
+#else
+  RunDefault(f);
+#endif
+}
+
+}  // namespace
+
+// Constructors
+
+template <typename T>
+S21BasicMatrixBatch<T>::S21BasicMatrixBatch(
+    int count, int rows, int cols, std::pmr::memory_resource* resource)
+    : count_(count),
+      rows_(rows),
+      cols_(cols),
+      tiles_((count + kLanes - 1) / kLanes),
+      data_(nullptr),
+      resource_(resource) {
+  if (count < 0 || rows < 0 || cols < 0) {
+    throw std::out_of_range("Incorrect size of matrix");
+  }
+  data_ = MemoryAllocating();
+}
+
+template <typename T>
+S21BasicMatrixBatch<T>::S21BasicMatrixBatch(const S21BasicMatrixBatch& other)
+    : S21BasicMatrixBatch(other, std::pmr::get_default_resource()) {}
+
+template <typename T>
+S21BasicMatrixBatch<T>::S21BasicMatrixBatch(
+    const S21BasicMatrixBatch& other, std::pmr::memory_resource* resource)
+    : S21BasicMatrixBatch(other.count_, other.rows_, other.cols_, resource) {
+  if (data_) S21SimdActive<T>().copy(data_, other.data_, Size());
+}
+
+template <typename T>
+S21BasicMatrixBatch<T>::S21BasicMatrixBatch(
+    S21BasicMatrixBatch&& other) noexcept
+    : count_(0),
+      rows_(0),
+      cols_(0),
+      tiles_(0),
+      data_(nullptr),
+      resource_(other.resource_) {
+  Swap(other);
+}
+
+template <typename T>
+S21BasicMatrixBatch<T>::~S21BasicMatrixBatch() {
+  MemoryDeallocating();
+}
+
+// Operations
+
+template <typename T>
+void S21BasicMatrixBatch<T>::SumMatrix(const S21BasicMatrixBatch& other) {
+  if (!EqSizeBatch(other)) throw std::out_of_range("Different size of matrix");
+  if (data_) {
+    S21StridedUpdate(S21StridedOp::kAdd, tiles_, TileSize(), data_,
+                     TileSize(), 1, other.data_, TileSize(), 1);
+  }
+}
+
+template <typename T>
+void S21BasicMatrixBatch<T>::SubMatrix(const S21BasicMatrixBatch& other) {
+  if (!EqSizeBatch(other)) throw std::out_of_range("Different size of matrix");
+  if (data_) {
+    S21StridedUpdate(S21StridedOp::kSub, tiles_, TileSize(), data_,
+                     TileSize(), 1, other.data_, TileSize(), 1);
+  }
+}
+
+template <typename T>
+void S21BasicMatrixBatch<T>::MulNumber(T number) {
+  if (data_) {
+    S21StridedScale(tiles_, TileSize(), data_, TileSize(), 1, number);
+  }
+}
+
+template <typename T>
+void S21BasicMatrixBatch<T>::MulMatrix(const S21BasicMatrixBatch& other) {
+  if (count_ != other.count_) {
+    throw std::out_of_range("Different size of matrix");
+  }
+  if (cols_ != other.rows_) {
+    throw std::out_of_range(
+        "The number of columns of the first matrix does not equal the number "
+        "of rows of the second matrix");
+  }
+  // A square other keeps the shape, so each product tile is built on the
+  // stack and copied back in place of its factor.
+  const bool in_place = other.cols_ == cols_ && TileSize() <= kStackTile<T>;
+  S21BasicMatrixBatch result(in_place ? 0 : count_, rows_, other.cols_,
+                             resource_);
+  if (data_ && other.cols_ > 0) {
+    const int rows = rows_;
+    const int inner = cols_;
+    const int cols = other.cols_;
+    const std::ptrdiff_t c_tile = static_cast<std::ptrdiff_t>(rows) * cols *
+                                  kLanes;
+    T* a = data_;
+    const T* b = other.data_;
+    T* c = result.data_;
+    S21ParallelFor(
+        0, tiles_, double(rows) * inner * cols * kLanes,
+        [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          RunLanes<T>([&] {
+            T stack[kStackTile<T>];
+            for (std::ptrdiff_t tile = begin; tile < end; ++tile) {
+              T* factor = a + tile * TileSize();
+              T* product = in_place ? stack : c + tile * c_tile;
+              if (in_place) std::fill_n(stack, c_tile, T(0));
+              MulLanes<T, kLanes>(rows, inner, cols, factor,
+                                  b + tile * other.TileSize(), product);
+              if (in_place) std::copy_n(stack, c_tile, factor);
+            }
+          });
+        });
+  }
+  if (!in_place) Swap(result);
+}
+
+template <typename T>
+S21BasicMatrixBatch<T> S21BasicMatrixBatch<T>::Transpose() const {
+  S21BasicMatrixBatch result(count_, cols_, rows_, resource_);
+  if (data_) {
+    const T* a = data_;
+    T* out = result.data_;
+    S21ParallelFor(0, tiles_, TileSize(),
+                   [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                     for (std::ptrdiff_t tile = begin; tile < end; ++tile) {
+                       TransposeLanes<T, kLanes>(rows_, cols_,
+                                                 a + tile * TileSize(),
+                                                 out + tile * TileSize());
+                     }
+                   });
+  }
+  return result;
+}
+
+template <typename T>
+std::vector<T> S21BasicMatrixBatch<T>::Determinant() const {
+  if (rows_ != cols_) throw std::out_of_range("The matrix isn't square");
+  std::vector<T> det(static_cast<std::size_t>(tiles_) * kLanes, T(1));
+  if (data_) {
+    const int n = rows_;
+    // The closed forms only read the input.
+    const bool on_stack = TileSize() <= kStackTile<T>;
+    S21BasicMatrixBatch work(n > 3 && !on_stack ? count_ : 0, n, n,
+                             resource_);
+    const T* a = data_;
+    T* w = work.data_;
+    T* out = det.data();
+    S21ParallelFor(
+        0, tiles_, double(n) * n * n * kLanes,
+        [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          RunLanes<T>([&] {
+            T stack[kStackTile<T>];
+            for (std::ptrdiff_t tile = begin; tile < end; ++tile) {
+              const T* source = a + tile * TileSize();
+              if (n > 3) {
+                T* copy = on_stack ? stack : w + tile * TileSize();
+                std::copy_n(source, TileSize(), copy);
+                EliminateLanes<T, kLanes>(n, copy, nullptr,
+                                          out + tile * kLanes);
+              } else {
+                SmallDeterminantLanes<T, kLanes>(n, source,
+                                                 out + tile * kLanes);
+              }
+            }
+          });
+        });
+  }
+  det.resize(count_);
+  return det;
+}
+
+template <typename T>
+S21BasicMatrixBatch<T> S21BasicMatrixBatch<T>::InverseMatrix() const {
+  if (rows_ != cols_) throw std::out_of_range("The matrix isn't square");
+  S21BasicMatrixBatch result(count_, rows_, cols_, resource_);
+  if (data_) {
+    const int n = rows_;
+    const bool on_stack = TileSize() <= kStackTile<T>;
+    S21BasicMatrixBatch work(on_stack ? 0 : count_, n, n, resource_);
+    std::pmr::vector<T> singular(static_cast<std::size_t>(tiles_) * kLanes,
+                                 T(0), resource_);
+    const T* a = data_;
+    T* w = work.data_;
+    T* x = result.data_;
+    T* flags = singular.data();
+    S21ParallelFor(
+        0, tiles_, 2.0 * n * n * n * kLanes,
+        [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          RunLanes<T>([&] {
+            T stack[kStackTile<T>];
+            for (std::ptrdiff_t tile = begin; tile < end; ++tile) {
+              T* copy = on_stack ? stack : w + tile * TileSize();
+              T* inverse = x + tile * TileSize();
+              T det[kLanes];
+              std::copy_n(a + tile * TileSize(), TileSize(), copy);
+              for (int i = 0; i < n; ++i) {
+                std::fill_n(Element<kLanes>(inverse, n, i, i), kLanes, T(1));
+              }
+              EliminateLanes<T, kLanes>(n, copy, inverse, det);
+              BackSubstituteLanes<T, kLanes>(n, copy, inverse,
+                                             flags + tile * kLanes);
+            }
+          });
+        });
+    for (int index = 0; index < count_; ++index) {
+      if (singular[index] != T(0)) {
+        throw std::invalid_argument("the Determinant of the matrix is 0");
+      }
+    }
+  }
+  return result;
+}
+
+// Overloadings opertators
+
+template <typename T>
+S21BasicMatrixBatch<T>& S21BasicMatrixBatch<T>::operator=(
+    const S21BasicMatrixBatch& other) {
+  if (this != &other) {
+    if (EqSizeBatch(other)) {
+      if (data_) S21SimdActive<T>().copy(data_, other.data_, Size());
+    } else {
+      S21BasicMatrixBatch copy(other, resource_);
+      Swap(copy);
+    }
+  }
+  return *this;
+}
+
+template <typename T>
+S21BasicMatrixBatch<T>& S21BasicMatrixBatch<T>::operator=(
+    S21BasicMatrixBatch&& other) noexcept {
+  if (this != &other) {
+    S21BasicMatrixBatch moved(std::move(other));
+    Swap(moved);
+  }
+  return *this;
+}
+
+template <typename T>
+T& S21BasicMatrixBatch<T>::operator()(int index, int i, int j) {
+  return View(index)(i, j);
+}
+
+// Accessors & mutators
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrixBatch<T>::View(int index) {
+  CheckIndex(index);
+  return S21BasicMatrixView<T>(data_ + Offset(index), rows_, cols_,
+                               cols_ * kLanes, kLanes);
+}
+
+template <typename T>
+S21BasicMatrixView<const T> S21BasicMatrixBatch<T>::View(int index) const {
+  CheckIndex(index);
+  return S21BasicMatrixView<const T>(data_ + Offset(index), rows_, cols_,
+                                     cols_ * kLanes, kLanes);
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrixBatch<T>::Get(int index) const {
+  return S21BasicMatrix<T>(View(index));
+}
+
+template <typename T>
+void S21BasicMatrixBatch<T>::Set(int index,
+                                 const S21BasicMatrixView<const T>& matrix) {
+  if (matrix.GetRows() != rows_ || matrix.GetCols() != cols_) {
+    throw std::out_of_range("Different size of matrix");
+  }
+  View(index).Assign(matrix);
+}
+
+template <typename T>
+int S21BasicMatrixBatch<T>::GetCount() const {
+  return count_;
+}
+
+template <typename T>
+int S21BasicMatrixBatch<T>::GetRows() const {
+  return rows_;
+}
+
+template <typename T>
+int S21BasicMatrixBatch<T>::GetCols() const {
+  return cols_;
+}
+
+template <typename T>
+T* S21BasicMatrixBatch<T>::data() {
+  return data_;
+}
+
+template <typename T>
+const T* S21BasicMatrixBatch<T>::data() const {
+  return data_;
+}
+
+template <typename T>
+std::pmr::memory_resource* S21BasicMatrixBatch<T>::GetResource() const {
+  return resource_;
+}
+
+template <typename T>
+void S21BasicMatrixBatch<T>::Swap(S21BasicMatrixBatch& other) noexcept {
+  std::swap(count_, other.count_);
+  std::swap(rows_, other.rows_);
+  std::swap(cols_, other.cols_);
+  std::swap(tiles_, other.tiles_);
+  std::swap(data_, other.data_);
+  std::swap(resource_, other.resource_);
+}
+
+// Additional
+
+template <typename T>
+std::size_t S21BasicMatrixBatch<T>::Size() const {
+  return static_cast<std::size_t>(tiles_) * TileSize();
+}
+
+template <typename T>
+std::ptrdiff_t S21BasicMatrixBatch<T>::TileSize() const {
+  return static_cast<std::ptrdiff_t>(rows_) * cols_ * kLanes;
+}
+
+template <typename T>
+std::ptrdiff_t S21BasicMatrixBatch<T>::Offset(int index) const {
+  return index / kLanes * TileSize() + index % kLanes;
+}
+
+template <typename T>
+T* S21BasicMatrixBatch<T>::MemoryAllocating() {
+  T* allocated = nullptr;
+  const std::size_t size = Size();
+  if (size > 0) {
+    allocated =
+        static_cast<T*>(resource_->allocate(size * sizeof(T), kAlignment));
+    const S21BasicSimdKernels<T>& simd = S21SimdActive<T>();
+    S21ParallelFor(0, static_cast<std::ptrdiff_t>(size), 1.0,
+                   [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                     simd.fill(allocated + begin, T(0),
+                               static_cast<std::size_t>(end - begin));
+                   });
+  }
+  return allocated;
+}
+
+template <typename T>
+void S21BasicMatrixBatch<T>::MemoryDeallocating() {
+  if (data_) {
+    resource_->deallocate(data_, Size() * sizeof(T), kAlignment);
+    data_ = nullptr;
+  }
+}
+
+template <typename T>
+bool S21BasicMatrixBatch<T>::EqSizeBatch(
+    const S21BasicMatrixBatch& other) const {
+  return count_ == other.count_ && rows_ == other.rows_ &&
+         cols_ == other.cols_;
+}
+
+template <typename T>
+void S21BasicMatrixBatch<T>::CheckIndex(int index) const {
+  if (index < 0 || count_ <= index) {
+    throw std::out_of_range("The index out of matrix limit");
+  }
+}
+
+template class S21BasicMatrixBatch<float>;
+template class S21BasicMatrixBatch<double>;
+template class S21BasicMatrixBatch<long double>;
+template class S21BasicMatrixBatch<std::complex<double>>;
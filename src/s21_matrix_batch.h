@@ -0,0 +1,102 @@
+#ifndef SRC_S21_MATRIX_BATCH_H_
+#define SRC_S21_MATRIX_BATCH_H_
+
+#include <complex>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+#include "s21_matrix_traits.h"
+#include "s21_matrix_view.h"
+
+// count matrices of one shape, stored interleaved in tiles of kLanes
+// matrices: element (i, j) of the matrices of a tile is one contiguous lane
+// array, so element (i, j) of matrix index lives at
+//   data()[(index / kLanes * rows * cols + i * cols + j) * kLanes +
+//          index % kLanes].
+// The last tile is padded with zero matrices. Every kernel runs the same
+// instruction on a full 64-byte register of matrices at once, which is what
+// makes thousands of 3x3 or 4x4 products, determinants and inverses cheap,
+// and tiles are split across the shared thread pool. The buffer comes from
+// a std::pmr::memory_resource, like the one of S21BasicMatrix.
+template <typename T>
+class S21BasicMatrixBatch {
+ public:
+  using Value = T;
+  using Real = typename S21MatrixTraits<T>::Real;
+
+  // Constructors
+  // count zero matrices of rows x cols
+  S21BasicMatrixBatch(int count, int rows, int cols,
+                      std::pmr::memory_resource* resource =
+                          std::pmr::get_default_resource());
+  S21BasicMatrixBatch(const S21BasicMatrixBatch& other);
+  S21BasicMatrixBatch(const S21BasicMatrixBatch& other,
+                      std::pmr::memory_resource* resource);
+  S21BasicMatrixBatch(S21BasicMatrixBatch&& other) noexcept;
+  ~S21BasicMatrixBatch();
+  // Operations, applied to every matrix of the batch
+  void SumMatrix(const S21BasicMatrixBatch& other);
+  void SubMatrix(const S21BasicMatrixBatch& other);
+  void MulNumber(T number);
+  // Matrix index becomes matrix index of this times matrix index of other
+  void MulMatrix(const S21BasicMatrixBatch& other);
+  S21BasicMatrixBatch Transpose() const;
+  // Closed forms up to 3x3, elimination with partial pivoting beyond
+  std::vector<T> Determinant() const;
+  // LU with partial pivoting, as S21BasicMatrix does; throws if any matrix
+  // of the batch is singular
+  S21BasicMatrixBatch InverseMatrix() const;
+  // Overloadings opertators
+  S21BasicMatrixBatch& operator=(const S21BasicMatrixBatch& other);
+  S21BasicMatrixBatch& operator=(S21BasicMatrixBatch&& other) noexcept;
+  // Element (i, j) of matrix index
+  T& operator()(int index, int i, int j);
+  // Accessors & mutators
+  // Strided view of matrix index, read and written in place
+  S21BasicMatrixView<T> View(int index);
+  S21BasicMatrixView<const T> View(int index) const;
+  S21BasicMatrix<T> Get(int index) const;
+  void Set(int index, const S21BasicMatrixView<const T>& matrix);
+  int GetCount() const;
+  int GetRows() const;
+  int GetCols() const;
+  T* data();
+  const T* data() const;
+  std::pmr::memory_resource* GetResource() const;
+  // Exchanges buffers, shapes and resources
+  void Swap(S21BasicMatrixBatch& other) noexcept;
+
+  // Matrices per tile, as many as a 64-byte register holds elements
+  static constexpr int kLanes =
+      sizeof(T) >= 64 ? 1 : static_cast<int>(64 / sizeof(T));
+
+ private:
+  static constexpr std::size_t kAlignment = 64;
+
+  int count_;
+  int rows_;
+  int cols_;
+  int tiles_;
+  T* data_;
+  std::pmr::memory_resource* resource_;
+  // Additional
+  std::size_t Size() const;
+  // Elements of one tile, and where matrix index starts
+  std::ptrdiff_t TileSize() const;
+  std::ptrdiff_t Offset(int index) const;
+  T* MemoryAllocating();
+  void MemoryDeallocating();
+  bool EqSizeBatch(const S21BasicMatrixBatch& other) const;
+  void CheckIndex(int index) const;
+};
+
+extern template class S21BasicMatrixBatch<float>;
+extern template class S21BasicMatrixBatch<double>;
+extern template class S21BasicMatrixBatch<long double>;
+extern template class S21BasicMatrixBatch<std::complex<double>>;
+
+using S21MatrixBatch = S21BasicMatrixBatch<double>;
+
+#endif  // SRC_S21_MATRIX_BATCH_H_
@@ -0,0 +1,167 @@
+#ifndef SRC_S21_MATRIX_EXPR_H_
+#define SRC_S21_MATRIX_EXPR_H_
+
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Expression templates behind S21Matrix's elementwise operators. a + b,
+// a - b and a * number build lightweight nodes instead of matrices, and the
+// whole tree is evaluated in one fused pass when it is assigned to (or used
+// to construct) an S21Matrix. Nodes refer to their S21Matrix operands, so an
+// expression must be consumed before those operands are destroyed; do not
+// keep one in an `auto` variable. Both operands of a node share one element
+// type, which is also the type of the number an expression is scaled by.
+
+template <typename T>
+class S21BasicMatrix;
+
+// CRTP base shared by S21Matrix and every expression node. Coeff(i, j)
+// returns element (i, j) of the expression without bounds checks.
+template <typename E>
+class S21MatrixExpr {
+ public:
+  const E& Self() const { return static_cast<const E&>(*this); }
+  int GetRows() const { return Self().GetRows(); }
+  int GetCols() const { return Self().GetCols(); }
+  auto Coeff(int i, int j) const { return Self().Coeff(i, j); }
+};
+
+// Element type of an expression
+template <typename E>
+using S21MatrixExprValue =
+    std::decay_t<decltype(std::declval<const E&>().Coeff(0, 0))>;
+
+// Base of the expression nodes. The baseline operators returned matrices,
+// so a + b still answers what an S21Matrix would, evaluating itself first:
+// (a + b) == c, (a + b).Transpose(), (a * 2.0).Determinant() and so on.
+template <typename E>
+class S21MatrixExprNode : public S21MatrixExpr<E> {
+ public:
+  auto operator()(int i, int j) const {
+    if (this->GetRows() <= i || i < 0 || this->GetCols() <= j || j < 0) {
+      throw std::out_of_range("The index out of matrix limit");
+    }
+    return this->Coeff(i, j);
+  }
+  template <typename R>
+  bool EqMatrix(const S21MatrixExpr<R>& other) const {
+    return Evaluate().EqMatrix(other.Self());
+  }
+  template <typename R>
+  bool operator==(const S21MatrixExpr<R>& other) const {
+    return EqMatrix(other);
+  }
+  template <typename R>
+  auto operator*(const S21MatrixExpr<R>& other) const {
+    auto result = Evaluate();
+    result.MulMatrix(other.Self());
+    return result;
+  }
+  auto Transpose() const { return Evaluate().Transpose(); }
+  auto CalcComplements() const { return Evaluate().CalcComplements(); }
+  auto Determinant() const { return Evaluate().Determinant(); }
+  auto InverseMatrix() const { return Evaluate().InverseMatrix(); }
+
+ private:
+  auto Evaluate() const {
+    return S21BasicMatrix<S21MatrixExprValue<E>>(this->Self());
+  }
+};
+
+// Matrices are held by reference, intermediate nodes by value.
+template <typename E>
+struct S21MatrixExprOperand {
+  using type = const E;
+};
+
+template <typename T>
+struct S21MatrixExprOperand<S21BasicMatrix<T>> {
+  using type = const S21BasicMatrix<T>&;
+};
+
+struct S21MatrixPlusOp {
+  template <typename T>
+  static T Apply(T lhs, T rhs) {
+    return lhs + rhs;
+  }
+};
+
+struct S21MatrixMinusOp {
+  template <typename T>
+  static T Apply(T lhs, T rhs) {
+    return lhs - rhs;
+  }
+};
+
+template <typename L, typename R, typename Op>
+class S21MatrixBinaryExpr
+    : public S21MatrixExprNode<S21MatrixBinaryExpr<L, R, Op>> {
+  static_assert(std::is_same<S21MatrixExprValue<L>,
+                             S21MatrixExprValue<R>>::value,
+                "Operands of different element types");
+
+ public:
+  using Value = S21MatrixExprValue<L>;
+
+  S21MatrixBinaryExpr(const L& lhs, const R& rhs) : lhs_(lhs), rhs_(rhs) {
+    if (lhs.GetRows() != rhs.GetRows() || lhs.GetCols() != rhs.GetCols()) {
+      throw std::out_of_range("Different size of matrix");
+    }
+  }
+  int GetRows() const { return lhs_.GetRows(); }
+  int GetCols() const { return lhs_.GetCols(); }
+  Value Coeff(int i, int j) const {
+    return Op::Apply(lhs_.Coeff(i, j), rhs_.Coeff(i, j));
+  }
+  // See S21ExprAliases in s21_matrix_view.h
+  template <typename View>
+  bool Aliases(const View& dst) const {
+    return S21ExprAliases(lhs_, dst) || S21ExprAliases(rhs_, dst);
+  }
+
+ private:
+  typename S21MatrixExprOperand<L>::type lhs_;
+  typename S21MatrixExprOperand<R>::type rhs_;
+};
+
+template <typename E>
+class S21MatrixScaledExpr
+    : public S21MatrixExprNode<S21MatrixScaledExpr<E>> {
+ public:
+  using Value = S21MatrixExprValue<E>;
+
+  S21MatrixScaledExpr(const E& operand, Value number)
+      : operand_(operand), number_(number) {}
+  int GetRows() const { return operand_.GetRows(); }
+  int GetCols() const { return operand_.GetCols(); }
+  Value Coeff(int i, int j) const { return operand_.Coeff(i, j) * number_; }
+  template <typename View>
+  bool Aliases(const View& dst) const {
+    return S21ExprAliases(operand_, dst);
+  }
+
+ private:
+  typename S21MatrixExprOperand<E>::type operand_;
+  Value number_;
+};
+
+template <typename L, typename R>
+S21MatrixBinaryExpr<L, R, S21MatrixPlusOp> operator+(
+    const S21MatrixExpr<L>& lhs, const S21MatrixExpr<R>& rhs) {
+  return S21MatrixBinaryExpr<L, R, S21MatrixPlusOp>(lhs.Self(), rhs.Self());
+}
+
+template <typename L, typename R>
+S21MatrixBinaryExpr<L, R, S21MatrixMinusOp> operator-(
+    const S21MatrixExpr<L>& lhs, const S21MatrixExpr<R>& rhs) {
+  return S21MatrixBinaryExpr<L, R, S21MatrixMinusOp>(lhs.Self(), rhs.Self());
+}
+
+template <typename E>
+S21MatrixScaledExpr<E> operator*(const S21MatrixExpr<E>& operand,
+                                 S21MatrixExprValue<E> number) {
+  return S21MatrixScaledExpr<E>(operand.Self(), number);
+}
+
+#endif  // SRC_S21_MATRIX_EXPR_H_
@@ -0,0 +1,341 @@
+#include "s21_matrix_io.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_traits.h"
+
+namespace {
+
+template <typename U>
+U ByteSwapped(U value) {
+  unsigned char bytes[sizeof(U)];
+  std::memcpy(bytes, &value, sizeof(U));
+  std::reverse(bytes, bytes + sizeof(U));
+  std::memcpy(&value, bytes, sizeof(U));
+  return value;
+}
+
+// Reverses every unit bytes of data in place.
+void SwapBytes(void* data, std::size_t size, std::size_t unit) {
+  unsigned char* bytes = static_cast<unsigned char*>(data);
+  for (std::size_t i = 0; i + unit <= size; i += unit) {
+    std::reverse(bytes + i, bytes + i + unit);
+  }
+}
+
+std::uint64_t ChecksumOf(const void* data, std::size_t size) {
+  S21Checksum checksum;
+  checksum.Update(data, size);
+  return checksum.Final();
+}
+
+void CheckChecksum(const S21MatrixFileHeader& header, const void* data) {
+  if (ChecksumOf(data, header.data_bytes) != header.checksum) {
+    throw std::invalid_argument("The checksum of the file does not match");
+  }
+}
+
+bool ForeignByteOrder(const S21MatrixFileHeader& header) {
+  return header.byte_order != S21MatrixFileHeader::kByteOrder;
+}
+
+}  // namespace
+
+// The header is converted to the byte order of this machine (all but
+// byte_order, which keeps telling the order of the data) and checked to
+// describe data that fits in the file.
+S21MatrixFileHeader S21ReadMatrixHeader(const S21File& file) {
+  const std::invalid_argument not_a_matrix("The file isn't an S21Matrix file");
+  const std::uint64_t file_size = file.Size();
+  S21MatrixFileHeader header;
+  if (file_size < sizeof(header)) throw not_a_matrix;
+  file.ReadAt(&header, sizeof(header), 0);
+  if (std::memcmp(header.magic, S21MatrixFileHeader::kMagic, 4) != 0) {
+    throw not_a_matrix;
+  }
+  if (ForeignByteOrder(header)) {
+    if (ByteSwapped(header.byte_order) != S21MatrixFileHeader::kByteOrder) {
+      throw not_a_matrix;
+    }
+    header.version = ByteSwapped(header.version);
+    header.alignment = ByteSwapped(header.alignment);
+    header.rows = ByteSwapped(header.rows);
+    header.cols = ByteSwapped(header.cols);
+    header.data_offset = ByteSwapped(header.data_offset);
+    header.data_bytes = ByteSwapped(header.data_bytes);
+    header.checksum = ByteSwapped(header.checksum);
+  }
+  if (header.version == 0 || header.version > S21MatrixFileHeader::kVersion) {
+    throw std::invalid_argument("The version of the file isn't supported");
+  }
+  // Sizes are checked before they are multiplied or added, so a corrupted
+  // header cannot wrap them around into one that looks consistent.
+  constexpr std::uint64_t kMax = std::numeric_limits<std::uint64_t>::max();
+  if (header.rows < 0 || header.cols < 0 || header.element_size == 0 ||
+      header.data_offset < sizeof(header) || header.data_offset > file_size) {
+    throw not_a_matrix;
+  }
+  const auto rows = static_cast<std::uint64_t>(header.rows);
+  const auto cols = static_cast<std::uint64_t>(header.cols);
+  if (rows != 0 && cols > kMax / rows) throw not_a_matrix;
+  const std::uint64_t elements = rows * cols;
+  if (elements > kMax / header.element_size ||
+      header.data_bytes != elements * header.element_size ||
+      header.data_bytes > file_size - header.data_offset) {
+    throw not_a_matrix;
+  }
+  return header;
+}
+
+template <typename T>
+void S21CheckMatrixElements(const S21MatrixFileHeader& header) {
+  if (header.element_type != S21ElementTypeOf<T>::kValue ||
+      header.element_size != sizeof(T)) {
+    throw std::invalid_argument("The element type of the file does not match");
+  }
+  const std::int64_t limit = std::numeric_limits<int>::max();
+  if (header.rows > limit || header.cols > limit) {
+    throw std::out_of_range("Incorrect size of matrix");
+  }
+}
+
+S21MatrixFileHeader S21ReadMatrixHeader(const std::string& path) {
+  return S21ReadMatrixHeader(S21File(path, S21File::Mode::kRead));
+}
+
+// The data is written to a temporary file that replaces path only once it
+// is complete, so a process that has the old file mapped keeps seeing it
+// whole instead of faulting on a truncated mapping.
+template <typename T>
+void S21SaveMatrix(const S21BasicMatrixView<const T>& matrix,
+                   const std::string& path) {
+  const std::string temporary = path + ".tmp";
+  const S21File file(temporary, S21File::Mode::kCreate);
+  try {
+    S21MatrixFileHeader header =
+        S21MakeMatrixHeader<T>(matrix.GetRows(), matrix.GetCols());
+    const std::size_t row_bytes = sizeof(T) * matrix.GetCols();
+    S21Checksum checksum;
+    std::uint64_t offset = header.data_offset;
+    if (matrix.Empty()) {
+      // Nothing to write
+    } else if (matrix.ColStride() == 1 &&
+               matrix.RowStride() == matrix.GetCols()) {
+      checksum.Update(matrix.data(), header.data_bytes);
+      file.WriteAt(matrix.data(), header.data_bytes, offset);
+    } else {
+      std::vector<T> row(matrix.GetCols());
+      for (int i = 0; i < matrix.GetRows(); ++i) {
+        const T* source = matrix.data();
+        if (matrix.ColStride() == 1) {
+          source += static_cast<std::ptrdiff_t>(i) * matrix.RowStride();
+        } else {
+          for (int j = 0; j < matrix.GetCols(); ++j) {
+            row[j] = matrix.Coeff(i, j);
+          }
+          source = row.data();
+        }
+        checksum.Update(source, row_bytes);
+        file.WriteAt(source, row_bytes, offset);
+        offset += row_bytes;
+      }
+    }
+    header.checksum = checksum.Final();
+    file.WriteAt(&header, sizeof(header), 0);
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+      throw std::system_error(errno, std::generic_category(), path);
+    }
+  } catch (...) {
+    unlink(temporary.c_str());
+    throw;
+  }
+}
+
+template <typename T>
+S21BasicMatrix<T> S21LoadMatrix(const std::string& path, bool verify,
+                                std::pmr::memory_resource* resource) {
+  const S21File file(path, S21File::Mode::kRead);
+  const S21MatrixFileHeader header = S21ReadMatrixHeader(file);
+  S21CheckMatrixElements<T>(header);
+  S21BasicMatrix<T> matrix(static_cast<int>(header.rows),
+                           static_cast<int>(header.cols), resource);
+  if (header.data_bytes > 0) {
+    // A fresh matrix is packed, so the data lands in one read.
+    file.ReadAt(matrix.data(), header.data_bytes, header.data_offset);
+    if (verify) CheckChecksum(header, matrix.data());
+    if (ForeignByteOrder(header)) {
+      SwapBytes(matrix.data(), header.data_bytes,
+                sizeof(typename S21MatrixTraits<T>::Real));
+    }
+  }
+  return matrix;
+}
+
+// S21BasicMappedMatrix
+
+template <typename T>
+S21BasicMappedMatrix<T>::S21BasicMappedMatrix(const std::string& path,
+                                              S21MapMode mode, bool verify)
+    : rows_(0),
+      cols_(0),
+      mode_(mode),
+      mapping_(nullptr),
+      mapped_bytes_(0),
+      data_(nullptr) {
+  const S21File file(path, S21File::Mode::kRead);
+  const S21MatrixFileHeader header = S21ReadMatrixHeader(file);
+  S21CheckMatrixElements<T>(header);
+  if (ForeignByteOrder(header)) {
+    throw std::invalid_argument("The byte order of the file does not match");
+  }
+  if (header.data_offset % alignof(T) != 0) {
+    throw std::invalid_argument("The data of the file is misaligned");
+  }
+  mapped_bytes_ = header.data_offset + header.data_bytes;
+  const int protection =
+      mode == S21MapMode::kReadOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+  const int flags = mode == S21MapMode::kReadOnly ? MAP_SHARED : MAP_PRIVATE;
+  void* mapping = mmap(nullptr, mapped_bytes_, protection, flags, file.Get(),
+                       0);
+  if (mapping == MAP_FAILED) {
+    throw std::system_error(errno, std::generic_category(), path);
+  }
+  mapping_ = mapping;
+  data_ = reinterpret_cast<T*>(static_cast<char*>(mapping_) +
+                               header.data_offset);
+  rows_ = static_cast<int>(header.rows);
+  cols_ = static_cast<int>(header.cols);
+  if (verify) {
+    try {
+      CheckChecksum(header, data_);
+    } catch (...) {
+      Unmap();
+      throw;
+    }
+  }
+}
+
+template <typename T>
+S21BasicMappedMatrix<T>::S21BasicMappedMatrix(
+    S21BasicMappedMatrix&& other) noexcept
+    : rows_(std::exchange(other.rows_, 0)),
+      cols_(std::exchange(other.cols_, 0)),
+      mode_(other.mode_),
+      mapping_(std::exchange(other.mapping_, nullptr)),
+      mapped_bytes_(std::exchange(other.mapped_bytes_, 0)),
+      data_(std::exchange(other.data_, nullptr)) {}
+
+template <typename T>
+S21BasicMappedMatrix<T>::~S21BasicMappedMatrix() {
+  Unmap();
+}
+
+// Overloadings opertators
+
+template <typename T>
+S21BasicMappedMatrix<T>& S21BasicMappedMatrix<T>::operator=(
+    S21BasicMappedMatrix&& other) noexcept {
+  if (this != &other) {
+    Unmap();
+    rows_ = std::exchange(other.rows_, 0);
+    cols_ = std::exchange(other.cols_, 0);
+    mode_ = other.mode_;
+    mapping_ = std::exchange(other.mapping_, nullptr);
+    mapped_bytes_ = std::exchange(other.mapped_bytes_, 0);
+    data_ = std::exchange(other.data_, nullptr);
+  }
+  return *this;
+}
+
+template <typename T>
+T S21BasicMappedMatrix<T>::operator()(int i, int j) const {
+  if (rows_ <= i || i < 0 || cols_ <= j || j < 0) {
+    throw std::out_of_range("The index out of matrix limit");
+  }
+  return data_[static_cast<std::ptrdiff_t>(i) * cols_ + j];
+}
+
+// Accessors
+
+template <typename T>
+S21BasicMatrixView<const T> S21BasicMappedMatrix<T>::View() const {
+  return S21BasicMatrixView<const T>(data_, rows_, cols_, cols_);
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMappedMatrix<T>::WritableView() {
+  if (mode_ == S21MapMode::kReadOnly) {
+    throw std::invalid_argument("The mapped matrix is read-only");
+  }
+  return S21BasicMatrixView<T>(data_, rows_, cols_, cols_);
+}
+
+template <typename T>
+const T* S21BasicMappedMatrix<T>::data() const {
+  return data_;
+}
+
+template <typename T>
+int S21BasicMappedMatrix<T>::GetRows() const {
+  return rows_;
+}
+
+template <typename T>
+int S21BasicMappedMatrix<T>::GetCols() const {
+  return cols_;
+}
+
+template <typename T>
+S21MapMode S21BasicMappedMatrix<T>::GetMode() const {
+  return mode_;
+}
+
+// Additional
+
+template <typename T>
+void S21BasicMappedMatrix<T>::Unmap() {
+  if (mapping_) {
+    munmap(mapping_, mapped_bytes_);
+    mapping_ = nullptr;
+    data_ = nullptr;
+  }
+}
+
+template void S21CheckMatrixElements<float>(const S21MatrixFileHeader&);
+template void S21CheckMatrixElements<double>(const S21MatrixFileHeader&);
+template void S21CheckMatrixElements<long double>(
+    const S21MatrixFileHeader&);
+template void S21CheckMatrixElements<std::complex<double>>(
+    const S21MatrixFileHeader&);
+template void S21SaveMatrix(const S21BasicMatrixView<const float>&,
+                            const std::string&);
+template void S21SaveMatrix(const S21BasicMatrixView<const double>&,
+                            const std::string&);
+template void S21SaveMatrix(const S21BasicMatrixView<const long double>&,
+                            const std::string&);
+template void S21SaveMatrix(
+    const S21BasicMatrixView<const std::complex<double>>&,
+    const std::string&);
+template S21BasicMatrix<float> S21LoadMatrix(const std::string&, bool,
+                                             std::pmr::memory_resource*);
+template S21BasicMatrix<double> S21LoadMatrix(const std::string&, bool,
+                                              std::pmr::memory_resource*);
+template S21BasicMatrix<long double> S21LoadMatrix(
+    const std::string&, bool, std::pmr::memory_resource*);
+template S21BasicMatrix<std::complex<double>> S21LoadMatrix(
+    const std::string&, bool, std::pmr::memory_resource*);
+template class S21BasicMappedMatrix<float>;
+template class S21BasicMappedMatrix<double>;
+template class S21BasicMappedMatrix<long double>;
+template class S21BasicMappedMatrix<std::complex<double>>;
@@ -0,0 +1,210 @@
+#ifndef SRC_S21_MATRIX_IO_H_
+#define SRC_S21_MATRIX_IO_H_
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+
+#include "s21_file.h"
+#include "s21_matrix_oop.h"
+#include "s21_matrix_view.h"
+
+// Binary matrix files. A file is a 64-byte header followed, at
+// data_offset, by the elements row after row with no padding, in the byte
+// order of the machine that saved it. Loading is a single read into the
+// matrix buffer and mapping involves no read at all, so neither parses
+// anything element by element.
+enum class S21ElementType : std::uint8_t {
+  kFloat = 1,
+  kDouble = 2,
+  kLongDouble = 3,
+  kComplexDouble = 4
+};
+
+struct S21MatrixFileHeader {
+  static constexpr char kMagic[4] = {'S', '2', '1', 'M'};
+  static constexpr std::uint16_t kVersion = 1;
+  // Written as this value by the saving machine; a reader of the other byte
+  // order sees 0x04030201.
+  static constexpr std::uint32_t kByteOrder = 0x01020304;
+  // Offset of the elements, a multiple of the cache line so that mapped
+  // data is aligned like an S21BasicMatrix buffer.
+  static constexpr std::uint32_t kAlignment = 64;
+
+  char magic[4];
+  std::uint32_t byte_order;
+  std::uint16_t version;
+  S21ElementType element_type;
+  std::uint8_t element_size;
+  std::uint32_t alignment;
+  std::int64_t rows;
+  std::int64_t cols;
+  std::uint64_t data_offset;
+  std::uint64_t data_bytes;
+  // FNV-1a over the data as 64-bit little-endian words, the last one padded
+  // with zero bytes
+  std::uint64_t checksum;
+  std::uint64_t reserved;
+};
+
+static_assert(sizeof(S21MatrixFileHeader) == 64,
+              "S21MatrixFileHeader must stay 64 bytes");
+
+template <typename T>
+struct S21ElementTypeOf;
+template <>
+struct S21ElementTypeOf<float> {
+  static constexpr S21ElementType kValue = S21ElementType::kFloat;
+};
+template <>
+struct S21ElementTypeOf<double> {
+  static constexpr S21ElementType kValue = S21ElementType::kDouble;
+};
+template <>
+struct S21ElementTypeOf<long double> {
+  static constexpr S21ElementType kValue = S21ElementType::kLongDouble;
+};
+template <>
+struct S21ElementTypeOf<std::complex<double>> {
+  static constexpr S21ElementType kValue = S21ElementType::kComplexDouble;
+};
+
+// Reads and checks the header of a matrix file. The fields come back in the
+// byte order of this machine, except byte_order, which differs from
+// kByteOrder when the data is in the other order. Files that cannot be
+// opened or read throw std::system_error, files that are not matrix files
+// of a known version std::invalid_argument.
+S21MatrixFileHeader S21ReadMatrixHeader(const std::string& path);
+
+// Header of a rows x cols matrix of T saved on this machine, with the data
+// right after it and a zero checksum.
+template <typename T>
+S21MatrixFileHeader S21MakeMatrixHeader(std::int64_t rows, std::int64_t cols) {
+  S21MatrixFileHeader header{};
+  for (int i = 0; i < 4; ++i) header.magic[i] = S21MatrixFileHeader::kMagic[i];
+  header.byte_order = S21MatrixFileHeader::kByteOrder;
+  header.version = S21MatrixFileHeader::kVersion;
+  header.element_type = S21ElementTypeOf<T>::kValue;
+  header.element_size = sizeof(T);
+  header.alignment = S21MatrixFileHeader::kAlignment;
+  header.rows = rows;
+  header.cols = cols;
+  header.data_offset = S21MatrixFileHeader::kAlignment;
+  header.data_bytes = static_cast<std::uint64_t>(rows) *
+                      static_cast<std::uint64_t>(cols) * sizeof(T);
+  return header;
+}
+
+// S21ReadMatrixHeader of a file that is already open.
+S21MatrixFileHeader S21ReadMatrixHeader(const S21File& file);
+
+// Throws std::invalid_argument unless the file holds elements of T, and
+// std::out_of_range if its shape does not fit the int indices of
+// S21BasicMatrix.
+template <typename T>
+void S21CheckMatrixElements(const S21MatrixFileHeader& header);
+
+// Writes matrix to path, replacing the file.
+template <typename T>
+void S21SaveMatrix(const S21BasicMatrixView<const T>& matrix,
+                   const std::string& path);
+template <typename T>
+void S21SaveMatrix(const S21BasicMatrixView<T>& matrix,
+                   const std::string& path) {
+  S21SaveMatrix(S21BasicMatrixView<const T>(matrix), path);
+}
+template <typename T>
+void S21SaveMatrix(const S21BasicMatrix<T>& matrix, const std::string& path) {
+  S21SaveMatrix(matrix.View(), path);
+}
+
+// Reads a matrix saved with the same element type. Data of the other byte
+// order is swapped after reading; verify recomputes the checksum, which
+// costs a pass over the data.
+template <typename T = double>
+S21BasicMatrix<T> S21LoadMatrix(
+    const std::string& path, bool verify = true,
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+// How S21BasicMappedMatrix maps its file. A copy-on-write mapping can be
+// written through WritableView(), but the changes stay private to the
+// process and never reach the file.
+enum class S21MapMode { kReadOnly, kCopyOnWrite };
+
+// A matrix file mapped into memory. Pages are read by the kernel the first
+// time they are touched, so opening a file of any size is immediate, and
+// pages of a read-only mapping are shared by every process mapping the
+// file. The file must have the element type T and the byte order of this
+// machine. Views of the mapping work with everything that takes an
+// S21BasicMatrixView: copying into an S21BasicMatrix, Gemm, SumMatrix,
+// EqMatrix and so on.
+template <typename T>
+class S21BasicMappedMatrix {
+ public:
+  // Constructors
+  // verify reads every page once to check the checksum
+  explicit S21BasicMappedMatrix(const std::string& path,
+                                S21MapMode mode = S21MapMode::kReadOnly,
+                                bool verify = false);
+  S21BasicMappedMatrix(const S21BasicMappedMatrix&) = delete;
+  S21BasicMappedMatrix(S21BasicMappedMatrix&& other) noexcept;
+  ~S21BasicMappedMatrix();
+  // Overloadings opertators
+  S21BasicMappedMatrix& operator=(const S21BasicMappedMatrix&) = delete;
+  S21BasicMappedMatrix& operator=(S21BasicMappedMatrix&& other) noexcept;
+  T operator()(int i, int j) const;
+  // Accessors
+  S21BasicMatrixView<const T> View() const;
+  // Throws std::invalid_argument for a read-only mapping
+  S21BasicMatrixView<T> WritableView();
+  const T* data() const;
+  int GetRows() const;
+  int GetCols() const;
+  S21MapMode GetMode() const;
+
+ private:
+  int rows_;
+  int cols_;
+  S21MapMode mode_;
+  void* mapping_;
+  std::size_t mapped_bytes_;
+  T* data_;
+  // Additional
+  void Unmap();
+};
+
+extern template void S21CheckMatrixElements<float>(
+    const S21MatrixFileHeader&);
+extern template void S21CheckMatrixElements<double>(
+    const S21MatrixFileHeader&);
+extern template void S21CheckMatrixElements<long double>(
+    const S21MatrixFileHeader&);
+extern template void S21CheckMatrixElements<std::complex<double>>(
+    const S21MatrixFileHeader&);
+extern template void S21SaveMatrix(const S21BasicMatrixView<const float>&,
+                                   const std::string&);
+extern template void S21SaveMatrix(const S21BasicMatrixView<const double>&,
+                                   const std::string&);
+extern template void S21SaveMatrix(
+    const S21BasicMatrixView<const long double>&, const std::string&);
+extern template void S21SaveMatrix(
+    const S21BasicMatrixView<const std::complex<double>>&,
+    const std::string&);
+extern template S21BasicMatrix<float> S21LoadMatrix(
+    const std::string&, bool, std::pmr::memory_resource*);
+extern template S21BasicMatrix<double> S21LoadMatrix(
+    const std::string&, bool, std::pmr::memory_resource*);
+extern template S21BasicMatrix<long double> S21LoadMatrix(
+    const std::string&, bool, std::pmr::memory_resource*);
+extern template S21BasicMatrix<std::complex<double>> S21LoadMatrix(
+    const std::string&, bool, std::pmr::memory_resource*);
+extern template class S21BasicMappedMatrix<float>;
+extern template class S21BasicMappedMatrix<double>;
+extern template class S21BasicMappedMatrix<long double>;
+extern template class S21BasicMappedMatrix<std::complex<double>>;
+
+using S21MappedMatrix = S21BasicMappedMatrix<double>;
+
+#endif  // SRC_S21_MATRIX_IO_H_
@@ -0,0 +1,230 @@
+#ifndef SRC_S21_MATRIX_ITERATOR_H_
+#define SRC_S21_MATRIX_ITERATOR_H_
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+// Random-access iterators over the elements of a strided matrix; T is
+// const-qualified for read-only iteration. Rows are contiguous, so a row
+// iterator is a plain pointer and std::copy of a row is a memmove.
+
+// Elements a fixed stride apart, such as one column of a matrix.
+template <typename T>
+class S21StrideIterator {
+ public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = std::remove_const_t<T>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = T*;
+  using reference = T&;
+
+  S21StrideIterator() : element_(nullptr), stride_(0) {}
+  S21StrideIterator(T* element, std::ptrdiff_t stride)
+      : element_(element), stride_(stride) {}
+  // A mutable iterator converts to a read-only one.
+  template <typename U, typename = std::enable_if_t<
+                            std::is_same<const U, T>::value &&
+                            !std::is_same<U, T>::value>>
+  S21StrideIterator(const S21StrideIterator<U>& other)
+      : element_(other.base()), stride_(other.stride()) {}
+
+  T* base() const { return element_; }
+  std::ptrdiff_t stride() const { return stride_; }
+
+  T& operator*() const { return *element_; }
+  T* operator->() const { return element_; }
+  T& operator[](difference_type n) const { return element_[n * stride_]; }
+  S21StrideIterator& operator++() {
+    element_ += stride_;
+    return *this;
+  }
+  S21StrideIterator operator++(int) {
+    S21StrideIterator old = *this;
+    ++*this;
+    return old;
+  }
+  S21StrideIterator& operator--() {
+    element_ -= stride_;
+    return *this;
+  }
+  S21StrideIterator operator--(int) {
+    S21StrideIterator old = *this;
+    --*this;
+    return old;
+  }
+  S21StrideIterator& operator+=(difference_type n) {
+    element_ += n * stride_;
+    return *this;
+  }
+  S21StrideIterator& operator-=(difference_type n) {
+    element_ -= n * stride_;
+    return *this;
+  }
+  friend S21StrideIterator operator+(S21StrideIterator it, difference_type n) {
+    return it += n;
+  }
+  friend S21StrideIterator operator+(difference_type n, S21StrideIterator it) {
+    return it += n;
+  }
+  friend S21StrideIterator operator-(S21StrideIterator it, difference_type n) {
+    return it -= n;
+  }
+  friend difference_type operator-(const S21StrideIterator& lhs,
+                                   const S21StrideIterator& rhs) {
+    return lhs.stride_ ? (lhs.element_ - rhs.element_) / lhs.stride_ : 0;
+  }
+  friend bool operator==(const S21StrideIterator& lhs,
+                         const S21StrideIterator& rhs) {
+    return lhs.element_ == rhs.element_;
+  }
+  friend bool operator!=(const S21StrideIterator& lhs,
+                         const S21StrideIterator& rhs) {
+    return lhs.element_ != rhs.element_;
+  }
+  friend bool operator<(const S21StrideIterator& lhs,
+                        const S21StrideIterator& rhs) {
+    return rhs - lhs > 0;
+  }
+  friend bool operator>(const S21StrideIterator& lhs,
+                        const S21StrideIterator& rhs) {
+    return rhs < lhs;
+  }
+  friend bool operator<=(const S21StrideIterator& lhs,
+                         const S21StrideIterator& rhs) {
+    return !(rhs < lhs);
+  }
+  friend bool operator>=(const S21StrideIterator& lhs,
+                         const S21StrideIterator& rhs) {
+    return !(lhs < rhs);
+  }
+
+ private:
+  T* element_;
+  std::ptrdiff_t stride_;
+};
+
+// All elements in row-major order, stepping over the padding between rows.
+// The iterator keeps the column it is at, so ++ costs one compare and
+// jumps or indexing by n one division by the number of columns.
+template <typename T>
+class S21FlatIterator {
+ public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = std::remove_const_t<T>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = T*;
+  using reference = T&;
+
+  S21FlatIterator() : element_(nullptr), col_(0), cols_(0), stride_(0) {}
+  // element is column col of a row of a matrix with cols columns
+  S21FlatIterator(T* element, int col, int cols, std::ptrdiff_t stride)
+      : element_(element), col_(col), cols_(cols), stride_(stride) {}
+  template <typename U, typename = std::enable_if_t<
+                            std::is_same<const U, T>::value &&
+                            !std::is_same<U, T>::value>>
+  S21FlatIterator(const S21FlatIterator<U>& other)
+      : element_(other.base()),
+        col_(other.col()),
+        cols_(other.cols()),
+        stride_(other.stride()) {}
+
+  T* base() const { return element_; }
+  int col() const { return col_; }
+  int cols() const { return cols_; }
+  std::ptrdiff_t stride() const { return stride_; }
+
+  T& operator*() const { return *element_; }
+  T* operator->() const { return element_; }
+  T& operator[](difference_type n) const { return *(*this + n); }
+  S21FlatIterator& operator++() {
+    ++element_;
+    if (++col_ == cols_) {
+      element_ += stride_ - cols_;
+      col_ = 0;
+    }
+    return *this;
+  }
+  S21FlatIterator operator++(int) {
+    S21FlatIterator old = *this;
+    ++*this;
+    return old;
+  }
+  S21FlatIterator& operator--() {
+    if (col_ == 0) {
+      element_ -= stride_ - cols_;
+      col_ = cols_;
+    }
+    --element_;
+    --col_;
+    return *this;
+  }
+  S21FlatIterator operator--(int) {
+    S21FlatIterator old = *this;
+    --*this;
+    return old;
+  }
+  S21FlatIterator& operator+=(difference_type n) {
+    if (n != 0) {
+      const difference_type flat = col_ + n;
+      difference_type rows = flat / cols_;
+      difference_type col = flat % cols_;
+      if (col < 0) {
+        col += cols_;
+        --rows;
+      }
+      element_ += rows * stride_ + (col - col_);
+      col_ = static_cast<int>(col);
+    }
+    return *this;
+  }
+  S21FlatIterator& operator-=(difference_type n) { return *this += -n; }
+  friend S21FlatIterator operator+(S21FlatIterator it, difference_type n) {
+    return it += n;
+  }
+  friend S21FlatIterator operator+(difference_type n, S21FlatIterator it) {
+    return it += n;
+  }
+  friend S21FlatIterator operator-(S21FlatIterator it, difference_type n) {
+    return it -= n;
+  }
+  friend difference_type operator-(const S21FlatIterator& lhs,
+                                   const S21FlatIterator& rhs) {
+    if (lhs.stride_ == 0) return 0;
+    const difference_type rows =
+        ((lhs.element_ - lhs.col_) - (rhs.element_ - rhs.col_)) / lhs.stride_;
+    return rows * lhs.cols_ + (lhs.col_ - rhs.col_);
+  }
+  friend bool operator==(const S21FlatIterator& lhs,
+                         const S21FlatIterator& rhs) {
+    return lhs.element_ == rhs.element_;
+  }
+  friend bool operator!=(const S21FlatIterator& lhs,
+                         const S21FlatIterator& rhs) {
+    return lhs.element_ != rhs.element_;
+  }
+  friend bool operator<(const S21FlatIterator& lhs,
+                        const S21FlatIterator& rhs) {
+    return lhs.element_ < rhs.element_;
+  }
+  friend bool operator>(const S21FlatIterator& lhs,
+                        const S21FlatIterator& rhs) {
+    return rhs < lhs;
+  }
+  friend bool operator<=(const S21FlatIterator& lhs,
+                         const S21FlatIterator& rhs) {
+    return !(rhs < lhs);
+  }
+  friend bool operator>=(const S21FlatIterator& lhs,
+                         const S21FlatIterator& rhs) {
+    return !(lhs < rhs);
+  }
+
+ private:
+  T* element_;
+  int col_;
+  int cols_;
+  std::ptrdiff_t stride_;
+};
+
+#endif  // SRC_S21_MATRIX_ITERATOR_H_
@@ -1,98 +1,167 @@
 #include "s21_matrix_oop.h"
 
-// Constructors
+#include <complex>
+#include <memory>
+
+#include "s21_cholesky.h"
+#include "s21_gemm.h"
+#include "s21_lu.h"
+#include "s21_qr.h"
+#include "s21_simd.h"
+#include "s21_stats.h"
+#include "s21_strassen.h"
+#include "s21_thread_pool.h"
+#include "s21_transpose.h"
 
-S21Matrix::S21Matrix() : rows_(0), cols_(0), matrix_(0) {}
+// Constructors
 
-S21Matrix::S21Matrix(int rows, int cols) {
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix()
+    : S21BasicMatrix(std::pmr::get_default_resource()) {}
+
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(std::pmr::memory_resource* resource)
+    : rows_(0),
+      cols_(0),
+      stride_(0),
+      matrix_(nullptr),
+      resource_(resource),
+      version_(0),
+      capacity_(0) {}
+
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(int rows, int cols,
+                                  std::pmr::memory_resource* resource)
+    : S21BasicMatrix(resource) {
   if (rows > 0 && cols > 0) {
     rows_ = rows;
     cols_ = cols;
-    matrix_ = MemoryAllocating(rows_, cols_);
+    stride_ = cols;
+    matrix_ = MemoryAllocating(rows_, stride_);
+    capacity_ = static_cast<std::size_t>(rows_) * stride_;
   }
 }
 
-S21Matrix::S21Matrix(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrix& other)
+    : S21BasicMatrix(other, std::pmr::get_default_resource()) {}
+
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrix& other,
+                                  std::pmr::memory_resource* resource)
+    : S21BasicMatrix(resource) {
   if (other.ExistMatrix()) {
     this->rows_ = other.rows_;
     this->cols_ = other.cols_;
-    this->matrix_ = MemoryAllocating(other.rows_, other.cols_);
+    this->stride_ = other.cols_;
+    this->matrix_ = MemoryAllocating(rows_, stride_);
+    this->capacity_ = static_cast<std::size_t>(rows_) * stride_;
     CopyMatrix(other);
   }
 }
 
-S21Matrix::S21Matrix(S21Matrix&& other) { MoveMatrix(other); }
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrixView<const T>& view,
+                                  std::pmr::memory_resource* resource)
+    : S21BasicMatrix(view.GetRows(), view.GetCols(), resource) {
+  if (this->ExistMatrix()) {
+    View().Assign(view);
+  }
+}
+
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(S21BasicMatrix&& other) noexcept
+    : rows_(0),
+      cols_(0),
+      stride_(0),
+      matrix_(nullptr),
+      resource_(other.resource_),
+      version_(0),
+      capacity_(0) {
+  MoveMatrix(other);
+}
 
-S21Matrix::~S21Matrix() { MemoryDeallocating(); }
+template <typename T>
+S21BasicMatrix<T>::~S21BasicMatrix() { MemoryDeallocating(); }
 
 // Operations
 
-bool S21Matrix::EqMatrix(const S21Matrix& other) {
-  bool status_of_equality = false;
-  if (other.ExistMatrix() && this->ExistMatrix() && this->EqSizeMatrix(other)) {
-    status_of_equality = true;
-    for (int i = 0; i < rows_ && status_of_equality; ++i) {
-      for (int j = 0; j < cols_ && status_of_equality; ++j) {
-        if (fabs(this->matrix_[i][j] - other.matrix_[i][j]) > 1e-07) {
-          status_of_equality = false;
-        }
-      }
-    }
-  }
-  return status_of_equality;
+template <typename T>
+bool S21BasicMatrix<T>::EqMatrix(const S21BasicMatrix& other) const {
+  return EqMatrix(other.View());
 }
 
-void S21Matrix::SumMatrix(const S21Matrix& other) {
-  if (this->EqSizeMatrix(other)) {
-    if (other.ExistMatrix() && this->ExistMatrix()) {
-      for (int i = 0; i < rows_; ++i) {
-        for (int j = 0; j < cols_; ++j) {
-          matrix_[i][j] = matrix_[i][j] + other.matrix_[i][j];
-        }
-      }
+template <typename T>
+bool S21BasicMatrix<T>::EqMatrix(
+    const S21BasicMatrixView<const T>& other) const {
+  S21_STATS_SCOPE(S21Operation::kEqMatrix, rows_, cols_, 0,
+                  static_cast<double>(rows_) * cols_);
+  return View().EqMatrix(other);
+}
+
+template <typename T>
+void S21BasicMatrix<T>::SumMatrix(const S21BasicMatrix& other) {
+  SumMatrix(other.View());
+}
+
+template <typename T>
+void S21BasicMatrix<T>::SumMatrix(const S21BasicMatrixView<const T>& other) {
+  S21_STATS_SCOPE(S21Operation::kSumMatrix, rows_, cols_, 0,
+                  static_cast<double>(rows_) * cols_);
+  if (rows_ == other.GetRows() && cols_ == other.GetCols()) {
+    ++version_;
+    if (!other.Empty() && this->ExistMatrix()) {
+      View().SumMatrix(other);
     }
   } else {
     throw std::out_of_range("Different size of matrix");
   }
 }
 
-void S21Matrix::SubMatrix(const S21Matrix& other) {
-  if (this->EqSizeMatrix(other)) {
-    if (other.ExistMatrix() && this->ExistMatrix()) {
-      for (int i = 0; i < rows_; ++i) {
-        for (int j = 0; j < cols_; ++j) {
-          matrix_[i][j] = matrix_[i][j] - other.matrix_[i][j];
-        }
-      }
+template <typename T>
+void S21BasicMatrix<T>::SubMatrix(const S21BasicMatrix& other) {
+  SubMatrix(other.View());
+}
+
+template <typename T>
+void S21BasicMatrix<T>::SubMatrix(const S21BasicMatrixView<const T>& other) {
+  S21_STATS_SCOPE(S21Operation::kSubMatrix, rows_, cols_, 0,
+                  static_cast<double>(rows_) * cols_);
+  if (rows_ == other.GetRows() && cols_ == other.GetCols()) {
+    ++version_;
+    if (!other.Empty() && this->ExistMatrix()) {
+      View().SubMatrix(other);
     }
   } else {
     throw std::out_of_range("Different size of matrix");
   }
 }
 
-void S21Matrix::MulNumber(double number) {
+template <typename T>
+void S21BasicMatrix<T>::MulNumber(T number) {
+  S21_STATS_SCOPE(S21Operation::kMulNumber, rows_, cols_, 0,
+                  static_cast<double>(rows_) * cols_);
+  ++version_;
   if (this->ExistMatrix()) {
-    for (int i = 0; i < rows_; ++i) {
-      for (int j = 0; j < cols_; ++j) {
-        matrix_[i][j] = matrix_[i][j] * number;
-      }
-    }
+    View().MulNumber(number);
   }
 }
 
-void S21Matrix::MulMatrix(const S21Matrix& other) {
-  S21Matrix multiplied_matrix(rows_, other.cols_);
-  if (cols_ == other.rows_) {
-    if (other.ExistMatrix() && this->ExistMatrix()) {
-      for (int i = 0; i < this->rows_; ++i) {
-        for (int j = 0; j < other.cols_; ++j) {
-          for (int k = 0; k < this->cols_; ++k) {
-            multiplied_matrix.matrix_[i][j] +=
-                matrix_[i][k] * other.matrix_[k][j];
-          }
-        }
-      }
-      *this = multiplied_matrix;
+template <typename T>
+void S21BasicMatrix<T>::MulMatrix(const S21BasicMatrix& other) {
+  MulMatrix(other.View());
+}
+
+template <typename T>
+void S21BasicMatrix<T>::MulMatrix(const S21BasicMatrixView<const T>& other) {
+  S21_STATS_SCOPE(S21Operation::kMulMatrix, rows_, other.GetCols(), cols_,
+                  2.0 * rows_ * cols_ * other.GetCols());
+  if (cols_ == other.GetRows()) {
+    if (!other.Empty() && this->ExistMatrix()) {
+      S21BasicMatrix multiplied_matrix(rows_, other.GetCols(), resource_);
+      MulInto(*this, other, multiplied_matrix);
+      MemoryDeallocating();
+      MoveMatrix(multiplied_matrix);
     }
   } else {
     throw std::out_of_range(
@@ -101,55 +170,155 @@ void S21Matrix::MulMatrix(const S21Matrix& other) {
   }
 }
 
-S21Matrix S21Matrix::Transpose() {
-  S21Matrix result(cols_, rows_);
+template <typename T>
+void S21BasicMatrix<T>::Gemm(T alpha, const S21BasicMatrixView<const T>& a,
+                             const S21BasicMatrixView<const T>& b, T beta,
+                             const S21BasicMatrixView<T>& c) {
+  S21_STATS_SCOPE(S21Operation::kGemm, a.GetRows(), b.GetCols(), a.GetCols(),
+                  2.0 * a.GetRows() * a.GetCols() * b.GetCols());
+  if (a.GetCols() != b.GetRows()) {
+    throw std::out_of_range(
+        "The number of columns of the first matrix does not equal the number "
+        "of rows of the second matrix");
+  }
+  if (c.GetRows() != a.GetRows() || c.GetCols() != b.GetCols()) {
+    throw std::out_of_range("Different size of matrix");
+  }
+  if (c.Empty()) return;
+  // The kernel wants unit column strides and a C that overlaps neither
+  // operand; anything else goes through packed copies.
+  if (!a.Empty() && a.ColStride() != 1) {
+    Gemm(alpha, S21BasicMatrix(a), b, beta, c);
+  } else if (!b.Empty() && b.ColStride() != 1) {
+    Gemm(alpha, a, S21BasicMatrix(b), beta, c);
+  } else if (c.ColStride() != 1 || S21Overlaps<T>(c, a) ||
+             S21Overlaps<T>(c, b)) {
+    S21BasicMatrix product(c);
+    Gemm(alpha, a, b, beta, product);
+    c.Assign(product);
+  } else {
+    S21Gemm(a.GetRows(), b.GetCols(), a.GetCols(), alpha, a.data(),
+            a.RowStride(), b.data(), b.RowStride(), beta, c.data(),
+            c.RowStride());
+  }
+}
+
+template <typename T>
+void S21BasicMatrix<T>::MulInto(const S21BasicMatrixView<const T>& a,
+                                const S21BasicMatrixView<const T>& b,
+                                S21BasicMatrix& product) {
+  // S21Strassen trusts the shapes it is given
+  if (a.GetCols() != b.GetRows()) {
+    throw std::out_of_range("Incorrect size of matrix");
+  }
+  const int m = a.GetRows();
+  const int n = b.GetCols();
+  const int k = a.GetCols();
+  if (S21GetMulAlgorithm() != S21MulAlgorithm::kStrassen ||
+      !S21StrassenApplies(m, n, k) || a.ColStride() != 1 ||
+      b.ColStride() != 1) {
+    Gemm(T(1), a, b, T(0), product);
+    return;
+  }
+  // Taken from the resource of the product like any other temporary and
+  // released after the call; a pool or an arena serves repeated products
+  // without going upstream
+  std::pmr::memory_resource* resource = product.resource_;
+  const std::size_t bytes = S21StrassenWorkspace<T>(m, n, k) * sizeof(T);
+  auto release = [resource, bytes](T* work) {
+    resource->deallocate(work, bytes, kAlignment);
+  };
+  std::unique_ptr<T, decltype(release)> work(
+      static_cast<T*>(resource->allocate(bytes, kAlignment)), release);
+  S21_STATS_ALLOCATION(bytes);
+  S21Strassen(m, n, k, a.data(), a.RowStride(), b.data(), b.RowStride(),
+              product.matrix_, product.stride_, work.get());
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Transpose() const {
+  S21_STATS_SCOPE(S21Operation::kTranspose, rows_, cols_, 0, 0);
+  S21BasicMatrix result(cols_, rows_, resource_);
   if (this->ExistMatrix()) {
-    for (int i = 0; i < rows_; ++i) {
-      for (int j = 0; j < cols_; ++j) {
-        result.matrix_[j][i] = matrix_[i][j];
-      }
-    }
+    S21Transpose(rows_, cols_, matrix_, stride_, result.matrix_,
+                 result.stride_);
   }
   return result;
 }
 
-S21Matrix S21Matrix::CalcComplements() {
-  S21Matrix result(rows_, cols_);
-  S21Matrix HelpMatrix(rows_ - 1, cols_ - 1);
-  double temp_result = 0;
-  if (this->rows_ == this->cols_) {
-    if (this->ExistMatrix()) {
-      for (int i = 0; i < rows_; ++i) {
-        for (int j = 0; j < cols_; ++j) {
-          HelpMatrix.ShortCopy(*this, i, j);
-          temp_result = HelpMatrix.Determinant();
-          result.matrix_[i][j] += pow(-1, i + j) * temp_result;
-        }
-      }
+template <typename T>
+void S21BasicMatrix<T>::TransposeInPlace() {
+  S21_STATS_SCOPE(S21Operation::kTranspose, rows_, cols_, 0, 0);
+  ++version_;
+  if (this->ExistMatrix()) {
+    if (rows_ == cols_) {
+      S21TransposeSquare(rows_, matrix_, stride_);
+    } else if (stride_ == cols_) {
+      S21TransposePacked(rows_, cols_, matrix_);
+      std::swap(rows_, cols_);
+      stride_ = cols_;
+    } else {
+      *this = Transpose();
     }
-  } else {
+  }
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::CalcComplements() const {
+  S21_STATS_SCOPE(S21Operation::kCalcComplements, rows_, cols_, 0,
+                  2.0 * rows_ * rows_ * rows_);
+  if (this->rows_ != this->cols_) {
     throw std::out_of_range("The matrix isn't square");
   }
+  if (this->ExistMatrix() && rows_ > 1) {
+    const S21BasicLU<T> lu(*this);
+    if (lu.PivotRatio() > kComplementsPivotRatio) {
+      // adj(A) = det(A) * A^-1, so the complements are det(A) * (A^-1)^T.
+      S21BasicMatrix result = lu.Inverse();
+      result.TransposeInPlace();
+      result.MulNumber(lu.Determinant());
+      return result;
+    }
+  }
+  // Singular or nearly so: expand every minor explicitly.
+  S21BasicMatrix result(rows_, cols_, resource_);
+  if (this->ExistMatrix()) {
+    S21BasicMatrix HelpMatrix(rows_ - 1, cols_ - 1, resource_);
+    for (int i = 0; i < rows_; ++i) {
+      for (int j = 0; j < cols_; ++j) {
+        HelpMatrix.ShortCopy(*this, i, j);
+        const T minor = HelpMatrix.Determinant();
+        result.Row(i)[j] = (i + j) % 2 ? -minor : minor;
+      }
+    }
+  }
   return result;
 }
 
-double S21Matrix::Determinant() {
-  double det = 0;
-  double help_det = 0;
+template <typename T>
+T S21BasicMatrix<T>::Determinant() const {
+  return Determinant(S21MatrixStructure::kAuto);
+}
+
+template <typename T>
+T S21BasicMatrix<T>::Determinant(S21MatrixStructure structure) const {
+  S21_STATS_SCOPE(S21Operation::kDeterminant, rows_, cols_, 0,
+                  2.0 / 3 * rows_ * rows_ * rows_);
+  T det = 0;
+  T help_det = 0;
   if (this->rows_ == this->cols_) {
     if (this->ExistMatrix()) {
       if (rows_ == 1) {
-        help_det = this->matrix_[0][0];
+        help_det = this->Row(0)[0];
       } else if (rows_ == 2) {
-        help_det = (this->matrix_[0][0] * this->matrix_[1][1] -
-                    this->matrix_[1][0] * this->matrix_[0][1]);
+        help_det = (this->Row(0)[0] * this->Row(1)[1] -
+                    this->Row(1)[0] * this->Row(0)[1]);
+      } else if (rows_ == 3) {
+        help_det = Determinant3();
+      } else if (rows_ == 4) {
+        help_det = Determinant4();
       } else {
-        S21Matrix submat(this->rows_ - 1, this->cols_ - 1);
-        for (int i = 0; i < cols_; ++i) {
-          submat.ShortCopy(*this, 0, i);
-          det = submat.Determinant();
-          help_det += this->matrix_[0][i] * pow(-1, i) * det;
-        }
+        help_det = DeterminantFactored(structure);
       }
       det = help_det;
     }
@@ -159,176 +328,327 @@ double S21Matrix::Determinant() {
   return det;
 }
 
-S21Matrix S21Matrix::InverseMatrix() {
-  S21Matrix inversed_matrix(this->rows_, this->cols_);
-  double determinant = this->Determinant();
-  if (determinant != 0) {
-    if (this->ExistMatrix() && (this->rows_ == this->cols_)) {
-      inversed_matrix = this->CalcComplements();
-      inversed_matrix = inversed_matrix.Transpose();
-      for (int i = 0; i < this->rows_; ++i) {
-        for (int j = 0; j < this->cols_; ++j) {
-          inversed_matrix.matrix_[i][j] =
-              1 / determinant * inversed_matrix.matrix_[i][j];
-        }
-      }
-    }
-  } else {
-    throw std::invalid_argument("the Determinant of the matrix is 0");
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::InverseMatrix() const {
+  return InverseMatrix(S21MatrixStructure::kAuto);
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::InverseMatrix(
+    S21MatrixStructure structure) const {
+  S21_STATS_SCOPE(S21Operation::kInverseMatrix, rows_, cols_, 0,
+                  2.0 * rows_ * rows_ * rows_);
+  const bool detected = structure == S21MatrixStructure::kAuto;
+  if (detected) structure = DetectStructure();
+  if (structure == S21MatrixStructure::kPositiveDefinite) {
+    const S21BasicCholesky<T> cholesky(*this);
+    if (cholesky.IsPositiveDefinite() || !detected) return cholesky.Inverse();
+  } else if (structure == S21MatrixStructure::kSymmetric) {
+    const S21BasicLDLT<T> ldlt(*this);
+    if (!ldlt.IsSingular()) return ldlt.Inverse();
   }
-  return inversed_matrix;
+  return S21BasicLU<T>(*this).Inverse();
 }
 
-// Overloadings opertators
-
-S21Matrix S21Matrix::operator+(const S21Matrix& other) {
-  S21Matrix new_matrix(*this);
-  new_matrix.SumMatrix(other);
-  return new_matrix;
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::LeastSquares(
+    const S21BasicMatrix& b) const {
+  return S21BasicQR<T>(*this).Solve(b);
 }
 
-S21Matrix S21Matrix::operator-(const S21Matrix& other) {
-  S21Matrix new_matrix(*this);
-  new_matrix.SubMatrix(other);
-  return new_matrix;
-}
+// Overloadings opertators
 
-S21Matrix S21Matrix::operator*(const S21Matrix& other) {
-  S21Matrix new_matrix(*this);
-  new_matrix.MulMatrix(other);
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator*(
+    const S21BasicMatrix& other) const {
+  S21_STATS_SCOPE(S21Operation::kMulMatrix, rows_, other.cols_, cols_,
+                  2.0 * rows_ * cols_ * other.cols_);
+  S21BasicMatrix new_matrix(rows_, other.cols_, resource_);
+  MulInto(*this, other, new_matrix);
   return new_matrix;
 }
 
-S21Matrix S21Matrix::operator*(double number) {
-  S21Matrix new_matrix(*this);
-  new_matrix.MulNumber(number);
-  return new_matrix;
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator*(T number) && {
+  MulNumber(number);
+  return std::move(*this);
 }
 
-bool S21Matrix::operator==(const S21Matrix& other) {
+template <typename T>
+bool S21BasicMatrix<T>::operator==(const S21BasicMatrix& other) const {
   return this->EqMatrix(other);
 }
 
-S21Matrix S21Matrix::operator=(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(const S21BasicMatrix& other) {
   if (this != &other) {
-    MemoryDeallocating();
-    rows_ = other.rows_;
-    cols_ = other.cols_;
-    matrix_ = MemoryAllocating(rows_, cols_);
+    if (!EqSizeMatrix(other) || !ExistMatrix()) {
+      MemoryDeallocating();
+      rows_ = other.rows_;
+      cols_ = other.cols_;
+      stride_ = other.cols_;
+      matrix_ = MemoryAllocating(rows_, stride_);
+      capacity_ = static_cast<std::size_t>(rows_) * stride_;
+    }
     CopyMatrix(other);
+    ++version_;
   }
   return *this;
 }
 
-S21Matrix S21Matrix::operator=(S21Matrix&& other) {
-  this->MemoryDeallocating();
-  MoveMatrix(other);
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(
+    S21BasicMatrix&& other) noexcept {
+  if (this != &other) {
+    this->MemoryDeallocating();
+    MoveMatrix(other);
+  }
   return *this;
 }
 
-S21Matrix S21Matrix::operator+=(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator+=(const S21BasicMatrix& other) {
   this->SumMatrix(other);
   return *this;
 }
 
-S21Matrix S21Matrix::operator-=(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator-=(const S21BasicMatrix& other) {
   this->SubMatrix(other);
   return *this;
 }
 
-S21Matrix S21Matrix::operator*=(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator*=(const S21BasicMatrix& other) {
   this->MulMatrix(other);
   return *this;
 }
 
-S21Matrix S21Matrix::operator*=(double number) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator*=(T number) {
   this->MulNumber(number);
   return *this;
 }
 
-double& S21Matrix::operator()(int i, int j) {
-  if (rows_ <= i || i < 0 || cols_ <= j || j < 0) {
-    throw std::out_of_range("The index out of matrix limit");
-  }
-  return matrix_[i][j];
+template <typename T>
+T& S21BasicMatrix<T>::operator()(int i, int j) {
+  CheckIndex(i, j);
+  ++version_;
+  return Row(i)[j];
+}
+
+template <typename T>
+const T& S21BasicMatrix<T>::operator()(int i, int j) const {
+  CheckIndex(i, j);
+  return Row(i)[j];
 }
 
 // Accessors & mutators
 
-int S21Matrix::GetCols() const { return cols_; }
+template <typename T>
+T* S21BasicMatrix<T>::data() { return matrix_; }
 
-int S21Matrix::GetRows() const { return rows_; }
+template <typename T>
+const T* S21BasicMatrix<T>::data() const { return matrix_; }
 
-void S21Matrix::SetCols(int cols) {
-  if (this->matrix_) {
-    S21Matrix result(rows_, cols);
-    for (int i = 0; i < rows_; ++i) {
-      for (int j = 0; j < cols_ && j < result.cols_; ++j) {
-        result.matrix_[i][j] = matrix_[i][j];
-      }
-    }
-    *this = result;
+template <typename T>
+int S21BasicMatrix<T>::stride() const { return stride_; }
+
+template <typename T>
+std::pmr::memory_resource* S21BasicMatrix<T>::GetResource() const {
+  return resource_;
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::View() {
+  return S21BasicMatrixView<T>(*this);
+}
+
+template <typename T>
+S21BasicMatrixView<const T> S21BasicMatrix<T>::View() const {
+  return S21BasicMatrixView<const T>(*this);
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::Block(int row, int col, int rows,
+                                               int cols) {
+  return View().Block(row, col, rows, cols);
+}
+
+template <typename T>
+S21BasicMatrixView<const T> S21BasicMatrix<T>::Block(int row, int col, int rows,
+                                                     int cols) const {
+  return View().Block(row, col, rows, cols);
+}
+
+template <typename T>
+int S21BasicMatrix<T>::GetCols() const { return cols_; }
+
+template <typename T>
+int S21BasicMatrix<T>::GetRows() const { return rows_; }
+
+template <typename T>
+void S21BasicMatrix<T>::SetCols(int cols) {
+  S21_STATS_SCOPE(S21Operation::kSetCols, rows_, cols, 0, 0);
+  if (this->ExistMatrix()) Resize(rows_, cols);
+}
+
+template <typename T>
+void S21BasicMatrix<T>::SetRows(int rows) {
+  S21_STATS_SCOPE(S21Operation::kSetRows, rows, cols_, 0, 0);
+  if (this->ExistMatrix()) Resize(rows, cols_);
+}
+
+// Capacity
+
+template <typename T>
+void S21BasicMatrix<T>::Reserve(int rows, int cols) {
+  const int stride = std::max(stride_, cols);
+  const int capacity_rows = std::max(rows, GetRowCapacity());
+  if (stride > stride_ || capacity_rows > GetRowCapacity()) {
+    Reallocate(capacity_rows, stride);
   }
 }
 
-void S21Matrix::SetRows(int rows) {
-  if (this->matrix_) {
-    S21Matrix result(rows, cols_);
-    for (int i = 0; i < rows_ && i < result.rows_; ++i) {
-      for (int j = 0; j < cols_; ++j) {
-        result.matrix_[i][j] = matrix_[i][j];
-      }
+template <typename T>
+int S21BasicMatrix<T>::GetRowCapacity() const {
+  return stride_ > 0 ? static_cast<int>(capacity_ / stride_) : 0;
+}
+
+template <typename T>
+int S21BasicMatrix<T>::GetColCapacity() const { return stride_; }
+
+template <typename T>
+void S21BasicMatrix<T>::Resize(int rows, int cols) {
+  ++version_;
+  if (rows <= 0 || cols <= 0) {
+    rows_ = 0;
+    cols_ = 0;
+  } else if (cols > stride_ || rows > GetRowCapacity()) {
+    Reallocate(rows, cols);
+    rows_ = rows;
+    cols_ = cols;
+  } else {
+    // The buffer may hold stale elements past the old shape
+    const S21BasicSimdKernels<T>& simd = S21SimdActive<T>();
+    for (int i = 0; i < std::min(rows_, rows) && cols > cols_; ++i) {
+      simd.fill(Row(i) + cols_, T(0), static_cast<std::size_t>(cols - cols_));
+    }
+    for (int i = rows_; i < rows; ++i) {
+      simd.fill(Row(i), T(0), static_cast<std::size_t>(cols));
     }
-    *this = result;
+    rows_ = rows;
+    cols_ = cols;
   }
 }
 
-// Additional
+template <typename T>
+void S21BasicMatrix<T>::AppendRow(const std::vector<T>& row) {
+  const int cols = static_cast<int>(row.size());
+  if (this->ExistMatrix() && cols != cols_) {
+    throw std::out_of_range("Different size of matrix");
+  }
+  if (cols == 0) throw std::out_of_range("Incorrect size of matrix");
+  if (rows_ == GetRowCapacity() || cols > stride_) {
+    Reserve(std::max(2 * rows_, 1), cols);
+  }
+  std::copy(row.begin(), row.end(), Row(rows_));
+  ++rows_;
+  cols_ = cols;
+  ++version_;
+}
 
-double** S21Matrix::MemoryAllocating(int rows, int cols) {
-  double** allocated_matrix = new double*[rows];
-  for (int i = 0; i < rows; ++i) {
-    allocated_matrix[i] = new double[cols];
+template <typename T>
+void S21BasicMatrix<T>::AppendCol(const std::vector<T>& col) {
+  const int rows = static_cast<int>(col.size());
+  if (this->ExistMatrix() && rows != rows_) {
+    throw std::out_of_range("Different size of matrix");
   }
-  for (int j = 0; j < rows; ++j) {
-    for (int k = 0; k < cols; ++k) {
-      allocated_matrix[j][k] = 0;
-    }
+  if (rows == 0) throw std::out_of_range("Incorrect size of matrix");
+  if (cols_ == stride_ || rows > GetRowCapacity()) {
+    Reserve(rows, std::max(2 * cols_, 1));
+  }
+  for (int i = 0; i < rows; ++i) Row(i)[cols_] = col[i];
+  rows_ = rows;
+  ++cols_;
+  ++version_;
+}
+
+template <typename T>
+void S21BasicMatrix<T>::ShrinkToFit() {
+  if (capacity_ != static_cast<std::size_t>(rows_) * cols_) {
+    Reallocate(rows_, cols_);
+  }
+}
+
+// Additional
+
+template <typename T>
+T* S21BasicMatrix<T>::MemoryAllocating(int rows, int stride) {
+  T* allocated_matrix = nullptr;
+  if (rows > 0 && stride > 0) {
+    const std::size_t size =
+        static_cast<std::size_t>(rows) * static_cast<std::size_t>(stride);
+    allocated_matrix = static_cast<T*>(
+        resource_->allocate(size * sizeof(T), kAlignment));
+    S21_STATS_ALLOCATION(size * sizeof(T));
+    const S21BasicSimdKernels<T>& simd = S21SimdActive<T>();
+    S21ParallelFor(0, static_cast<std::ptrdiff_t>(size), 1.0,
+                   [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                     simd.fill(allocated_matrix + begin, T(0),
+                               static_cast<std::size_t>(end - begin));
+                   });
   }
   return allocated_matrix;
 }
 
-void S21Matrix::MemoryDeallocating() {
+template <typename T>
+void S21BasicMatrix<T>::MemoryDeallocating() {
   if (this->matrix_) {
-    for (int i = 0; i < rows_; ++i) {
-      delete[] matrix_[i];
-    }
-    delete[] matrix_;
+    resource_->deallocate(matrix_, capacity_ * sizeof(T), kAlignment);
+    matrix_ = nullptr;
+    capacity_ = 0;
   }
 }
 
-void S21Matrix::CopyMatrix(const S21Matrix& other) {
-  for (int i = 0; i < other.rows_; ++i) {
-    for (int j = 0; j < other.cols_; ++j) {
-      matrix_[i][j] = other.matrix_[i][j];
-    }
+template <typename T>
+void S21BasicMatrix<T>::Reallocate(int rows, int stride) {
+  T* allocated_matrix = MemoryAllocating(rows, stride);
+  if (this->ExistMatrix() && allocated_matrix) {
+    S21StridedUpdate(S21StridedOp::kCopy, std::min(rows_, rows),
+                     std::min(cols_, stride), allocated_matrix, stride, 1,
+                     matrix_, stride_, 1);
   }
+  MemoryDeallocating();
+  matrix_ = allocated_matrix;
+  stride_ = allocated_matrix ? stride : 0;
+  capacity_ = allocated_matrix ? static_cast<std::size_t>(rows) * stride : 0;
 }
 
-bool S21Matrix::ExistMatrix() const {
+template <typename T>
+void S21BasicMatrix<T>::CopyMatrix(const S21BasicMatrix& other) {
+  S21StridedUpdate(S21StridedOp::kCopy, other.rows_, other.cols_, matrix_,
+                   stride_, 1, other.matrix_, other.stride_, 1);
+}
+
+template <typename T>
+bool S21BasicMatrix<T>::ExistMatrix() const {
   return (rows_ > 0 && cols_ > 0 && matrix_);
 }
 
-bool S21Matrix::EqSizeMatrix(const S21Matrix& other) const {
+template <typename T>
+bool S21BasicMatrix<T>::EqSizeMatrix(const S21BasicMatrix& other) const {
   return (rows_ == other.rows_ && cols_ == other.cols_);
 }
 
-void S21Matrix::ShortCopy(const S21Matrix& other, int rows, int cols) {
+template <typename T>
+void S21BasicMatrix<T>::ShortCopy(const S21BasicMatrix& other, int rows,
+                                  int cols) {
   for (int i = 0, k = 0; i < other.rows_; ++i) {
     if (i != rows) {
       for (int j = 0, t = 0; j < other.cols_; ++j) {
         if (j != cols) {
-          this->matrix_[k][t] = other.matrix_[i][j];
+          this->Row(k)[t] = other.Row(i)[j];
           ++t;
         }
       }
@@ -337,21 +657,118 @@ void S21Matrix::ShortCopy(const S21Matrix& other, int rows, int cols) {
   }
 }
 
-void S21Matrix::FillingMatrix() {
-  double count = 0;
+template <typename T>
+T S21BasicMatrix<T>::Determinant3() const {
+  const T* r0 = Row(0);
+  const T* r1 = Row(1);
+  const T* r2 = Row(2);
+  return r0[0] * (r1[1] * r2[2] - r2[1] * r1[2]) -
+         r0[1] * (r1[0] * r2[2] - r2[0] * r1[2]) +
+         r0[2] * (r1[0] * r2[1] - r2[0] * r1[1]);
+}
+
+template <typename T>
+T S21BasicMatrix<T>::Determinant4() const {
+  const T* r0 = Row(0);
+  const T* r1 = Row(1);
+  const T* r2 = Row(2);
+  const T* r3 = Row(3);
+  // 2x2 minors of the bottom two rows, indexed by their column pair.
+  const T s01 = r2[0] * r3[1] - r2[1] * r3[0];
+  const T s02 = r2[0] * r3[2] - r2[2] * r3[0];
+  const T s03 = r2[0] * r3[3] - r2[3] * r3[0];
+  const T s12 = r2[1] * r3[2] - r2[2] * r3[1];
+  const T s13 = r2[1] * r3[3] - r2[3] * r3[1];
+  const T s23 = r2[2] * r3[3] - r2[3] * r3[2];
+  return r0[0] * (r1[1] * s23 - r1[2] * s13 + r1[3] * s12) -
+         r0[1] * (r1[0] * s23 - r1[2] * s03 + r1[3] * s02) +
+         r0[2] * (r1[0] * s13 - r1[1] * s03 + r1[3] * s01) -
+         r0[3] * (r1[0] * s12 - r1[1] * s02 + r1[2] * s01);
+}
+
+template <typename T>
+T S21BasicMatrix<T>::DeterminantFactored(S21MatrixStructure structure) const {
+  const bool detected = structure == S21MatrixStructure::kAuto;
+  if (detected) structure = DetectStructure();
+  if (structure == S21MatrixStructure::kPositiveDefinite) {
+    const S21BasicCholesky<T> cholesky(*this);
+    if (cholesky.IsPositiveDefinite() || !detected) {
+      return cholesky.Determinant();
+    }
+  } else if (structure == S21MatrixStructure::kSymmetric) {
+    const S21BasicLDLT<T> ldlt(*this);
+    if (!ldlt.IsSingular()) return ldlt.Determinant();
+  }
+  return S21BasicLU<T>(*this).Determinant();
+}
+
+template <typename T>
+S21MatrixStructure S21BasicMatrix<T>::DetectStructure() const {
+  for (int i = 0; i < rows_ && i < cols_; ++i) {
+    if (!(std::real(Row(i)[i]) > Real(0))) return S21MatrixStructure::kGeneral;
+  }
+  return S21IsHermitian(*this) ? S21MatrixStructure::kPositiveDefinite
+                               : S21MatrixStructure::kGeneral;
+}
+
+template <typename T>
+void S21BasicMatrix<T>::FillingMatrix() {
+  ++version_;
+  Real count = 0;
   for (int i = 0; i < this->GetRows(); ++i) {
     for (int j = 0; j < this->GetCols(); ++j) {
-      this->matrix_[i][j] = count;
+      this->Row(i)[j] = count;
       count++;
     }
   }
 }
 
-void S21Matrix::MoveMatrix(S21Matrix& other) {
+template <typename T>
+void S21BasicMatrix<T>::MoveMatrix(S21BasicMatrix& other) {
   this->rows_ = other.rows_;
   this->cols_ = other.cols_;
+  this->stride_ = other.stride_;
   this->matrix_ = other.matrix_;
+  this->resource_ = other.resource_;
+  this->capacity_ = other.capacity_;
   other.rows_ = 0;
   other.cols_ = 0;
-  other.matrix_ = 0;
+  other.stride_ = 0;
+  other.matrix_ = nullptr;
+  other.capacity_ = 0;
+  ++version_;
+  ++other.version_;
+}
+
+template <typename T>
+void S21BasicMatrix<T>::Swap(S21BasicMatrix& other) noexcept {
+  std::swap(rows_, other.rows_);
+  std::swap(cols_, other.cols_);
+  std::swap(stride_, other.stride_);
+  std::swap(matrix_, other.matrix_);
+  std::swap(resource_, other.resource_);
+  std::swap(capacity_, other.capacity_);
+  ++version_;
+  ++other.version_;
+}
+
+template class S21BasicMatrix<float>;
+template class S21BasicMatrix<double>;
+template class S21BasicMatrix<long double>;
+template class S21BasicMatrix<std::complex<double>>;
+
+S21Matrix S21MulMatrixMixed(const S21BasicMatrix<float>& a,
+                            const S21BasicMatrix<float>& b) {
+  if (a.GetCols() != b.GetRows()) {
+    throw std::out_of_range(
+        "The number of columns of the first matrix does not equal the number "
+        "of rows of the second matrix");
+  }
+  S21Matrix product(a.GetRows(), b.GetCols(), a.GetResource());
+  if (product.data() && a.GetCols() > 0) {
+    S21GemmMixed(a.GetRows(), b.GetCols(), a.GetCols(), 1.0, a.data(),
+                 a.stride(), b.data(), b.stride(), 0.0, product.data(),
+                 product.stride());
+  }
+  return product;
 }
@@ -1,61 +1,407 @@
 #ifndef SRC_S21_MATRIX_OOP_H_
 #define SRC_S21_MATRIX_OOP_H_
 
+#include <algorithm>
 #include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
-class S21Matrix {
+#include "s21_matrix_expr.h"
+#include "s21_matrix_iterator.h"
+#include "s21_matrix_traits.h"
+#include "s21_matrix_view.h"
+
+// The element buffer comes from a std::pmr::memory_resource, the default
+// resource unless one is given (see s21_memory.h for an arena and a pool).
+// A copy allocates from its own resource, while a move hands the buffer over
+// together with the resource that owns it. Temporaries an operation needs
+// come from the resource of the matrix it is called on.
+//
+// T is the element type: float, double, long double or std::complex<double>,
+// each with its own SIMD kernels where the CPU has them. S21Matrix is the
+// double matrix.
+//
+// What Determinant and InverseMatrix may assume about a square matrix, which
+// decides the factorisation they use. kAuto takes Cholesky for a matrix that
+// is exactly Hermitian (symmetric, for real elements) with a positive
+// diagonal, falling back to LU when Cholesky finds it is not positive
+// definite after all. kPositiveDefinite always takes Cholesky and throws
+// std::invalid_argument when the matrix is not positive definite;
+// kSymmetric takes LDL^T unless it meets a zero pivot. Both read only the
+// upper triangle. kGeneral always takes LU with partial pivoting. Sizes up
+// to 4 are handled by closed formulas in Determinant whatever the structure.
+enum class S21MatrixStructure {
+  kAuto,
+  kGeneral,
+  kSymmetric,
+  kPositiveDefinite
+};
+
+// operator() checks its indices and throws std::out_of_range; at_unchecked
+// and operator[] do not, unless the code using them is built with
+// -DS21_MATRIX_DEBUG (make DEBUG=1). Every translation unit of a program
+// should agree on that setting.
+template <typename T>
+class S21BasicMatrix : public S21MatrixExpr<S21BasicMatrix<T>> {
  public:
+  using Value = T;
+  using Real = typename S21MatrixTraits<T>::Real;
+  // Row-major iteration over all elements, as in range-for
+  using value_type = T;
+  using iterator = S21FlatIterator<T>;
+  using const_iterator = S21FlatIterator<const T>;
+  using row_iterator = T*;
+  using const_row_iterator = const T*;
+  using col_iterator = S21StrideIterator<T>;
+  using const_col_iterator = S21StrideIterator<const T>;
+
   // Constructors
-  S21Matrix();
-  S21Matrix(int rows, int cols);
-  S21Matrix(const S21Matrix& other);
-  S21Matrix(S21Matrix&& other);
-  ~S21Matrix();
+  S21BasicMatrix();
+  explicit S21BasicMatrix(std::pmr::memory_resource* resource);
+  S21BasicMatrix(int rows, int cols,
+                 std::pmr::memory_resource* resource =
+                     std::pmr::get_default_resource());
+  S21BasicMatrix(const S21BasicMatrix& other);
+  S21BasicMatrix(const S21BasicMatrix& other,
+                 std::pmr::memory_resource* resource);
+  S21BasicMatrix(S21BasicMatrix&& other) noexcept;
+  // Evaluates an elementwise expression in a single fused pass
+  template <typename E,
+            typename = std::enable_if_t<!S21IsMatrixView<E>::value>>
+  S21BasicMatrix(const S21MatrixExpr<E>& expr,
+                 std::pmr::memory_resource* resource =
+                     std::pmr::get_default_resource());
+  // Copies the elements of a view into a new packed matrix
+  explicit S21BasicMatrix(const S21BasicMatrixView<const T>& view,
+                          std::pmr::memory_resource* resource =
+                              std::pmr::get_default_resource());
+  ~S21BasicMatrix();
   // Operations
-  bool EqMatrix(const S21Matrix& other);
-  void SumMatrix(const S21Matrix& other);
-  void SubMatrix(const S21Matrix& other);
-  void MulNumber(double number);
-  void MulMatrix(const S21Matrix& other);
-  S21Matrix Transpose();
-  S21Matrix CalcComplements();
-  double Determinant();
-  S21Matrix InverseMatrix();
+  // Elements may differ by S21MatrixTraits<T>::kEpsilon
+  bool EqMatrix(const S21BasicMatrix& other) const;
+  bool EqMatrix(const S21BasicMatrixView<const T>& other) const;
+  void SumMatrix(const S21BasicMatrix& other);
+  void SumMatrix(const S21BasicMatrixView<const T>& other);
+  void SubMatrix(const S21BasicMatrix& other);
+  void SubMatrix(const S21BasicMatrixView<const T>& other);
+  void MulNumber(T number);
+  // Large products take Strassen-Winograd once S21SetMulAlgorithm selects
+  // it (s21_strassen.h), as does operator*
+  void MulMatrix(const S21BasicMatrix& other);
+  void MulMatrix(const S21BasicMatrixView<const T>& other);
+  S21BasicMatrix Transpose() const;
+  // Transposes square matrices without allocating and packed ones with one
+  // bit of scratch per element instead of a second buffer
+  void TransposeInPlace();
+  S21BasicMatrix CalcComplements() const;
+  T Determinant() const;
+  T Determinant(S21MatrixStructure structure) const;
+  S21BasicMatrix InverseMatrix() const;
+  S21BasicMatrix InverseMatrix(S21MatrixStructure structure) const;
+  // The X minimising ||A * X - B|| column by column, through Householder QR;
+  // A needs at least as many rows as columns and full column rank
+  S21BasicMatrix LeastSquares(const S21BasicMatrix& b) const;
+  // C = alpha * A * B + beta * C through the cache-blocked kernel, whatever
+  // S21SetMulAlgorithm says
+  static void Gemm(T alpha, const S21BasicMatrixView<const T>& a,
+                   const S21BasicMatrixView<const T>& b, T beta,
+                   const S21BasicMatrixView<T>& c);
   // Overloadings opertators
-  S21Matrix operator+(const S21Matrix& other);
-  S21Matrix operator-(const S21Matrix& other);
-  S21Matrix operator*(const S21Matrix& other);
-  S21Matrix operator*(double number);
-  bool operator==(const S21Matrix& other);
-  S21Matrix operator=(const S21Matrix& other);
-  S21Matrix operator=(S21Matrix&& other);
-  S21Matrix operator+=(const S21Matrix& other);
-  S21Matrix operator-=(const S21Matrix& other);
-  S21Matrix operator*=(const S21Matrix& other);
-  S21Matrix operator*=(double number);
-  double& operator()(int i, int j);
+  // +, - and * by a number are lazy and live in s21_matrix_expr.h
+  S21BasicMatrix operator*(const S21BasicMatrix& other) const;
+  // An rvalue left operand is updated in place and its buffer returned
+  template <typename E>
+  S21BasicMatrix operator+(const S21MatrixExpr<E>& other) &&;
+  template <typename E>
+  S21BasicMatrix operator-(const S21MatrixExpr<E>& other) &&;
+  S21BasicMatrix operator*(T number) &&;
+  bool operator==(const S21BasicMatrix& other) const;
+  // Reuses the buffer when the shapes already match
+  S21BasicMatrix& operator=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator=(S21BasicMatrix&& other) noexcept;
+  S21BasicMatrix& operator+=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator-=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator*=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator*=(T number);
+  template <typename E>
+  S21BasicMatrix& operator=(const S21MatrixExpr<E>& expr);
+  template <typename E>
+  S21BasicMatrix& operator+=(const S21MatrixExpr<E>& expr);
+  template <typename E>
+  S21BasicMatrix& operator-=(const S21MatrixExpr<E>& expr);
+  T& operator()(int i, int j);
+  const T& operator()(int i, int j) const;
+  // Element (i, j) and row i without bounds checks (see above)
+  T& at_unchecked(int i, int j) {
+    CheckIndexDebug(i, j);
+    return Row(i)[j];
+  }
+  const T& at_unchecked(int i, int j) const {
+    CheckIndexDebug(i, j);
+    return Row(i)[j];
+  }
+  T* operator[](int i) {
+    CheckIndexDebug(i, 0);
+    return Row(i);
+  }
+  const T* operator[](int i) const {
+    CheckIndexDebug(i, 0);
+    return Row(i);
+  }
+  // Unchecked element read used by expression evaluation
+  T Coeff(int i, int j) const { return Row(i)[j]; }
   // Accessors & mutators
+  // Element (i, j) lives at data()[i * stride() + j]; rows are contiguous.
+  T* data();
+  const T* data() const;
+  int stride() const;
+  std::pmr::memory_resource* GetResource() const;
+  // Non-owning views of the whole matrix or of a block of it
+  S21BasicMatrixView<T> View();
+  S21BasicMatrixView<const T> View() const;
+  S21BasicMatrixView<T> Block(int row, int col, int rows, int cols);
+  S21BasicMatrixView<const T> Block(int row, int col, int rows,
+                                    int cols) const;
   int GetCols() const;
   int GetRows() const;
+  // Counts the changes made through the non-const operator(), the shape
+  // mutators, assignment and the in-place operations, so that a cache such
+  // as S21BasicIncrementalInverse can tell it is stale. Every call of the
+  // non-const operator() counts, reads included; at_unchecked, operator[],
+  // iterators, data() and views are not tracked.
+  std::uint64_t GetVersion() const { return version_; }
+  // Iterators
+  iterator begin() { return iterator(matrix_, 0, cols_, stride_); }
+  iterator end() { return iterator(Row(rows_), 0, cols_, stride_); }
+  const_iterator begin() const {
+    return const_iterator(matrix_, 0, cols_, stride_);
+  }
+  const_iterator end() const {
+    return const_iterator(Row(rows_), 0, cols_, stride_);
+  }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+  row_iterator RowBegin(int i) { return (*this)[i]; }
+  row_iterator RowEnd(int i) { return (*this)[i] + cols_; }
+  const_row_iterator RowBegin(int i) const { return (*this)[i]; }
+  const_row_iterator RowEnd(int i) const { return (*this)[i] + cols_; }
+  col_iterator ColBegin(int j) {
+    CheckIndexDebug(0, j);
+    return col_iterator(matrix_ + j, stride_);
+  }
+  col_iterator ColEnd(int j) { return ColBegin(j) + rows_; }
+  const_col_iterator ColBegin(int j) const {
+    CheckIndexDebug(0, j);
+    return const_col_iterator(matrix_ + j, stride_);
+  }
+  const_col_iterator ColEnd(int j) const { return ColBegin(j) + rows_; }
+  // Resize with the other side kept; no-ops on an empty matrix
   void SetCols(int cols);
   void SetRows(int rows);
+  // Capacity
+  // Rows are stride() elements apart in a buffer that may hold more rows
+  // than the matrix has, so the shape can change without reallocating.
+  // Reserve makes room for rows x cols, keeping the shape and elements.
+  void Reserve(int rows, int cols);
+  int GetRowCapacity() const;
+  int GetColCapacity() const;
+  // Changes the shape in place when it fits the capacity, shrinking
+  // included; otherwise moves to a buffer of exactly the new shape. The
+  // overlapping elements are kept and the new ones are zero. A side of 0
+  // or less empties the matrix but keeps its buffer.
+  void Resize(int rows, int cols);
+  // Add a row or column at the end, doubling the capacity when it is full,
+  // so that building a matrix by n appends copies O(n) rows or columns in
+  // total. An empty matrix takes its width or height from the first one.
+  void AppendRow(const std::vector<T>& row);
+  void AppendCol(const std::vector<T>& col);
+  // Frees the capacity beyond the current shape
+  void ShrinkToFit();
   // Additional
   void FillingMatrix();
-  void MoveMatrix(S21Matrix& other);
+  void MoveMatrix(S21BasicMatrix& other);
+  // Exchanges buffers, shapes and resources
+  void Swap(S21BasicMatrix& other) noexcept;
 
  private:
+  // Alignment of the element buffer, enough for a full AVX-512 register.
+  static constexpr std::size_t kAlignment = 64;
+  // Below this pivot ratio CalcComplements leaves the det * inverse^T
+  // shortcut, which loses all precision as the matrix nears singularity.
+  static constexpr Real kComplementsPivotRatio = 1e-8;
+
   int rows_;
   int cols_;
-  double** matrix_;
+  int stride_;
+  T* matrix_;
+  std::pmr::memory_resource* resource_;
+  std::uint64_t version_;
+  // Elements allocated at matrix_, at least rows_ * stride_
+  std::size_t capacity_;
   // Additional
-  double** MemoryAllocating(int rows, int cols);
+  T* Row(int i) { return matrix_ + static_cast<std::ptrdiff_t>(i) * stride_; }
+  const T* Row(int i) const {
+    return matrix_ + static_cast<std::ptrdiff_t>(i) * stride_;
+  }
+  void CheckIndex(int i, int j) const {
+    if (rows_ <= i || i < 0 || cols_ <= j || j < 0) {
+      throw std::out_of_range("The index out of matrix limit");
+    }
+  }
+  void CheckIndexDebug([[maybe_unused]] int i, [[maybe_unused]] int j) const {
+#ifdef S21_MATRIX_DEBUG
+    CheckIndex(i, j);
+#endif
+  }
+  T* MemoryAllocating(int rows, int stride);
   void MemoryDeallocating();
-  void CopyMatrix(const S21Matrix& other);
+  // Moves to a new buffer of rows rows, stride elements apart, keeping the
+  // elements that fit; the shape is left to the caller
+  void Reallocate(int rows, int stride);
+  void CopyMatrix(const S21BasicMatrix& other);
   bool ExistMatrix() const;
-  bool EqSizeMatrix(const S21Matrix& other) const;
-  void ShortCopy(const S21Matrix& other, int rows, int cols);
+  bool EqSizeMatrix(const S21BasicMatrix& other) const;
+  void ShortCopy(const S21BasicMatrix& other, int rows, int cols);
+  // Exact cofactor expansions for the smallest sizes and an O(n^3) LU path
+  // with partial pivoting for everything larger.
+  T Determinant3() const;
+  T Determinant4() const;
+  T DeterminantFactored(S21MatrixStructure structure) const;
+  S21MatrixStructure DetectStructure() const;
+  // product = a * b for MulMatrix and operator*, through S21Strassen when
+  // that mode is on and the product is large enough, else through Gemm
+  static void MulInto(const S21BasicMatrixView<const T>& a,
+                      const S21BasicMatrixView<const T>& b,
+                      S21BasicMatrix& product);
+  template <typename E, typename Op>
+  void EvaluateExpr(const E& expr, Op op);
 };
 
+extern template class S21BasicMatrix<float>;
+extern template class S21BasicMatrix<double>;
+extern template class S21BasicMatrix<long double>;
+extern template class S21BasicMatrix<std::complex<double>>;
+
+using S21Matrix = S21BasicMatrix<double>;
+
+// a * b of two float matrices with every product accumulated in double, for
+// inputs stored compactly whose sums would lose digits in float.
+S21Matrix S21MulMatrixMixed(const S21BasicMatrix<float>& a,
+                            const S21BasicMatrix<float>& b);
+
+template <typename T>
+S21BasicMatrixView<T>::S21BasicMatrixView(Matrix& matrix)
+    : S21BasicMatrixView(matrix.data(), matrix.GetRows(), matrix.GetCols(),
+                         matrix.stride()) {}
+
+// A leaf of an expression, see S21ExprAliases
+template <typename T>
+bool S21ExprAliases(const S21BasicMatrix<T>& matrix,
+                    const S21BasicMatrixView<const T>& dst) {
+  return S21Aliases(matrix.View(), dst);
+}
+
+template <typename T>
+template <typename E, typename>
+S21BasicMatrix<T>::S21BasicMatrix(const S21MatrixExpr<E>& expr,
+                                  std::pmr::memory_resource* resource)
+    : S21BasicMatrix(expr.GetRows(), expr.GetCols(), resource) {
+  EvaluateExpr(expr.Self(), [](T, T value) { return value; });
+}
+
+template <typename T>
+template <typename E>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(
+    const S21MatrixExpr<E>& expr) {
+  if constexpr (S21IsMatrixView<E>::value) {
+    // A view of this very matrix may be laid out differently (a transpose,
+    // say), so it is materialised before the buffer is touched.
+    S21BasicMatrix result(expr.Self(), resource_);
+    this->MemoryDeallocating();
+    MoveMatrix(result);
+  } else if (rows_ == expr.GetRows() && cols_ == expr.GetCols()) {
+    // Same shape: evaluated in place, through a copy when the expression
+    // reads this matrix in another layout (see EvaluateExpr).
+    EvaluateExpr(expr.Self(), [](T, T value) { return value; });
+  } else {
+    // A differently shaped expression cannot reference *this.
+    S21BasicMatrix result(expr, resource_);
+    this->MemoryDeallocating();
+    MoveMatrix(result);
+  }
+  return *this;
+}
+
+template <typename T>
+template <typename E>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator+(
+    const S21MatrixExpr<E>& other) && {
+  *this += other;
+  return std::move(*this);
+}
+
+template <typename T>
+template <typename E>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator-(
+    const S21MatrixExpr<E>& other) && {
+  *this -= other;
+  return std::move(*this);
+}
+
+template <typename T>
+template <typename E>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator+=(
+    const S21MatrixExpr<E>& expr) {
+  if (rows_ != expr.GetRows() || cols_ != expr.GetCols()) {
+    throw std::out_of_range("Different size of matrix");
+  }
+  EvaluateExpr(expr.Self(), [](T lhs, T rhs) { return lhs + rhs; });
+  return *this;
+}
+
+template <typename T>
+template <typename E>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator-=(
+    const S21MatrixExpr<E>& expr) {
+  if (rows_ != expr.GetRows() || cols_ != expr.GetCols()) {
+    throw std::out_of_range("Different size of matrix");
+  }
+  EvaluateExpr(expr.Self(), [](T lhs, T rhs) { return lhs - rhs; });
+  return *this;
+}
+
+template <typename T>
+template <typename E, typename Op>
+void S21BasicMatrix<T>::EvaluateExpr(const E& expr, Op op) {
+  ++version_;
+  // Element (i, j) is read just before it is written, which is safe for
+  // operands laid out like this matrix but not for, say, its transpose.
+  if (S21ExprAliases(expr, S21BasicMatrixView<const T>(*this))) {
+    S21BasicMatrix operand(resource_);
+    operand = expr;
+    EvaluateExpr(operand, op);
+  } else if (this->ExistMatrix()) {
+    for (int i = 0; i < rows_; ++i) {
+      T* row = Row(i);
+      for (int j = 0; j < cols_; ++j) {
+        row[j] = op(row[j], expr.Coeff(i, j));
+      }
+    }
+  }
+}
+
+template <typename T>
+void swap(S21BasicMatrix<T>& first, S21BasicMatrix<T>& second) noexcept {
+  first.Swap(second);
+}
+
 #endif  // SRC_S21_MATRIX_OOP_H_
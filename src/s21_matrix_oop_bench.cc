@@ -0,0 +1,1073 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "s21_fixed_matrix.h"
+#include "s21_incremental.h"
+#include "s21_matrix_async.h"
+#include "s21_matrix_batch.h"
+#include "s21_matrix_io.h"
+#include "s21_matrix_oop.h"
+#include "s21_memory.h"
+#include "s21_out_of_core.h"
+#include "s21_sparse.h"
+#include "s21_stats.h"
+#include "s21_strassen.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+template <typename T>
+void FillMatrix(S21BasicMatrix<T>& matrix) {
+  for (int i = 0; i < matrix.GetRows(); ++i) {
+    for (int j = 0; j < matrix.GetCols(); ++j) {
+      matrix[i][j] = static_cast<T>((i * 7 + j * 13) % 17) - T(8);
+    }
+  }
+}
+
+void SetFlopCounter(benchmark::State& state, double flops_per_iteration) {
+  state.counters["FLOPS"] =
+      benchmark::Counter(flops_per_iteration,
+                         benchmark::Counter::kIsIterationInvariantRate,
+                         benchmark::Counter::kIs1000);
+}
+
+// One benchmark per S21Matrix operation, each over the shapes of
+// MatrixShapes: square sizes from a few cache lines to beyond L2, plus a
+// wide and a tall matrix. These are the ones a baseline is worth keeping
+// for; make bench compares them with it.
+void MatrixShapes(benchmark::internal::Benchmark* bench) {
+  for (int n : {4, 16, 64, 256, 1024}) bench->Args({n, n});
+  bench->Args({16, 4096});
+  bench->Args({4096, 16});
+}
+
+void SquareShapes(benchmark::internal::Benchmark* bench, int largest) {
+  for (int n = 4; n <= largest; n *= 4) bench->Args({n, n});
+}
+
+void SetElementCounters(benchmark::State& state, int rows, int cols,
+                        int passes) {
+  state.SetItemsProcessed(state.iterations() * rows * cols);
+  state.SetBytesProcessed(state.iterations() * passes * sizeof(double) *
+                          rows * cols);
+}
+
+void BM_Construct(benchmark::State& state) {
+  const int rows = static_cast<int>(state.range(0));
+  const int cols = static_cast<int>(state.range(1));
+  for (auto _ : state) {
+    S21Matrix matrix(rows, cols);
+    benchmark::DoNotOptimize(matrix.data());
+  }
+  SetElementCounters(state, rows, cols, 1);
+}
+
+void BM_Copy(benchmark::State& state) {
+  const int rows = static_cast<int>(state.range(0));
+  const int cols = static_cast<int>(state.range(1));
+  S21Matrix matrix(rows, cols);
+  FillMatrix(matrix);
+  for (auto _ : state) {
+    S21Matrix copy(matrix);
+    benchmark::DoNotOptimize(copy.data());
+  }
+  SetElementCounters(state, rows, cols, 2);
+}
+
+// A move there and back, so the matrix keeps its buffer across iterations.
+void BM_Move(benchmark::State& state) {
+  const int rows = static_cast<int>(state.range(0));
+  const int cols = static_cast<int>(state.range(1));
+  S21Matrix matrix(rows, cols);
+  for (auto _ : state) {
+    S21Matrix moved(std::move(matrix));
+    matrix = std::move(moved);
+    benchmark::DoNotOptimize(matrix.data());
+  }
+}
+
+void BM_SumMatrix(benchmark::State& state) {
+  const int rows = static_cast<int>(state.range(0));
+  const int cols = static_cast<int>(state.range(1));
+  S21Matrix a(rows, cols), b(rows, cols);
+  FillMatrix(a);
+  FillMatrix(b);
+  for (auto _ : state) {
+    a.SumMatrix(b);
+    benchmark::DoNotOptimize(a.data());
+  }
+  SetElementCounters(state, rows, cols, 3);
+}
+
+// By -1, so the values neither grow nor vanish over the iterations.
+void BM_MulNumber(benchmark::State& state) {
+  const int rows = static_cast<int>(state.range(0));
+  const int cols = static_cast<int>(state.range(1));
+  S21Matrix a(rows, cols);
+  FillMatrix(a);
+  for (auto _ : state) {
+    a.MulNumber(-1.0);
+    benchmark::DoNotOptimize(a.data());
+  }
+  SetElementCounters(state, rows, cols, 2);
+}
+
+// rows x cols times cols x rows, result allocation included.
+void BM_MulMatrix(benchmark::State& state) {
+  const int rows = static_cast<int>(state.range(0));
+  const int cols = static_cast<int>(state.range(1));
+  S21Matrix a(rows, cols), b(cols, rows);
+  FillMatrix(a);
+  FillMatrix(b);
+  for (auto _ : state) {
+    S21Matrix product = a * b;
+    benchmark::DoNotOptimize(product.data());
+  }
+  SetFlopCounter(state, 2.0 * rows * rows * cols);
+}
+
+void BM_Transpose(benchmark::State& state) {
+  const int rows = static_cast<int>(state.range(0));
+  const int cols = static_cast<int>(state.range(1));
+  S21Matrix a(rows, cols);
+  FillMatrix(a);
+  for (auto _ : state) {
+    S21Matrix transposed = a.Transpose();
+    benchmark::DoNotOptimize(transposed.data());
+  }
+  SetElementCounters(state, rows, cols, 2);
+}
+
+// Diagonally dominant, so far from singular at every size.
+S21Matrix RegularMatrix(int n) {
+  S21Matrix a(n, n);
+  FillMatrix(a);
+  for (int i = 0; i < n; ++i) a(i, i) += 8 * n;
+  return a;
+}
+
+void BM_CalcComplements(benchmark::State& state) {
+  S21Matrix a = RegularMatrix(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    S21Matrix complements = a.CalcComplements();
+    benchmark::DoNotOptimize(complements.data());
+  }
+}
+
+void BM_InverseMatrix(benchmark::State& state) {
+  S21Matrix a = RegularMatrix(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    S21Matrix inverse = a.InverseMatrix();
+    benchmark::DoNotOptimize(inverse.data());
+  }
+}
+
+// A * A^T + n * I: symmetric positive definite, like a covariance matrix.
+S21Matrix CovarianceMatrix(int n) {
+  S21Matrix a(n, n);
+  FillMatrix(a);
+  S21Matrix covariance = a * a.Transpose();
+  for (int i = 0; i < n; ++i) covariance(i, i) += n;
+  return covariance;
+}
+
+// Inverting a covariance matrix through LU (range(1) == 0) and through the
+// Cholesky factorisation kAuto picks for it (range(1) == 1).
+void BM_InverseCovariance(benchmark::State& state) {
+  const S21Matrix a = CovarianceMatrix(static_cast<int>(state.range(0)));
+  const S21MatrixStructure structure = state.range(1)
+                                           ? S21MatrixStructure::kAuto
+                                           : S21MatrixStructure::kGeneral;
+  for (auto _ : state) {
+    S21Matrix inverse = a.InverseMatrix(structure);
+    benchmark::DoNotOptimize(inverse.data());
+  }
+}
+
+void BM_DeterminantCovariance(benchmark::State& state) {
+  const S21Matrix a = CovarianceMatrix(static_cast<int>(state.range(0)));
+  const S21MatrixStructure structure = state.range(1)
+                                           ? S21MatrixStructure::kAuto
+                                           : S21MatrixStructure::kGeneral;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.Determinant(structure));
+  }
+}
+
+// Fitting range(1) coefficients to range(0) observations
+void BM_LeastSquares(benchmark::State& state) {
+  const int rows = static_cast<int>(state.range(0));
+  const int cols = static_cast<int>(state.range(1));
+  S21Matrix a(rows, cols), b(rows, 1);
+  FillMatrix(a);
+  FillMatrix(b);
+  for (int j = 0; j < cols; ++j) a(j, j) += rows;
+  for (auto _ : state) {
+    S21Matrix x = a.LeastSquares(b);
+    benchmark::DoNotOptimize(x.data());
+  }
+  SetFlopCounter(state, 2.0 * cols * cols * (rows - cols / 3.0));
+}
+
+// Doubling and restoring the row count; the new rows are zeroed.
+void BM_SetRows(benchmark::State& state) {
+  const int rows = static_cast<int>(state.range(0));
+  const int cols = static_cast<int>(state.range(1));
+  S21Matrix a(rows, cols);
+  FillMatrix(a);
+  for (auto _ : state) {
+    a.SetRows(2 * rows);
+    a.SetRows(rows);
+    benchmark::DoNotOptimize(a.data());
+  }
+}
+
+void BM_SetCols(benchmark::State& state) {
+  const int rows = static_cast<int>(state.range(0));
+  const int cols = static_cast<int>(state.range(1));
+  S21Matrix a(rows, cols);
+  FillMatrix(a);
+  for (auto _ : state) {
+    a.SetCols(2 * cols);
+    a.SetCols(cols);
+    benchmark::DoNotOptimize(a.data());
+  }
+}
+
+// Summing every element four ways: through the checked operator(), the
+// unchecked accessor, the flat iterator and std::accumulate over rows.
+void BM_SumChecked(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a(n, n);
+  FillMatrix(a);
+  for (auto _ : state) {
+    double sum = 0;
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) sum += a(i, j);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  SetElementCounters(state, n, n, 1);
+}
+
+void BM_SumUnchecked(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a(n, n);
+  FillMatrix(a);
+  for (auto _ : state) {
+    double sum = 0;
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) sum += a.at_unchecked(i, j);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  SetElementCounters(state, n, n, 1);
+}
+
+void BM_SumIterator(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a(n, n);
+  FillMatrix(a);
+  for (auto _ : state) {
+    double sum = 0;
+    for (double element : a) sum += element;
+    benchmark::DoNotOptimize(sum);
+  }
+  SetElementCounters(state, n, n, 1);
+}
+
+void BM_SumRows(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a(n, n);
+  FillMatrix(a);
+  for (auto _ : state) {
+    double sum = 0;
+    for (int i = 0; i < n; ++i) {
+      sum = std::accumulate(a.RowBegin(i), a.RowEnd(i), sum);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  SetElementCounters(state, n, n, 1);
+}
+
+// std::copy of every row against a memcpy of the whole buffer
+void BM_CopyRows(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a(n, n), b(n, n);
+  FillMatrix(a);
+  for (auto _ : state) {
+    for (int i = 0; i < n; ++i) {
+      std::copy(a.RowBegin(i), a.RowEnd(i), b.RowBegin(i));
+    }
+    benchmark::DoNotOptimize(b.data());
+  }
+  SetElementCounters(state, n, n, 2);
+}
+
+void BM_CopyMemcpy(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a(n, n), b(n, n);
+  FillMatrix(a);
+  for (auto _ : state) {
+    std::memcpy(b.data(), a.data(), sizeof(double) * n * n);
+    benchmark::DoNotOptimize(b.data());
+  }
+  SetElementCounters(state, n, n, 2);
+}
+
+// The i-j-k triple loop MulMatrix used before the blocked kernel, kept as the
+// reference point for the GFLOP/s comparison.
+void NaiveMulMatrix(const S21Matrix& a, const S21Matrix& b, S21Matrix& c) {
+  const double* a_data = a.data();
+  const double* b_data = b.data();
+  double* c_data = c.data();
+  for (int i = 0; i < a.GetRows(); ++i) {
+    for (int j = 0; j < b.GetCols(); ++j) {
+      double sum = 0;
+      for (int k = 0; k < a.GetCols(); ++k) {
+        sum += a_data[i * a.stride() + k] * b_data[k * b.stride() + j];
+      }
+      c_data[i * c.stride() + j] = sum;
+    }
+  }
+}
+
+void BM_MulMatrixNaive(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a(n, n), b(n, n), c(n, n);
+  FillMatrix(a);
+  FillMatrix(b);
+  for (auto _ : state) {
+    NaiveMulMatrix(a, b, c);
+    benchmark::DoNotOptimize(c.data());
+    benchmark::ClobberMemory();
+  }
+  SetFlopCounter(state, 2.0 * n * n * n);
+}
+
+void BM_Gemm(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a(n, n), b(n, n), c(n, n);
+  FillMatrix(a);
+  FillMatrix(b);
+  for (auto _ : state) {
+    S21Matrix::Gemm(1.0, a, b, 0.0, c);
+    benchmark::DoNotOptimize(c.data());
+    benchmark::ClobberMemory();
+  }
+  SetFlopCounter(state, 2.0 * n * n * n);
+}
+
+// Twice the lanes of BM_Gemm per register, at half the bytes per element.
+void BM_GemmFloat(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21BasicMatrix<float> a(n, n), b(n, n), c(n, n);
+  FillMatrix(a);
+  FillMatrix(b);
+  for (auto _ : state) {
+    S21BasicMatrix<float>::Gemm(1.0f, a, b, 0.0f, c);
+    benchmark::DoNotOptimize(c.data());
+    benchmark::ClobberMemory();
+  }
+  SetFlopCounter(state, 2.0 * n * n * n);
+}
+
+// float operands widened while packed, double accumulation.
+void BM_GemmMixed(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21BasicMatrix<float> a(n, n), b(n, n);
+  FillMatrix(a);
+  FillMatrix(b);
+  for (auto _ : state) {
+    S21Matrix c = S21MulMatrixMixed(a, b);
+    benchmark::DoNotOptimize(c.data());
+    benchmark::ClobberMemory();
+  }
+  SetFlopCounter(state, 2.0 * n * n * n);
+}
+
+// An n x n product classically (range(1) == 0) and through Strassen-Winograd
+// with crossover range(1). A crossover of n - 1 is a single level over the
+// classical kernel, so the smallest n at which that wins is where the
+// default crossover of s21_strassen.cc should sit.
+void BM_MulMatrixStrassen(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  const int crossover = static_cast<int>(state.range(1));
+  S21Matrix a(n, n), b(n, n);
+  FillMatrix(a);
+  FillMatrix(b);
+  S21SetMulAlgorithm(crossover ? S21MulAlgorithm::kStrassen
+                               : S21MulAlgorithm::kClassical);
+  S21SetStrassenCrossover(crossover);
+  for (auto _ : state) {
+    S21Matrix product = a * b;
+    benchmark::DoNotOptimize(product.data());
+  }
+  S21SetMulAlgorithm(S21MulAlgorithm::kClassical);
+  S21SetStrassenCrossover(0);
+  SetFlopCounter(state, 2.0 * n * n * n);
+}
+
+void StrassenArgs(benchmark::internal::Benchmark* bench) {
+  for (int n : {256, 384, 512, 768, 1024, 1536, 2048}) {
+    bench->Args({n, 0});
+    bench->Args({n, n - 1});
+  }
+  bench->Args({2048, 256});
+  bench->Args({2048, 512});
+  bench->Args({4096, 0});
+  bench->Args({4096, 256});
+}
+
+// kAsyncRequests independent (A * B)^T + C of size range(0), one after the
+// other (range(1) == 0) or as one task graph (range(1) == 1)
+constexpr int kAsyncRequests = 16;
+
+void BM_AsyncRequests(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a(n, n), b(n, n), c(n, n);
+  FillMatrix(a);
+  FillMatrix(b);
+  FillMatrix(c);
+  const S21MatrixFuture a_future = S21MakeReadyFuture(a);
+  const S21MatrixFuture b_future = S21MakeReadyFuture(b);
+  const S21MatrixFuture c_future = S21MakeReadyFuture(c);
+  for (auto _ : state) {
+    if (state.range(1)) {
+      std::vector<S21MatrixFuture> results;
+      for (int request = 0; request < kAsyncRequests; ++request) {
+        results.push_back(S21SumMatrixAsync(
+            S21TransposeAsync(S21MulMatrixAsync(a_future, b_future)),
+            c_future));
+      }
+      for (const S21MatrixFuture& result : results) {
+        benchmark::DoNotOptimize(result.Get().data());
+      }
+    } else {
+      for (int request = 0; request < kAsyncRequests; ++request) {
+        S21Matrix result = (a * b).Transpose() + c;
+        benchmark::DoNotOptimize(result.data());
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kAsyncRequests);
+}
+
+// A rank-1 update of an n x n matrix followed by a query for its inverse
+// and determinant, recomputed from scratch (range(1) == 0) or kept by
+// S21IncrementalInverse (range(1) == 1). The updates alternate in sign so
+// the matrix stays well conditioned.
+void BM_IncrementalRankOne(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix matrix(n, n);
+  FillMatrix(matrix);
+  for (int i = 0; i < n; ++i) matrix[i][i] += 4 * n;
+  std::vector<double> u(n), v(n);
+  for (int i = 0; i < n; ++i) {
+    u[i] = (i % 5) * 0.25 - 0.5;
+    v[i] = (i % 3) * 0.5 - 0.5;
+  }
+  S21IncrementalInverse incremental(matrix);
+  incremental.Refactor();
+  for (auto _ : state) {
+    for (double& element : u) element = -element;
+    if (state.range(1)) {
+      incremental.RankOneUpdate(u, v);
+      benchmark::DoNotOptimize(incremental.Determinant());
+      benchmark::DoNotOptimize(incremental.Inverse().data());
+    } else {
+      for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) matrix[i][j] += u[i] * v[j];
+      }
+      const S21Matrix& read = matrix;
+      benchmark::DoNotOptimize(read.Determinant());
+      const S21Matrix inverse = read.InverseMatrix();
+      benchmark::DoNotOptimize(inverse.data());
+    }
+  }
+  state.counters["refactors"] = incremental.GetRefactorCount();
+}
+
+// range(0) rows of kAppendCols streamed into an empty matrix through
+// AppendRow (range(1) == 0), through AppendRow after Reserve (1), or by
+// SetRows one row at a time (2), which reallocates on every row
+constexpr int kAppendCols = 8;
+
+void BM_AppendRows(benchmark::State& state) {
+  const int rows = static_cast<int>(state.range(0));
+  std::vector<double> row(kAppendCols);
+  for (auto _ : state) {
+    S21Matrix matrix;
+    if (state.range(1) == 1) matrix.Reserve(rows, kAppendCols);
+    for (int i = 0; i < rows; ++i) {
+      row[0] = i;
+      if (state.range(1) == 2) {
+        if (i == 0) {
+          matrix = S21Matrix(1, kAppendCols);
+        } else {
+          matrix.SetRows(i + 1);
+        }
+        std::copy(row.begin(), row.end(), matrix[i]);
+      } else {
+        matrix.AppendRow(row);
+      }
+    }
+    benchmark::DoNotOptimize(matrix.data());
+  }
+  state.SetItemsProcessed(state.iterations() * rows);
+}
+
+void BM_Determinant(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a(n, n);
+  FillMatrix(a);
+  for (int i = 0; i < n; ++i) a(i, i) += n;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.Determinant());
+  }
+  state.SetComplexityN(n);
+}
+
+// a + b - c * 2.0 through the eager member functions: three passes over
+// memory and a copy, as the operators did before expression templates.
+void BM_ExpressionEager(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a(n, n), b(n, n), c(n, n);
+  FillMatrix(a);
+  FillMatrix(b);
+  FillMatrix(c);
+  for (auto _ : state) {
+    S21Matrix result(a);
+    S21Matrix scaled(c);
+    result.SumMatrix(b);
+    scaled.MulNumber(2.0);
+    result.SubMatrix(scaled);
+    benchmark::DoNotOptimize(result.data());
+  }
+  state.SetBytesProcessed(state.iterations() * 4 * sizeof(double) * n * n);
+}
+
+void BM_ExpressionFused(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a(n, n), b(n, n), c(n, n), result(n, n);
+  FillMatrix(a);
+  FillMatrix(b);
+  FillMatrix(c);
+  for (auto _ : state) {
+    result = a + b - c * 2.0;
+    benchmark::DoNotOptimize(result.data());
+  }
+  state.SetBytesProcessed(state.iterations() * 4 * sizeof(double) * n * n);
+}
+
+// 4x4 transform chain: multiply, then invert, through both matrix types
+// and, for S21Matrix, with the default resource and with a pool.
+void RunTransform4(benchmark::State& state,
+                   std::pmr::memory_resource* resource) {
+  S21Matrix a(4, 4, resource), b(4, 4, resource);
+  FillMatrix(a);
+  FillMatrix(b);
+  for (int i = 0; i < 4; ++i) a(i, i) += 20;
+  for (auto _ : state) {
+    S21Matrix product = a * b;
+    benchmark::DoNotOptimize(product.Determinant());
+    S21Matrix inverse = a.InverseMatrix();
+    benchmark::DoNotOptimize(inverse.data());
+  }
+}
+
+void BM_Transform4Dynamic(benchmark::State& state) {
+  RunTransform4(state, std::pmr::get_default_resource());
+}
+
+void BM_Transform4Pool(benchmark::State& state) {
+  S21PoolResource pool;
+  RunTransform4(state, &pool);
+}
+
+void BM_Transform4Fixed(benchmark::State& state) {
+  S21Matrix a_dynamic(4, 4), b_dynamic(4, 4);
+  FillMatrix(a_dynamic);
+  FillMatrix(b_dynamic);
+  for (int i = 0; i < 4; ++i) a_dynamic(i, i) += 20;
+  S21FixedMatrix<4, 4> a(a_dynamic), b(b_dynamic);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    S21FixedMatrix<4, 4> product = a * b;
+    benchmark::DoNotOptimize(product.Determinant());
+    S21FixedMatrix<4, 4> inverse = a.InverseMatrix();
+    benchmark::DoNotOptimize(inverse);
+  }
+}
+
+// The same 4x4 chain over range(0) matrices: one S21Matrix at a time, and
+// all of them at once through S21MatrixBatch.
+void BM_Transform4Loop(benchmark::State& state) {
+  const int count = static_cast<int>(state.range(0));
+  std::vector<S21Matrix> a(count, S21Matrix(4, 4)), b(count, S21Matrix(4, 4));
+  for (int index = 0; index < count; ++index) {
+    FillMatrix(a[index]);
+    FillMatrix(b[index]);
+    for (int i = 0; i < 4; ++i) a[index](i, i) += 20 + index % 7;
+  }
+  for (auto _ : state) {
+    for (int index = 0; index < count; ++index) {
+      S21Matrix product = a[index] * b[index];
+      benchmark::DoNotOptimize(product.Determinant());
+      S21Matrix inverse = a[index].InverseMatrix();
+      benchmark::DoNotOptimize(inverse.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+void BM_Transform4Batch(benchmark::State& state) {
+  const int count = static_cast<int>(state.range(0));
+  S21MatrixBatch a(count, 4, 4), b(count, 4, 4);
+  S21Matrix base(4, 4);
+  FillMatrix(base);
+  for (int index = 0; index < count; ++index) {
+    S21Matrix matrix = base;
+    for (int i = 0; i < 4; ++i) matrix(i, i) += 20 + index % 7;
+    a.Set(index, matrix.View());
+    b.Set(index, base.View());
+  }
+  S21MatrixBatch product(count, 4, 4);
+  for (auto _ : state) {
+    product = a;
+    product.MulMatrix(b);
+    benchmark::DoNotOptimize(product.Determinant().data());
+    S21MatrixBatch inverse = a.InverseMatrix();
+    benchmark::DoNotOptimize(inverse.data());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+// n x n with about density_per_mille nonzeros per thousand elements,
+// scattered by a multiplicative hash.
+S21SparseMatrix SparseInput(int n, int density_per_mille) {
+  S21SparseMatrix matrix(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      const unsigned hash = (i * 2654435761u) ^ (j * 40503u + 97u);
+      if (static_cast<int>(hash % 1000u) < density_per_mille) {
+        matrix.Insert(i, j, static_cast<double>(hash % 17u) - 8.0);
+      }
+    }
+  }
+  return matrix.Convert(S21SparseFormat::kCsr);
+}
+
+// A (2048 x 2048, range(0) nonzeros per mille) times a dense 2048 x
+// range(1) block, sparse and dense; range(1) = 1 is the SpMV case.
+void BM_SpMMSparse(benchmark::State& state) {
+  const int n = 2048;
+  const S21SparseMatrix a = SparseInput(n, static_cast<int>(state.range(0)));
+  S21Matrix b(n, static_cast<int>(state.range(1)));
+  FillMatrix(b);
+  for (auto _ : state) {
+    S21Matrix c = a * b;
+    benchmark::DoNotOptimize(c.data());
+  }
+  state.counters["nnz"] = static_cast<double>(a.GetNonZeros());
+  SetFlopCounter(state, 2.0 * a.GetNonZeros() * b.GetCols());
+}
+
+void BM_SpMMDense(benchmark::State& state) {
+  const int n = 2048;
+  S21Matrix a =
+      SparseInput(n, static_cast<int>(state.range(0))).ToDense();
+  S21Matrix b(n, static_cast<int>(state.range(1)));
+  FillMatrix(b);
+  S21Matrix c(n, b.GetCols());
+  for (auto _ : state) {
+    S21Matrix::Gemm(1.0, a, b, 0.0, c);
+    benchmark::DoNotOptimize(c.data());
+  }
+  SetFlopCounter(state, 2.0 * n * n * b.GetCols());
+}
+
+// Saving and loading an n x n matrix, against writing and parsing it as
+// text element by element.
+std::string BenchFile() {
+  return (std::filesystem::temp_directory_path() / "s21_bench.s21m").string();
+}
+
+void BM_SaveText(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix matrix(n, n);
+  FillMatrix(matrix);
+  for (auto _ : state) {
+    std::ofstream stream(BenchFile());
+    stream.precision(17);
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) stream << matrix(i, j) << ' ';
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * n * n * sizeof(double));
+  std::remove(BenchFile().c_str());
+}
+
+void BM_LoadText(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  {
+    S21Matrix matrix(n, n);
+    FillMatrix(matrix);
+    std::ofstream stream(BenchFile());
+    for (int i = 0; i < n * n; ++i) stream << matrix.data()[i] << ' ';
+  }
+  for (auto _ : state) {
+    S21Matrix matrix(n, n);
+    std::ifstream stream(BenchFile());
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) stream >> matrix(i, j);
+    }
+    benchmark::DoNotOptimize(matrix.data());
+  }
+  state.SetBytesProcessed(state.iterations() * n * n * sizeof(double));
+  std::remove(BenchFile().c_str());
+}
+
+void BM_SaveMatrix(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix matrix(n, n);
+  FillMatrix(matrix);
+  for (auto _ : state) S21SaveMatrix(matrix, BenchFile());
+  state.SetBytesProcessed(state.iterations() * n * n * sizeof(double));
+  std::remove(BenchFile().c_str());
+}
+
+void BM_LoadMatrix(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  {
+    S21Matrix matrix(n, n);
+    FillMatrix(matrix);
+    S21SaveMatrix(matrix, BenchFile());
+  }
+  for (auto _ : state) {
+    S21Matrix matrix = S21LoadMatrix(BenchFile(), state.range(1) != 0);
+    benchmark::DoNotOptimize(matrix.data());
+  }
+  state.SetBytesProcessed(state.iterations() * n * n * sizeof(double));
+  std::remove(BenchFile().c_str());
+}
+
+// Mapping and summing every element, so that every page is touched.
+void BM_MapMatrix(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  {
+    S21Matrix matrix(n, n);
+    FillMatrix(matrix);
+    S21SaveMatrix(matrix, BenchFile());
+  }
+  for (auto _ : state) {
+    const S21MappedMatrix mapped(BenchFile());
+    double sum = 0;
+    for (std::ptrdiff_t i = 0; i < std::ptrdiff_t{n} * n; ++i) {
+      sum += mapped.data()[i];
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() * n * n * sizeof(double));
+  std::remove(BenchFile().c_str());
+}
+
+// Out-of-core operations on n x n files with a budget of a quarter of one
+// operand, so every operand is streamed through several times. The files
+// sit in the page cache after the first iteration; the bytes counter is the
+// data the operation reads and writes, not the disk traffic.
+std::string OutOfCoreFile(const char* name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+void SaveOutOfCoreInputs(int n) {
+  S21Matrix matrix(n, n);
+  FillMatrix(matrix);
+  S21SaveMatrix(matrix, OutOfCoreFile("s21_bench_a.s21m"));
+  S21SaveMatrix(matrix, OutOfCoreFile("s21_bench_b.s21m"));
+  S21SetOutOfCoreBudget(sizeof(double) * n * n / 4);
+}
+
+void RemoveOutOfCoreFiles() {
+  S21SetOutOfCoreBudget(0);
+  for (const char* name :
+       {"s21_bench_a.s21m", "s21_bench_b.s21m", "s21_bench_c.s21m"}) {
+    std::remove(OutOfCoreFile(name).c_str());
+  }
+}
+
+void BM_OutOfCoreMul(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  SaveOutOfCoreInputs(n);
+  {
+    const S21OutOfCoreMatrix a(OutOfCoreFile("s21_bench_a.s21m"));
+    const S21OutOfCoreMatrix b(OutOfCoreFile("s21_bench_b.s21m"));
+    for (auto _ : state) {
+      a.MulMatrix(b, OutOfCoreFile("s21_bench_c.s21m"));
+    }
+  }
+  SetFlopCounter(state, 2.0 * n * n * n);
+  RemoveOutOfCoreFiles();
+}
+
+void BM_OutOfCoreTranspose(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  SaveOutOfCoreInputs(n);
+  {
+    const S21OutOfCoreMatrix a(OutOfCoreFile("s21_bench_a.s21m"));
+    for (auto _ : state) a.Transpose(OutOfCoreFile("s21_bench_c.s21m"));
+  }
+  state.SetBytesProcessed(state.iterations() * 2 * n * n * sizeof(double));
+  RemoveOutOfCoreFiles();
+}
+
+void BM_OutOfCoreSum(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  SaveOutOfCoreInputs(n);
+  {
+    S21OutOfCoreMatrix a(OutOfCoreFile("s21_bench_a.s21m"));
+    const S21OutOfCoreMatrix b(OutOfCoreFile("s21_bench_b.s21m"));
+    for (auto _ : state) a.SumMatrix(b);
+  }
+  state.SetBytesProcessed(state.iterations() * 3 * n * n * sizeof(double));
+  RemoveOutOfCoreFiles();
+}
+
+// Runs op with the given thread count and reports its speedup over the
+// single-threaded run of the same benchmark and size, which is registered
+// (and therefore run) first.
+template <typename Op>
+void RunScaling(benchmark::State& state, const char* name, Op op) {
+  static std::map<std::pair<const char*, long>, double> single_thread_time;
+  const long n = static_cast<long>(state.range(0));
+  const int threads = static_cast<int>(state.range(1));
+  S21SetThreadCount(threads);
+  double seconds = 0;
+  for (auto _ : state) {
+    const auto start = std::chrono::steady_clock::now();
+    op();
+    seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                             start)
+                   .count();
+  }
+  S21SetThreadCount(0);
+  const double per_iteration = seconds / state.iterations();
+  if (threads == 1) single_thread_time[{name, n}] = per_iteration;
+  const auto baseline = single_thread_time.find({name, n});
+  if (baseline != single_thread_time.end()) {
+    state.counters["speedup"] = baseline->second / per_iteration;
+  }
+}
+
+void BM_GemmThreads(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a(n, n), b(n, n), c(n, n);
+  FillMatrix(a);
+  FillMatrix(b);
+  RunScaling(state, "gemm", [&] {
+    S21Matrix::Gemm(1.0, a, b, 0.0, c);
+    benchmark::DoNotOptimize(c.data());
+  });
+  SetFlopCounter(state, 2.0 * n * n * n);
+}
+
+void BM_InverseThreads(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a(n, n);
+  FillMatrix(a);
+  for (int i = 0; i < n; ++i) a(i, i) += n;
+  RunScaling(state, "inverse", [&] {
+    S21Matrix inverse = a.InverseMatrix();
+    benchmark::DoNotOptimize(inverse.data());
+  });
+}
+
+void BM_SumThreads(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a(n, n), b(n, n);
+  FillMatrix(a);
+  FillMatrix(b);
+  RunScaling(state, "sum", [&] {
+    a.SumMatrix(b);
+    benchmark::DoNotOptimize(a.data());
+  });
+}
+
+// What each hooked operation pays in a make STATS=1 build: one outermost
+// scope, plus a nested one as Gemm inside MulMatrix adds.
+void BM_StatsScope(benchmark::State& state) {
+  const bool nested = state.range(0);
+  for (auto _ : state) {
+    const S21StatsScope scope(S21Operation::kMulMatrix, {64, 64, 64}, 524288);
+    if (nested) {
+      const S21StatsScope inner(S21Operation::kGemm, {64, 64, 64}, 524288);
+    }
+  }
+  S21StatsReset();
+}
+
+// Thread counts 1, 2, 4, ... up to the hardware concurrency.
+void ThreadArgs(benchmark::internal::Benchmark* bench, int size) {
+  const int max_threads =
+      std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  for (int threads = 1; threads < max_threads; threads *= 2) {
+    bench->Args({size, threads});
+  }
+  bench->Args({size, max_threads});
+}
+
+}  // namespace
+
+BENCHMARK(BM_Construct)->Apply(MatrixShapes);
+BENCHMARK(BM_Copy)->Apply(MatrixShapes);
+BENCHMARK(BM_Move)->Apply(MatrixShapes);
+BENCHMARK(BM_SumMatrix)->Apply(MatrixShapes);
+BENCHMARK(BM_MulNumber)->Apply(MatrixShapes);
+BENCHMARK(BM_MulMatrix)
+    ->Apply([](benchmark::internal::Benchmark* bench) {
+      SquareShapes(bench, 256);
+      bench->Args({16, 4096});
+      bench->Args({4096, 16});
+    })
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Transpose)->Apply(MatrixShapes);
+BENCHMARK(BM_CalcComplements)
+    ->RangeMultiplier(4)
+    ->Range(4, 256)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_InverseMatrix)
+    ->RangeMultiplier(4)
+    ->Range(4, 1024)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_InverseCovariance)
+    ->ArgsProduct({{4, 8, 16, 64, 256, 1024}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_DeterminantCovariance)
+    ->ArgsProduct({{8, 64, 256, 1024}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_LeastSquares)
+    ->Args({100, 4})
+    ->Args({1000, 16})
+    ->Args({10000, 64})
+    ->Args({2000, 500})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SetRows)->Apply(MatrixShapes);
+BENCHMARK(BM_SetCols)->Apply(MatrixShapes);
+BENCHMARK(BM_SumChecked)->RangeMultiplier(4)->Range(64, 1024);
+BENCHMARK(BM_SumUnchecked)->RangeMultiplier(4)->Range(64, 1024);
+BENCHMARK(BM_SumIterator)->RangeMultiplier(4)->Range(64, 1024);
+BENCHMARK(BM_SumRows)->RangeMultiplier(4)->Range(64, 1024);
+BENCHMARK(BM_CopyRows)->RangeMultiplier(4)->Range(64, 1024);
+BENCHMARK(BM_CopyMemcpy)->RangeMultiplier(4)->Range(64, 1024);
+
+BENCHMARK(BM_MulMatrixNaive)
+    ->RangeMultiplier(2)
+    ->Range(64, 4096)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Gemm)
+    ->RangeMultiplier(2)
+    ->Range(64, 4096)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GemmFloat)
+    ->RangeMultiplier(2)
+    ->Range(64, 4096)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GemmMixed)
+    ->RangeMultiplier(2)
+    ->Range(64, 4096)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MulMatrixStrassen)
+    ->Apply(StrassenArgs)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_AsyncRequests)
+    ->ArgsProduct({{8, 64, 256}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_IncrementalRankOne)
+    ->ArgsProduct({{16, 64, 256}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_AppendRows)
+    ->Args({1000000, 0})
+    ->Args({1000000, 1})
+    ->Args({10000, 0})
+    ->Args({10000, 2})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Determinant)
+    ->RangeMultiplier(2)
+    ->Range(8, 1024)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity(benchmark::oNCubed);
+
+BENCHMARK(BM_SpMMSparse)
+    ->ArgsProduct({{1, 10, 50, 200}, {1, 16}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SpMMDense)
+    ->ArgsProduct({{1, 10, 50, 200}, {1, 16}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ExpressionEager)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK(BM_ExpressionFused)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK(BM_Transform4Dynamic);
+BENCHMARK(BM_Transform4Pool);
+BENCHMARK(BM_Transform4Fixed);
+BENCHMARK(BM_Transform4Loop)
+    ->RangeMultiplier(16)
+    ->Range(64, 65536)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Transform4Batch)
+    ->RangeMultiplier(16)
+    ->Range(64, 65536)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SaveText)->RangeMultiplier(4)->Range(64, 1024);
+BENCHMARK(BM_LoadText)->RangeMultiplier(4)->Range(64, 1024);
+BENCHMARK(BM_SaveMatrix)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK(BM_LoadMatrix)
+    ->ArgsProduct({benchmark::CreateRange(64, 4096, 4), {0, 1}});
+BENCHMARK(BM_MapMatrix)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK(BM_OutOfCoreMul)
+    ->RangeMultiplier(2)
+    ->Range(512, 2048)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_OutOfCoreTranspose)
+    ->RangeMultiplier(4)
+    ->Range(1024, 4096)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_OutOfCoreSum)
+    ->RangeMultiplier(4)
+    ->Range(1024, 4096)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_GemmThreads)
+    ->Apply([](benchmark::internal::Benchmark* bench) {
+      ThreadArgs(bench, 2048);
+    })
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_InverseThreads)
+    ->Apply([](benchmark::internal::Benchmark* bench) {
+      ThreadArgs(bench, 1024);
+    })
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_SumThreads)
+    ->Apply([](benchmark::internal::Benchmark* bench) {
+      ThreadArgs(bench, 4096);
+    })
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_StatsScope)->Arg(0)->Arg(1);
+
+BENCHMARK_MAIN();
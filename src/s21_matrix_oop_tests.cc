@@ -1,5 +1,62 @@
+#include <algorithm>
+#include <atomic>
+#include <complex>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory_resource>
+#include <new>
+#include <numeric>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
 #include "gtest/gtest.h"
+#include "s21_cholesky.h"
+#include "s21_fixed_matrix.h"
+#include "s21_incremental.h"
+#include "s21_lu.h"
+#include "s21_matrix_async.h"
+#include "s21_matrix_batch.h"
+#include "s21_matrix_io.h"
 #include "s21_matrix_oop.h"
+#include "s21_memory.h"
+#include "s21_out_of_core.h"
+#include "s21_qr.h"
+#include "s21_simd.h"
+#include "s21_sparse.h"
+#include "s21_stats.h"
+#include "s21_strassen.h"
+#include "s21_thread_pool.h"
+
+// Allocation-counting hook: the global operator new is replaced for the
+// test binary, so a test can assert that a block of code never reached the
+// global allocator.
+static std::atomic<long> global_allocations(0);
+
+void *operator new(std::size_t size) {
+  ++global_allocations;
+  if (void *p = std::malloc(size ? size : 1)) return p;
+  throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  ++global_allocations;
+  const auto align = static_cast<std::size_t>(alignment);
+  const std::size_t rounded = (size + align - 1) / align * align;
+  if (void *p = std::aligned_alloc(align, rounded ? rounded : align)) return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept {
+  std::free(p);
+}
 
 TEST(S21Matrix_constructor_suite, true_test) {
   S21Matrix matrix;
@@ -68,6 +125,97 @@ TEST(set_cols_suite, reduce_test) {
   EXPECT_EQ(matrix(2, 1), 7.0);
 }
 
+TEST(capacity_suite, append_row_test) {
+  S21Matrix matrix;
+  matrix.Reserve(100, 3);
+  EXPECT_EQ(matrix.GetRows(), 0);
+  EXPECT_EQ(matrix.GetRowCapacity(), 100);
+  EXPECT_EQ(matrix.GetColCapacity(), 3);
+  const double *buffer = matrix.data();
+  for (int i = 0; i < 100; ++i) matrix.AppendRow({1.0 * i, 2.0 * i, -1});
+  EXPECT_EQ(matrix.data(), buffer);
+  EXPECT_EQ(matrix.GetRows(), 100);
+  EXPECT_EQ(matrix.GetCols(), 3);
+  EXPECT_EQ(matrix(57, 1), 114);
+  // Past the reservation the capacity doubles
+  int reallocations = 0;
+  for (int i = 0; i < 1000; ++i) {
+    matrix.AppendRow({0, 0, 1.0 * i});
+    if (matrix.data() != buffer) ++reallocations;
+    buffer = matrix.data();
+  }
+  EXPECT_LE(reallocations, 4);
+  EXPECT_GE(matrix.GetRowCapacity(), 1100);
+  EXPECT_EQ(matrix(99, 0), 99);
+  EXPECT_EQ(matrix(1099, 2), 999);
+  matrix.ShrinkToFit();
+  EXPECT_EQ(matrix.GetRowCapacity(), 1100);
+  EXPECT_EQ(matrix(1099, 2), 999);
+  ASSERT_THROW(matrix.AppendRow({1, 2}), std::out_of_range);
+  ASSERT_THROW(S21Matrix().AppendRow({}), std::out_of_range);
+}
+
+TEST(capacity_suite, append_col_test) {
+  S21Matrix matrix;
+  matrix.AppendCol({1, 2});
+  matrix.AppendCol({3, 4});
+  matrix.AppendCol({5, 6});
+  EXPECT_EQ(matrix.GetRows(), 2);
+  EXPECT_EQ(matrix.GetCols(), 3);
+  EXPECT_GE(matrix.GetColCapacity(), 3);
+  S21Matrix expected(2, 3);
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < 3; ++j) expected(i, j) = 2 * j + i + 1;
+  }
+  EXPECT_TRUE(matrix == expected);
+  matrix.AppendRow({7, 8, 9});
+  EXPECT_EQ(matrix(2, 1), 8);
+  ASSERT_THROW(matrix.AppendCol({1, 2}), std::out_of_range);
+}
+
+TEST(capacity_suite, resize_test) {
+  S21Matrix matrix(4, 5);
+  matrix.FillingMatrix();
+  const double *buffer = matrix.data();
+  // Shrinking stays in the buffer and leaves the rows padded
+  matrix.Resize(3, 2);
+  EXPECT_EQ(matrix.data(), buffer);
+  EXPECT_EQ(matrix.stride(), 5);
+  EXPECT_EQ(matrix(2, 1), 11);
+  S21Matrix packed(3, 2);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 2; ++j) packed(i, j) = 5 * i + j;
+  }
+  EXPECT_TRUE(matrix == packed);
+  EXPECT_TRUE(matrix.Transpose() == packed.Transpose());
+  EXPECT_TRUE(S21Matrix(matrix) == packed);
+  // Growing back within the capacity zeroes what was cut off
+  matrix.Resize(4, 4);
+  EXPECT_EQ(matrix.data(), buffer);
+  EXPECT_EQ(matrix(0, 1), 1);
+  EXPECT_EQ(matrix(0, 3), 0);
+  EXPECT_EQ(matrix(3, 0), 0);
+  // Past it the new buffer fits the shape exactly
+  matrix.Resize(6, 4);
+  EXPECT_NE(matrix.data(), buffer);
+  EXPECT_EQ(matrix.GetRowCapacity(), 6);
+  EXPECT_EQ(matrix.stride(), 4);
+  EXPECT_EQ(matrix(2, 1), 11);
+  EXPECT_EQ(matrix(5, 3), 0);
+  buffer = matrix.data();
+  matrix.Resize(0, 4);
+  EXPECT_EQ(matrix.GetRows(), 0);
+  EXPECT_EQ(matrix.GetCols(), 0);
+  EXPECT_EQ(matrix.GetRowCapacity(), 6);
+  matrix.Resize(2, 2);
+  EXPECT_EQ(matrix.data(), buffer);
+  EXPECT_EQ(matrix(1, 1), 0);
+  matrix.Resize(0, 0);
+  matrix.ShrinkToFit();
+  EXPECT_EQ(matrix.data(), nullptr);
+  EXPECT_EQ(matrix.GetRowCapacity(), 0);
+}
+
 TEST(EqMatrix_suite, true_test) {
   S21Matrix first_matrix(3, 3);
   S21Matrix second_matrix(3, 3);
@@ -242,6 +390,58 @@ TEST(MulMatrix_suite, exceptional_test) {
   ASSERT_THROW(first_matrix.MulMatrix(second_matrix), std::out_of_range);
 }
 
+TEST(Gemm_suite, alpha_beta_test) {
+  S21Matrix first_matrix(2, 3);
+  S21Matrix second_matrix(3, 2);
+  S21Matrix result(2, 2);
+  first_matrix.FillingMatrix();
+  second_matrix.FillingMatrix();
+  result.FillingMatrix();
+  S21Matrix::Gemm(2.0, first_matrix, second_matrix, -1.0, result);
+  S21Matrix expected_result(2, 2);
+  expected_result(0, 0) = 20;
+  expected_result(0, 1) = 25;
+  expected_result(1, 0) = 54;
+  expected_result(1, 1) = 77;
+  EXPECT_TRUE(result == expected_result);
+}
+
+TEST(Gemm_suite, blocked_true_test) {
+  const int rows = 150, inner = 300, cols = 170;
+  S21Matrix first_matrix(rows, inner);
+  S21Matrix second_matrix(inner, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int k = 0; k < inner; ++k) {
+      first_matrix(i, k) = (i * 3 + k * 5) % 11 - 5;
+    }
+  }
+  for (int k = 0; k < inner; ++k) {
+    for (int j = 0; j < cols; ++j) {
+      second_matrix(k, j) = (k * 7 + j * 2) % 13 - 6;
+    }
+  }
+  S21Matrix expected_result(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      for (int k = 0; k < inner; ++k) {
+        expected_result(i, j) += first_matrix(i, k) * second_matrix(k, j);
+      }
+    }
+  }
+  first_matrix.MulMatrix(second_matrix);
+  EXPECT_TRUE(first_matrix == expected_result);
+}
+
+TEST(Gemm_suite, exceptional_test) {
+  S21Matrix first_matrix(2, 3);
+  S21Matrix second_matrix(3, 2);
+  S21Matrix result(3, 3);
+  ASSERT_THROW(S21Matrix::Gemm(1.0, first_matrix, second_matrix, 0.0, result),
+               std::out_of_range);
+  ASSERT_THROW(S21Matrix::Gemm(1.0, first_matrix, first_matrix, 0.0, result),
+               std::out_of_range);
+}
+
 TEST(Transpose_matrix_suite, true_test) {
   S21Matrix matrix(2, 3);
   S21Matrix expected_result(3, 2);
@@ -256,6 +456,46 @@ TEST(Transpose_matrix_suite, true_test) {
   EXPECT_TRUE(matrix.EqMatrix(expected_result));
 }
 
+TEST(Transpose_matrix_suite, blocked_test) {
+  const int rows = 75, cols = 131;
+  S21Matrix matrix(rows, cols);
+  matrix.FillingMatrix();
+  const S21Matrix result = matrix.Transpose();
+  ASSERT_EQ(result.GetRows(), cols);
+  ASSERT_EQ(result.GetCols(), rows);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      EXPECT_EQ(result.data()[j * result.stride() + i], i * cols + j);
+    }
+  }
+}
+
+TEST(Transpose_matrix_suite, in_place_square_test) {
+  const int size = 70;
+  S21Matrix matrix(size, size);
+  matrix.FillingMatrix();
+  const S21Matrix expected_result = matrix.Transpose();
+  const double *buffer = matrix.data();
+  matrix.TransposeInPlace();
+  EXPECT_EQ(matrix.data(), buffer);
+  EXPECT_TRUE(matrix == expected_result);
+}
+
+TEST(Transpose_matrix_suite, in_place_rectangular_test) {
+  for (int rows : {1, 2, 7, 40}) {
+    for (int cols : {1, 3, 64}) {
+      S21Matrix matrix(rows, cols);
+      matrix.FillingMatrix();
+      const S21Matrix expected_result = matrix.Transpose();
+      matrix.TransposeInPlace();
+      EXPECT_EQ(matrix.GetRows(), cols);
+      EXPECT_EQ(matrix.GetCols(), rows);
+      EXPECT_EQ(matrix.stride(), rows);
+      EXPECT_TRUE(matrix == expected_result);
+    }
+  }
+}
+
 TEST(CalcComplement_suite, four_four_test) {
   S21Matrix matrix(4, 4);
   S21Matrix expected_result(4, 4);
@@ -337,6 +577,40 @@ TEST(Determinant_suite, four_four_test) {
   EXPECT_TRUE(third_matrix.Determinant() == -164000);
 }
 
+TEST(Determinant_suite, lu_true_test) {
+  const int size = 12;
+  S21Matrix matrix(size, size);
+  for (int i = 0; i < size; ++i) {
+    for (int j = 0; j < size; ++j) {
+      matrix(i, j) = (i == j) ? 3 : 2;
+    }
+  }
+  EXPECT_NEAR(matrix.Determinant(), 1 + 2 * size, 1e-9);
+}
+
+TEST(Determinant_suite, lu_pivoting_test) {
+  const int size = 6;
+  S21Matrix matrix(size, size);
+  for (int i = 0; i < size; ++i) {
+    matrix(i, size - 1 - i) = 1;
+  }
+  EXPECT_EQ(matrix.Determinant(), -1);
+  matrix(2, 3) = 0;
+  EXPECT_EQ(matrix.Determinant(), 0);
+}
+
+TEST(Determinant_suite, lu_blocked_test) {
+  const int size = 300;
+  S21Matrix matrix(size, size);
+  for (int i = 0; i < size; ++i) {
+    for (int j = 0; j < size; ++j) {
+      matrix(i, j) = (i == j) ? 1.5 : 0.5;
+    }
+  }
+  // (1.5 - 0.5)^(n - 1) * (1.5 + 0.5 * (n - 1))
+  EXPECT_NEAR(matrix.Determinant(), 1.5 + 0.5 * (size - 1), 1e-8);
+}
+
 TEST(Determinant_suite, exceptional_test) {
   S21Matrix matrix(3, 4);
   matrix.FillingMatrix();
@@ -367,6 +641,631 @@ TEST(InverseMatrix_suite, exceptional_test) {
   ASSERT_THROW(matrix.InverseMatrix(), std::invalid_argument);
 }
 
+TEST(InverseMatrix_suite, large_test) {
+  const int size = 40;
+  S21Matrix matrix(size, size);
+  for (int i = 0; i < size; ++i) {
+    for (int j = 0; j < size; ++j) {
+      matrix(i, j) = (i == j) ? size : (i * 5 + j * 3) % 7 - 3;
+    }
+  }
+  S21Matrix identity(size, size);
+  for (int i = 0; i < size; ++i) {
+    identity(i, i) = 1;
+  }
+  EXPECT_TRUE(matrix * matrix.InverseMatrix() == identity);
+}
+
+TEST(CalcComplement_suite, nonsingular_test) {
+  S21Matrix matrix(3, 3);
+  S21Matrix expected_result(3, 3);
+  matrix(0, 0) = 2;
+  matrix(0, 1) = 5;
+  matrix(0, 2) = 7;
+  matrix(1, 0) = 6;
+  matrix(1, 1) = 3;
+  matrix(1, 2) = 4;
+  matrix(2, 0) = 5;
+  matrix(2, 1) = -2;
+  matrix(2, 2) = -3;
+  matrix = matrix.CalcComplements();
+  expected_result(0, 0) = -1;
+  expected_result(0, 1) = 38;
+  expected_result(0, 2) = -27;
+  expected_result(1, 0) = 1;
+  expected_result(1, 1) = -41;
+  expected_result(1, 2) = 29;
+  expected_result(2, 0) = -1;
+  expected_result(2, 1) = 34;
+  expected_result(2, 2) = -24;
+  EXPECT_TRUE(matrix.EqMatrix(expected_result));
+}
+
+TEST(S21LU_suite, solve_vector_test) {
+  S21Matrix matrix(3, 3);
+  matrix(0, 0) = 0;
+  matrix(0, 1) = 2;
+  matrix(0, 2) = 1;
+  matrix(1, 0) = 1;
+  matrix(1, 1) = 1;
+  matrix(1, 2) = 1;
+  matrix(2, 0) = 4;
+  matrix(2, 1) = -1;
+  matrix(2, 2) = 2;
+  const S21LU lu(matrix);
+  EXPECT_NEAR(lu.Determinant(), matrix.Determinant(), 1e-12);
+  const std::vector<double> x = lu.Solve(std::vector<double>{5, 5, 9});
+  ASSERT_EQ(x.size(), 3u);
+  EXPECT_NEAR(x[0], 1, 1e-12);
+  EXPECT_NEAR(x[1], 1, 1e-12);
+  EXPECT_NEAR(x[2], 3, 1e-12);
+}
+
+TEST(S21LU_suite, solve_matrix_test) {
+  const int size = 10, rhs = 4;
+  S21Matrix matrix(size, size);
+  S21Matrix expected_result(size, rhs);
+  for (int i = 0; i < size; ++i) {
+    for (int j = 0; j < size; ++j) {
+      matrix(i, j) = (i * 7 + j * 3) % 5 + (i == j ? 10 : 0);
+    }
+    for (int j = 0; j < rhs; ++j) {
+      expected_result(i, j) = i - j;
+    }
+  }
+  const S21LU lu(matrix);
+  S21Matrix x = lu.Solve(matrix * expected_result);
+  EXPECT_TRUE(x == expected_result);
+  x = lu.Inverse();
+  EXPECT_TRUE(x == matrix.InverseMatrix());
+}
+
+TEST(S21LU_suite, exceptional_test) {
+  S21Matrix matrix(3, 3);
+  matrix.FillingMatrix();
+  const S21LU lu(matrix);
+  EXPECT_TRUE(lu.IsSingular());
+  EXPECT_EQ(lu.Determinant(), 0);
+  ASSERT_THROW(lu.Inverse(), std::invalid_argument);
+  ASSERT_THROW(lu.Solve(std::vector<double>{1, 2, 3}), std::invalid_argument);
+  ASSERT_THROW(S21LU(S21Matrix(2, 3)), std::out_of_range);
+  S21Matrix identity(2, 2);
+  identity(0, 0) = identity(1, 1) = 1;
+  ASSERT_THROW(S21LU(identity).Solve(S21Matrix(3, 1)), std::out_of_range);
+}
+
+// B * B^T + size * I for an integer B: exactly symmetric and well
+// conditioned, like an assembled covariance matrix.
+S21Matrix CovarianceMatrix(int size) {
+  S21Matrix b(size, size);
+  for (int i = 0; i < size; ++i) {
+    for (int j = 0; j < size; ++j) b(i, j) = (i * 7 + j * 3) % 5 - 2;
+  }
+  S21Matrix covariance = b * b.Transpose();
+  for (int i = 0; i < size; ++i) covariance(i, i) += size;
+  return covariance;
+}
+
+S21Matrix Identity(int size) {
+  S21Matrix identity(size, size);
+  for (int i = 0; i < size; ++i) identity(i, i) = 1;
+  return identity;
+}
+
+TEST(S21Cholesky_suite, factor_test) {
+  const S21Matrix matrix = CovarianceMatrix(10);
+  const S21Cholesky cholesky(matrix);
+  ASSERT_TRUE(cholesky.IsPositiveDefinite());
+  const S21Matrix lower = cholesky.GetL();
+  EXPECT_EQ(lower(0, 1), 0);
+  EXPECT_TRUE(lower * lower.Transpose() == matrix);
+  EXPECT_NEAR(cholesky.Determinant() / S21LU(matrix).Determinant(), 1, 1e-12);
+  S21Matrix expected(10, 2);
+  for (int i = 0; i < 10; ++i) {
+    expected(i, 0) = i;
+    expected(i, 1) = 1 - i;
+  }
+  EXPECT_TRUE(cholesky.Solve(matrix * expected) == expected);
+  const std::vector<double> x =
+      cholesky.Solve(std::vector<double>(10, 1.0));
+  EXPECT_NEAR(x[3], S21LU(matrix).Solve(std::vector<double>(10, 1.0))[3],
+              1e-12);
+  const S21Matrix inverse = cholesky.Inverse();
+  EXPECT_TRUE(matrix * inverse == Identity(10));
+  EXPECT_EQ(inverse(2, 7), inverse(7, 2));
+}
+
+TEST(S21Cholesky_suite, blocked_test) {
+  const int size = 300;
+  const S21Matrix matrix = CovarianceMatrix(size);
+  const S21Cholesky cholesky(matrix);
+  ASSERT_TRUE(cholesky.IsPositiveDefinite());
+  const S21Matrix lower = cholesky.GetL();
+  EXPECT_TRUE(lower * lower.Transpose() == matrix);
+  EXPECT_TRUE(matrix * cholesky.Inverse() == Identity(size));
+  S21Matrix b(size, 3);
+  for (int i = 0; i < size; ++i) b(i, i % 3) = 1;
+  EXPECT_TRUE(cholesky.Solve(b) == S21LU(matrix).Solve(b));
+}
+
+TEST(S21Cholesky_suite, complex_test) {
+  using Complex = std::complex<double>;
+  S21BasicMatrix<Complex> matrix(3, 3);
+  matrix(0, 0) = 4;
+  matrix(0, 1) = Complex(1, 2);
+  matrix(0, 2) = Complex(0, -1);
+  matrix(1, 1) = 6;
+  matrix(1, 2) = Complex(2, 1);
+  matrix(2, 2) = 5;
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < i; ++j) matrix(i, j) = std::conj(matrix(j, i));
+  }
+  const S21BasicCholesky<Complex> cholesky(matrix);
+  ASSERT_TRUE(cholesky.IsPositiveDefinite());
+  const S21BasicMatrix<Complex> lower = cholesky.GetL();
+  S21BasicMatrix<Complex> adjoint = lower.Transpose();
+  for (Complex& element : adjoint) element = std::conj(element);
+  EXPECT_TRUE(lower * adjoint == matrix);
+  S21BasicMatrix<Complex> identity(3, 3);
+  for (int i = 0; i < 3; ++i) identity(i, i) = 1;
+  EXPECT_TRUE(matrix * cholesky.Inverse() == identity);
+  EXPECT_NEAR(std::abs(cholesky.Determinant() -
+                       S21BasicLU<Complex>(matrix).Determinant()),
+              0, 1e-12);
+  EXPECT_TRUE(matrix.InverseMatrix() == cholesky.Inverse());
+}
+
+TEST(S21Cholesky_suite, exceptional_test) {
+  S21Matrix matrix = CovarianceMatrix(6);
+  matrix(4, 4) = -1;
+  const S21Cholesky cholesky(matrix);
+  EXPECT_FALSE(cholesky.IsPositiveDefinite());
+  ASSERT_THROW(cholesky.Determinant(), std::invalid_argument);
+  ASSERT_THROW(cholesky.Inverse(), std::invalid_argument);
+  ASSERT_THROW(cholesky.Solve(std::vector<double>(6)), std::invalid_argument);
+  ASSERT_THROW(S21Cholesky(S21Matrix(2, 3)), std::out_of_range);
+  ASSERT_THROW(S21Cholesky(Identity(2)).Solve(S21Matrix(3, 1)),
+               std::out_of_range);
+}
+
+TEST(S21Cholesky_suite, update_test) {
+  const int size = 8;
+  const S21Matrix matrix = CovarianceMatrix(size);
+  S21Cholesky cholesky(matrix);
+  std::vector<double> x(size);
+  for (int i = 0; i < size; ++i) x[i] = (i % 3) - 1.5;
+  S21Matrix outer(size, size);
+  for (int i = 0; i < size; ++i) {
+    for (int j = 0; j < size; ++j) outer(i, j) = x[i] * x[j];
+  }
+  cholesky.Update(x);
+  EXPECT_TRUE(cholesky.GetL() == S21Cholesky(matrix + outer).GetL());
+  EXPECT_TRUE(cholesky.Downdate(x));
+  EXPECT_TRUE(cholesky.GetL() == S21Cholesky(matrix).GetL());
+  // Taking away more than the matrix holds leaves it indefinite
+  EXPECT_FALSE(cholesky.Downdate(std::vector<double>(size, 10.0)));
+  EXPECT_FALSE(cholesky.IsPositiveDefinite());
+  ASSERT_THROW(cholesky.Update(x), std::invalid_argument);
+  ASSERT_THROW(S21Cholesky(matrix).Update(std::vector<double>(size + 1)),
+               std::out_of_range);
+}
+
+TEST(S21LDLT_suite, indefinite_test) {
+  // Symmetric and indefinite, with nonzero leading minors
+  S21Matrix matrix(3, 3);
+  matrix(0, 0) = 4;
+  matrix(0, 1) = matrix(1, 0) = 2;
+  matrix(0, 2) = matrix(2, 0) = -2;
+  matrix(1, 1) = -3;
+  matrix(1, 2) = matrix(2, 1) = 1;
+  matrix(2, 2) = 5;
+  EXPECT_FALSE(S21Cholesky(matrix).IsPositiveDefinite());
+  const S21LDLT ldlt(matrix);
+  ASSERT_FALSE(ldlt.IsSingular());
+  EXPECT_NEAR(ldlt.Determinant(), S21LU(matrix).Determinant(), 1e-12);
+  const std::vector<double> x = ldlt.Solve(std::vector<double>{4, -2, 9});
+  const std::vector<double> expected =
+      S21LU(matrix).Solve(std::vector<double>{4, -2, 9});
+  for (int i = 0; i < 3; ++i) EXPECT_NEAR(x[i], expected[i], 1e-12);
+  EXPECT_TRUE(matrix * ldlt.Inverse() == Identity(3));
+  S21Matrix swap(2, 2);
+  swap(0, 1) = swap(1, 0) = 1;
+  EXPECT_TRUE(S21LDLT(swap).IsSingular());
+  ASSERT_THROW(S21LDLT(swap).Inverse(), std::invalid_argument);
+}
+
+TEST(S21QR_suite, factor_test) {
+  const int rows = 8, cols = 3;
+  S21Matrix matrix(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) matrix(i, j) = (i * 5 + j * 3) % 7 - 3;
+  }
+  const S21QR qr(matrix);
+  EXPECT_FALSE(qr.IsRankDeficient());
+  const S21Matrix q = qr.GetQ();
+  const S21Matrix r = qr.GetR();
+  EXPECT_EQ(r(2, 0), 0);
+  EXPECT_TRUE(q * r == matrix);
+  EXPECT_TRUE(q.Transpose() * q == Identity(cols));
+}
+
+TEST(S21QR_suite, least_squares_test) {
+  const int rows = 20, cols = 4;
+  S21Matrix matrix(rows, cols);
+  S21Matrix b(rows, 1);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) matrix(i, j) = std::pow(0.1 * i, j);
+    b(i, 0) = std::sin(0.1 * i);
+  }
+  // Against the normal equations, accurate enough at this conditioning
+  const S21Matrix transposed = matrix.Transpose();
+  const S21Matrix expected =
+      S21LU(transposed * matrix).Solve(transposed * b);
+  EXPECT_TRUE(matrix.LeastSquares(b) == expected);
+  // An exact fit is recovered exactly
+  S21Matrix coefficients(cols, 1);
+  for (int j = 0; j < cols; ++j) coefficients(j, 0) = j - 1.5;
+  EXPECT_TRUE(matrix.LeastSquares(matrix * coefficients) == coefficients);
+  const std::vector<double> x = S21QR(matrix).Solve(
+      std::vector<double>(b.begin(), b.end()));
+  EXPECT_NEAR(x[2], expected(2, 0), 1e-9);
+}
+
+TEST(S21QR_suite, complex_test) {
+  using Complex = std::complex<double>;
+  S21BasicMatrix<Complex> matrix(4, 2);
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 2; ++j) matrix(i, j) = Complex(i - j, i * i * j + 1);
+  }
+  const S21BasicQR<Complex> qr(matrix);
+  const S21BasicMatrix<Complex> q = qr.GetQ();
+  EXPECT_TRUE(q * qr.GetR() == matrix);
+  S21BasicMatrix<Complex> adjoint = q.Transpose();
+  for (Complex& element : adjoint) element = std::conj(element);
+  S21BasicMatrix<Complex> identity(2, 2);
+  identity(0, 0) = identity(1, 1) = 1;
+  EXPECT_TRUE(adjoint * q == identity);
+  S21BasicMatrix<Complex> coefficients(2, 1);
+  coefficients(0, 0) = Complex(1, -1);
+  coefficients(1, 0) = Complex(0.5, 2);
+  EXPECT_TRUE(qr.Solve(matrix * coefficients) == coefficients);
+}
+
+TEST(S21QR_suite, exceptional_test) {
+  S21Matrix matrix(4, 2);
+  for (int i = 0; i < 4; ++i) matrix(i, 0) = matrix(i, 1) = i + 1;
+  const S21QR qr(matrix);
+  EXPECT_TRUE(qr.IsRankDeficient());
+  ASSERT_THROW(qr.Solve(S21Matrix(4, 1)), std::invalid_argument);
+  ASSERT_THROW(S21QR(S21Matrix(2, 3)), std::out_of_range);
+  ASSERT_THROW(Identity(3).LeastSquares(S21Matrix(2, 1)), std::out_of_range);
+}
+
+TEST(structure_suite, routing_test) {
+  const S21Matrix covariance = CovarianceMatrix(12);
+  const double det = covariance.Determinant(S21MatrixStructure::kGeneral);
+  EXPECT_NEAR(covariance.Determinant() / det, 1, 1e-12);
+  EXPECT_NEAR(
+      covariance.Determinant(S21MatrixStructure::kPositiveDefinite) / det, 1,
+      1e-12);
+  EXPECT_NEAR(covariance.Determinant(S21MatrixStructure::kSymmetric) / det, 1,
+              1e-12);
+  const S21Matrix inverse =
+      covariance.InverseMatrix(S21MatrixStructure::kGeneral);
+  EXPECT_TRUE(covariance.InverseMatrix() == inverse);
+  EXPECT_TRUE(covariance.InverseMatrix(S21MatrixStructure::kSymmetric) ==
+              inverse);
+  // Symmetric with a positive diagonal but indefinite: Cholesky fails and
+  // kAuto falls back to LU, while the explicit promise is refused.
+  S21Matrix indefinite = Identity(5);
+  indefinite(0, 1) = indefinite(1, 0) = 2;
+  EXPECT_NEAR(indefinite.Determinant(), -3, 1e-12);
+  EXPECT_TRUE(indefinite * indefinite.InverseMatrix() == Identity(5));
+  ASSERT_THROW(indefinite.Determinant(S21MatrixStructure::kPositiveDefinite),
+               std::invalid_argument);
+  ASSERT_THROW(indefinite.InverseMatrix(S21MatrixStructure::kPositiveDefinite),
+               std::invalid_argument);
+  // A zero pivot sends LDL^T back to LU.
+  S21Matrix swap = Identity(5);
+  swap(0, 0) = swap(1, 1) = 0;
+  swap(0, 1) = swap(1, 0) = 1;
+  EXPECT_EQ(swap.Determinant(S21MatrixStructure::kSymmetric), -1);
+  EXPECT_TRUE(swap.InverseMatrix(S21MatrixStructure::kSymmetric) == swap);
+}
+
+// Largest |a - b| over the elements, relative to the largest |b|
+template <typename T>
+double RelativeError(const S21BasicMatrix<T> &a, const S21BasicMatrix<T> &b) {
+  double difference = 0;
+  double largest = 0;
+  for (int i = 0; i < b.GetRows(); ++i) {
+    for (int j = 0; j < b.GetCols(); ++j) {
+      difference = std::max<double>(difference, std::abs(a(i, j) - b(i, j)));
+      largest = std::max<double>(largest, std::abs(b(i, j)));
+    }
+  }
+  return difference / largest;
+}
+
+template <typename T>
+S21BasicMatrix<T> PseudoRandomMatrix(int rows, int cols, int seed) {
+  S21BasicMatrix<T> matrix(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      matrix(i, j) = T(((i * 37 + j * 11 + seed) * 7919 % 2003) / 1001.5 - 1);
+    }
+  }
+  return matrix;
+}
+
+TEST(strassen_suite, config_test) {
+  EXPECT_EQ(S21GetMulAlgorithm(), S21MulAlgorithm::kClassical);
+  const int crossover = S21GetStrassenCrossover();
+  EXPECT_GT(crossover, 0);
+  S21SetStrassenCrossover(16);
+  EXPECT_EQ(S21GetStrassenCrossover(), 16);
+  EXPECT_TRUE(S21StrassenApplies(17, 40, 33));
+  EXPECT_FALSE(S21StrassenApplies(17, 40, 16));
+  EXPECT_EQ(S21StrassenWorkspace<double>(16, 16, 16), 0u);
+  EXPECT_GT(S21StrassenWorkspace<double>(64, 64, 64), 0u);
+  S21SetStrassenCrossover(0);
+  EXPECT_EQ(S21GetStrassenCrossover(), crossover);
+}
+
+TEST(strassen_suite, accuracy_test) {
+  // Odd and non-power-of-two sizes, three levels deep with a crossover of
+  // 16, serial and with the seven products of the top level in parallel.
+  const S21Matrix a = PseudoRandomMatrix<double>(150, 137, 1);
+  const S21Matrix b = PseudoRandomMatrix<double>(137, 161, 2);
+  const S21Matrix square = PseudoRandomMatrix<double>(129, 129, 3);
+  const S21Matrix product = a * b;
+  const S21Matrix squared = square * square;
+  const std::size_t threshold = S21GetSerialThreshold();
+  S21SetMulAlgorithm(S21MulAlgorithm::kStrassen);
+  S21SetStrassenCrossover(16);
+  for (int threads : {1, 4}) {
+    S21SetThreadCount(threads);
+    S21SetSerialThreshold(threads == 1 ? threshold : 0);
+    EXPECT_LT(RelativeError(a * b, product), 1e-13);
+    S21Matrix multiplied(square);
+    multiplied.MulMatrix(square);
+    EXPECT_LT(RelativeError(multiplied, squared), 1e-13);
+  }
+  const S21BasicMatrix<float> a_float = PseudoRandomMatrix<float>(70, 45, 4);
+  const S21BasicMatrix<float> b_float = PseudoRandomMatrix<float>(45, 99, 5);
+  const S21BasicMatrix<std::complex<double>> a_complex =
+      PseudoRandomMatrix<std::complex<double>>(33, 65, 6);
+  const S21BasicMatrix<std::complex<double>> b_complex =
+      PseudoRandomMatrix<std::complex<double>>(65, 34, 7);
+  const S21BasicMatrix<float> float_product = a_float * b_float;
+  const S21BasicMatrix<std::complex<double>> complex_product =
+      a_complex * b_complex;
+  S21SetMulAlgorithm(S21MulAlgorithm::kClassical);
+  EXPECT_TRUE(a * b == product);
+  EXPECT_LT(RelativeError(float_product, a_float * b_float), 1e-5);
+  EXPECT_LT(RelativeError(complex_product, a_complex * b_complex), 1e-13);
+  S21SetSerialThreshold(threshold);
+  S21SetThreadCount(0);
+  S21SetStrassenCrossover(0);
+}
+
+TEST(strassen_suite, exceptional_test) {
+  const S21Matrix first_matrix = PseudoRandomMatrix<double>(40, 40, 1);
+  const S21Matrix second_matrix = PseudoRandomMatrix<double>(30, 40, 2);
+  S21SetMulAlgorithm(S21MulAlgorithm::kStrassen);
+  S21SetStrassenCrossover(8);
+  EXPECT_THROW(first_matrix * second_matrix, std::out_of_range);
+  S21Matrix multiplied(first_matrix);
+  EXPECT_THROW(multiplied.MulMatrix(second_matrix), std::out_of_range);
+  S21SetMulAlgorithm(S21MulAlgorithm::kClassical);
+  S21SetStrassenCrossover(0);
+}
+
+TEST(async_suite, pipeline_test) {
+  // (A * B)^T + C for several requests at once, against the blocking calls
+  const S21Matrix a = PseudoRandomMatrix<double>(40, 30, 1);
+  const S21Matrix b = PseudoRandomMatrix<double>(30, 50, 2);
+  const S21Matrix c = PseudoRandomMatrix<double>(50, 40, 3);
+  const S21Matrix expected = (a * b).Transpose() + c;
+  for (int threads : {1, 4}) {
+    S21SetThreadCount(threads);
+    const S21MatrixFuture a_future = S21MakeReadyFuture(a);
+    const S21MatrixFuture c_future = S21MakeReadyFuture(c);
+    std::vector<S21MatrixFuture> results;
+    for (int request = 0; request < 8; ++request) {
+      const S21MatrixFuture product =
+          S21MulMatrixAsync(a_future, S21MakeReadyFuture(b));
+      results.push_back(
+          S21SumMatrixAsync(S21TransposeAsync(product), c_future));
+    }
+    for (const S21MatrixFuture &result : results) {
+      EXPECT_TRUE(result.Valid());
+      EXPECT_TRUE(result.Get() == expected);
+      EXPECT_TRUE(result.Ready());
+    }
+  }
+  S21SetThreadCount(0);
+  EXPECT_FALSE(S21MatrixFuture().Valid());
+}
+
+TEST(async_suite, operations_test) {
+  S21Matrix matrix(3, 3);
+  matrix(0, 0) = 2;
+  matrix(0, 1) = 5;
+  matrix(0, 2) = 7;
+  matrix(1, 0) = 6;
+  matrix(1, 1) = 3;
+  matrix(1, 2) = 4;
+  matrix(2, 0) = 5;
+  matrix(2, 1) = -2;
+  matrix(2, 2) = -3;
+  const S21MatrixFuture future = S21MakeReadyFuture(matrix);
+  const S21Future<double> determinant = S21DeterminantAsync(future);
+  const S21MatrixFuture inverse = S21InverseMatrixAsync(future);
+  const S21MatrixFuture complements = S21CalcComplementsAsync(future);
+  const S21MatrixFuture doubled = S21MulNumberAsync(future, 2.0);
+  const S21MatrixFuture zero =
+      S21SubMatrixAsync(S21SumMatrixAsync(future, future), doubled);
+  // Generic nodes may mix result types
+  const S21Future<double> trace = S21Then(
+      [](const S21Matrix &m, double det) { return m(0, 0) + det; }, inverse,
+      determinant);
+  EXPECT_NEAR(determinant.Get(), -1, 1e-12);
+  EXPECT_TRUE(inverse.Get() == matrix.InverseMatrix());
+  EXPECT_TRUE(complements.Get() == matrix.CalcComplements());
+  EXPECT_TRUE(zero.Get() == S21Matrix(3, 3));
+  EXPECT_NEAR(trace.Get(), 0, 1e-12);
+}
+
+TEST(async_suite, exceptional_test) {
+  // The error of a failed node reaches every node computed from it
+  std::atomic<int> runs(0);
+  const S21MatrixFuture product = S21MulMatrixAsync(
+      S21MakeReadyFuture(S21Matrix(2, 3)), S21MakeReadyFuture(S21Matrix(2, 3)));
+  const auto count_runs = [&runs](const S21Matrix &m) {
+    ++runs;
+    return m;
+  };
+  const S21MatrixFuture dependent =
+      S21Then(count_runs, S21TransposeAsync(product));
+  ASSERT_THROW(product.Get(), std::out_of_range);
+  ASSERT_THROW(dependent.Get(), std::out_of_range);
+  EXPECT_EQ(runs, 0);
+  const S21Future<double> singular = S21DeterminantAsync(
+      S21InverseMatrixAsync(S21MakeReadyFuture(S21Matrix(2, 2))));
+  ASSERT_THROW(singular.Get(), std::invalid_argument);
+}
+
+// A general matrix with a dominant diagonal, so the updates below keep it
+// well conditioned
+S21Matrix IncrementalInput(int size) {
+  S21Matrix matrix = PseudoRandomMatrix<double>(size, size, 5);
+  for (int i = 0; i < size; ++i) matrix(i, i) += size;
+  return matrix;
+}
+
+TEST(incremental_suite, rank_one_test) {
+  const int size = 12;
+  S21Matrix matrix = IncrementalInput(size);
+  const S21Matrix &read = matrix;
+  S21IncrementalInverse incremental(matrix);
+  EXPECT_NEAR(incremental.Determinant() / read.Determinant(), 1, 1e-12);
+  for (int step = 0; step < 20; ++step) {
+    std::vector<double> u(size), v(size);
+    for (int i = 0; i < size; ++i) {
+      u[i] = ((i + step) * 5 % 7) / 7.0 - 0.4;
+      v[i] = ((i * 3 + step) % 11) / 11.0 - 0.5;
+    }
+    incremental.RankOneUpdate(u, v);
+  }
+  EXPECT_EQ(incremental.GetUpdateCount(), 20);
+  EXPECT_LT(RelativeError(incremental.Inverse(), read.InverseMatrix()), 1e-12);
+  EXPECT_NEAR(incremental.Determinant() / read.Determinant(), 1, 1e-12);
+  const std::vector<double> b(size, 1.0);
+  const std::vector<double> x = incremental.Solve(b);
+  const std::vector<double> expected = S21LU(read).Solve(b);
+  for (int i = 0; i < size; ++i) EXPECT_NEAR(x[i], expected[i], 1e-12);
+  EXPECT_EQ(incremental.GetRefactorCount(), 1);
+  EXPECT_GT(incremental.GetErrorEstimate(), 0);
+}
+
+TEST(incremental_suite, replace_and_low_rank_test) {
+  const int size = 9;
+  S21Matrix matrix = IncrementalInput(size);
+  const S21Matrix &read = matrix;
+  S21IncrementalInverse incremental(matrix);
+  incremental.Refactor();
+  std::vector<double> row(size, 0.5);
+  row[3] = 20;
+  incremental.ReplaceRow(3, row);
+  EXPECT_EQ(read(3, 3), 20);
+  EXPECT_EQ(read(3, 0), 0.5);
+  std::vector<double> col(size, -0.25);
+  col[6] = 15;
+  incremental.ReplaceCol(6, col);
+  EXPECT_EQ(read(0, 6), -0.25);
+  S21Matrix u = PseudoRandomMatrix<double>(size, 3, 7);
+  const S21Matrix v = PseudoRandomMatrix<double>(size, 3, 8);
+  S21Matrix expected = read + u * v.Transpose();
+  incremental.LowRankUpdate(u, v);
+  EXPECT_TRUE(read == expected);
+  EXPECT_EQ(incremental.GetUpdateCount(), 3);
+  EXPECT_LT(RelativeError(incremental.Inverse(), read.InverseMatrix()), 1e-12);
+  EXPECT_NEAR(incremental.Determinant() / read.Determinant(), 1, 1e-12);
+  EXPECT_EQ(incremental.GetRefactorCount(), 1);
+
+  using Complex = std::complex<double>;
+  S21BasicMatrix<Complex> complex_matrix(2, 2);
+  complex_matrix(0, 0) = Complex(2, 1);
+  complex_matrix(1, 1) = 3;
+  S21BasicIncrementalInverse<Complex> complex_incremental(complex_matrix);
+  complex_incremental.Refactor();
+  complex_incremental.RankOneUpdate({Complex(0, 1), 1}, {1, Complex(1, -1)});
+  const S21BasicMatrix<Complex> &complex_read = complex_matrix;
+  EXPECT_EQ(complex_read(0, 0), Complex(2, 2));
+  EXPECT_EQ(complex_read(0, 1), Complex(1, 1));
+  EXPECT_LT(std::abs(complex_incremental.Determinant() -
+                     S21BasicLU<Complex>(complex_read).Determinant()),
+            1e-12);
+}
+
+TEST(incremental_suite, invalidation_test) {
+  const int size = 5;
+  S21Matrix matrix = IncrementalInput(size);
+  S21IncrementalInverse incremental(matrix);
+  incremental.Refactor();
+  // A write that bypasses the companion is seen through the version
+  const std::uint64_t version = matrix.GetVersion();
+  matrix(1, 2) = 4;
+  EXPECT_GT(matrix.GetVersion(), version);
+  EXPECT_NEAR(incremental.Determinant() / matrix.Determinant(), 1, 1e-12);
+  EXPECT_EQ(incremental.GetRefactorCount(), 2);
+  // Making the matrix singular and back
+  const std::vector<double> saved(matrix[0], matrix[0] + size);
+  incremental.ReplaceRow(0, std::vector<double>(matrix[1], matrix[1] + size));
+  EXPECT_TRUE(incremental.IsSingular());
+  EXPECT_EQ(incremental.Determinant(), 0);
+  ASSERT_THROW(incremental.Inverse(), std::invalid_argument);
+  ASSERT_THROW(incremental.Solve(std::vector<double>(size)),
+               std::invalid_argument);
+  incremental.ReplaceRow(0, saved);
+  EXPECT_FALSE(incremental.IsSingular());
+  EXPECT_LT(RelativeError(incremental.Inverse(), matrix.InverseMatrix()),
+            1e-12);
+  // A matrix that is no longer square
+  matrix.SetCols(size + 1);
+  ASSERT_THROW(incremental.Determinant(), std::out_of_range);
+  ASSERT_THROW(incremental.RankOneUpdate(std::vector<double>(size),
+                                         std::vector<double>(size)),
+               std::out_of_range);
+  ASSERT_THROW(S21IncrementalInverse{matrix}, std::out_of_range);
+  matrix.SetCols(size);
+  ASSERT_THROW(incremental.ReplaceRow(size, std::vector<double>(size)),
+               std::out_of_range);
+  ASSERT_THROW(incremental.ReplaceCol(0, std::vector<double>(size + 1)),
+               std::out_of_range);
+  ASSERT_THROW(
+      incremental.LowRankUpdate(S21Matrix(size, 2), S21Matrix(size, 3)),
+      std::out_of_range);
+}
+
+TEST(incremental_suite, tolerance_test) {
+  const int size = 6;
+  S21Matrix matrix = IncrementalInput(size);
+  S21IncrementalInverse incremental(matrix);
+  EXPECT_GT(incremental.GetTolerance(), 0);
+  incremental.Refactor();
+  incremental.SetTolerance(0);
+  std::vector<double> u(size, 0.1), v(size, 0.2);
+  incremental.RankOneUpdate(u, v);
+  EXPECT_EQ(incremental.GetUpdateCount(), 1);
+  // Any error at all passes a zero tolerance, so the query refactors
+  EXPECT_NEAR(incremental.Determinant() / matrix.Determinant(), 1, 1e-12);
+  EXPECT_EQ(incremental.GetRefactorCount(), 2);
+  EXPECT_EQ(incremental.GetUpdateCount(), 0);
+  EXPECT_EQ(incremental.GetErrorEstimate(), 0);
+}
+
 TEST(index_operator_suite, true_test) {
   S21Matrix matrix(3, 3);
   matrix.FillingMatrix();
@@ -392,6 +1291,100 @@ TEST(index_operator_suite, exceptional_test) {
   ASSERT_THROW(matrix(10, 10), std::out_of_range);
 }
 
+TEST(index_operator_suite, unchecked_test) {
+  S21Matrix matrix(3, 4);
+  matrix.FillingMatrix();
+  EXPECT_EQ(matrix.at_unchecked(2, 1), 9);
+  EXPECT_EQ(matrix[1][3], 7);
+  matrix[2][0] = -1;
+  matrix.at_unchecked(0, 0) = -2;
+  const S21Matrix& read = matrix;
+  EXPECT_EQ(read(2, 0), -1);
+  EXPECT_EQ(read.at_unchecked(0, 0), -2);
+  EXPECT_EQ(read[1][2], 6);
+  ASSERT_THROW(read(3, 0), std::out_of_range);
+#ifdef S21_MATRIX_DEBUG
+  ASSERT_THROW(matrix.at_unchecked(0, 4), std::out_of_range);
+  ASSERT_THROW(read[-1], std::out_of_range);
+  ASSERT_THROW(read.ColBegin(4), std::out_of_range);
+#endif
+}
+
+TEST(index_operator_suite, const_operations_test) {
+  S21Matrix source(3, 3);
+  source(0, 0) = 2;
+  source(1, 1) = 3;
+  source(2, 2) = 4;
+  source(0, 2) = 1;
+  const S21Matrix matrix = source;
+  EXPECT_DOUBLE_EQ(matrix.Determinant(), 24);
+  const S21Matrix identity = matrix * matrix.InverseMatrix();
+  S21Matrix expected(3, 3);
+  for (int i = 0; i < 3; ++i) expected(i, i) = 1;
+  EXPECT_TRUE(identity == expected);
+  EXPECT_TRUE(matrix.Transpose().Transpose().EqMatrix(matrix));
+  EXPECT_EQ(matrix.CalcComplements()(0, 0), 12);
+}
+
+TEST(iterator_suite, flat_test) {
+  S21Matrix matrix(3, 4);
+  int count = 0;
+  for (double& element : matrix) element = count++;
+  S21Matrix expected(3, 4);
+  expected.FillingMatrix();
+  EXPECT_TRUE(matrix == expected);
+  const S21Matrix& read = matrix;
+  EXPECT_EQ(std::accumulate(read.begin(), read.end(), 0.0), 66);
+  EXPECT_EQ(read.end() - read.begin(), 12);
+  EXPECT_EQ(read.begin()[5], 5);
+  EXPECT_EQ(*(read.end() - 5), 7);
+  std::reverse(matrix.begin(), matrix.end());
+  EXPECT_EQ(matrix(0, 0), 11);
+  EXPECT_EQ(matrix(2, 3), 0);
+  std::sort(matrix.begin(), matrix.end());
+  EXPECT_TRUE(matrix == expected);
+  S21Matrix empty;
+  EXPECT_TRUE(empty.begin() == empty.end());
+}
+
+TEST(iterator_suite, padded_rows_test) {
+  // 3 x 2 elements in rows of 4, the padding marked with -1
+  double buffer[] = {0, 1, -1, -1, 2, 3, -1, -1, 4, 5, -1, -1};
+  S21FlatIterator<double> begin(buffer, 0, 2, 4);
+  S21FlatIterator<double> end(buffer + 12, 0, 2, 4);
+  EXPECT_EQ(end - begin, 6);
+  EXPECT_EQ(std::count(begin, end, -1), 0);
+  std::vector<double> copied(begin, end);
+  EXPECT_EQ(copied, (std::vector<double>{0, 1, 2, 3, 4, 5}));
+  S21FlatIterator<const double> it = begin + 3;
+  EXPECT_EQ(*it, 3);
+  EXPECT_EQ(*--it, 2);
+  EXPECT_EQ(*--it, 1);
+  EXPECT_EQ(it[3], 4);
+  EXPECT_EQ(*(it - 1), 0);
+  EXPECT_EQ(it - (end - 1), -4);
+  EXPECT_TRUE(begin < it && it <= end - 1 && end > it);
+}
+
+TEST(iterator_suite, row_and_col_test) {
+  S21Matrix matrix(3, 4);
+  matrix.FillingMatrix();
+  std::vector<double> row(matrix.RowBegin(1), matrix.RowEnd(1));
+  EXPECT_EQ(row, (std::vector<double>{4, 5, 6, 7}));
+  const S21Matrix& read = matrix;
+  std::vector<double> col(read.ColBegin(2), read.ColEnd(2));
+  EXPECT_EQ(col, (std::vector<double>{2, 6, 10}));
+  EXPECT_EQ(read.ColEnd(2) - read.ColBegin(2), 3);
+  std::fill(matrix.ColBegin(0), matrix.ColEnd(0), -1);
+  std::copy(read.RowBegin(0), read.RowEnd(0), matrix.RowBegin(2));
+  EXPECT_EQ(matrix(1, 0), -1);
+  EXPECT_EQ(matrix(2, 0), -1);
+  EXPECT_EQ(matrix(2, 3), 3);
+  S21Matrix::const_col_iterator last = matrix.ColEnd(3) - 1;
+  EXPECT_EQ(*last, 3);
+  EXPECT_EQ(last[-1], 7);
+}
+
 TEST(move_operator_suite, true_test) {
   S21Matrix first_matrix(2, 2);
   S21Matrix second_matrix(3, 3);
@@ -404,6 +1397,61 @@ TEST(move_operator_suite, true_test) {
   EXPECT_EQ(second_matrix.GetCols(), 2);
 }
 
+// Counts the buffers S21Matrix takes from it; each copy of a matrix is one.
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  long allocations = 0;
+
+ private:
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+    ++allocations;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void *p, std::size_t bytes,
+                     std::size_t alignment) override {
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+  bool do_is_equal(const std::pmr::memory_resource &other) const
+      noexcept override {
+    return this == &other;
+  }
+};
+
+TEST(move_operator_suite, allocation_count_test) {
+  static_assert(std::is_nothrow_move_constructible_v<S21Matrix>);
+  static_assert(std::is_nothrow_move_assignable_v<S21Matrix>);
+  CountingResource counting;
+  S21Matrix first_matrix(8, 8, &counting);
+  S21Matrix second_matrix(8, 8, &counting);
+  S21Matrix result(8, 8, &counting);
+  first_matrix.FillingMatrix();
+  second_matrix.FillingMatrix();
+  const long before = counting.allocations;
+  result = first_matrix;
+  EXPECT_EQ(&((result += second_matrix) -= first_matrix), &result);
+  EXPECT_EQ(&(result *= 0.5), &result);
+  result = first_matrix + second_matrix * 2.0;
+  EXPECT_EQ(counting.allocations - before, 0);
+  // One buffer for the product, which the rvalue chain then carries along.
+  S21Matrix chain =
+      first_matrix * second_matrix + result - second_matrix * 0.5;
+  EXPECT_EQ(counting.allocations - before, 1);
+  S21Matrix expected = first_matrix * second_matrix;
+  expected.SumMatrix(result);
+  expected.SubMatrix(second_matrix * 0.5);
+  EXPECT_TRUE(chain == expected);
+  const long after_chain = counting.allocations;
+  std::vector<S21Matrix> matrices;
+  matrices.push_back(std::move(chain));
+  const double *data = matrices[0].data();
+  for (int i = 0; i < 8; ++i) matrices.emplace_back();
+  EXPECT_EQ(matrices[0].data(), data);
+  EXPECT_EQ(counting.allocations, after_chain);
+  swap(matrices[0], result);
+  EXPECT_EQ(result.data(), data);
+  EXPECT_TRUE(result == expected);
+}
+
 TEST(SumMatrix_operator_suite, true_test) {
   S21Matrix first_matrix(3, 3);
   S21Matrix second_matrix(3, 3);
@@ -461,6 +1509,75 @@ TEST(SubMatrix_operator_suite, exceptional_test) {
   ASSERT_THROW(first_matrix = first_matrix - second_matrix, std::out_of_range);
 }
 
+TEST(expression_suite, fused_chain_test) {
+  S21Matrix first_matrix(3, 4);
+  S21Matrix second_matrix(3, 4);
+  S21Matrix third_matrix(3, 4);
+  first_matrix.FillingMatrix();
+  second_matrix.FillingMatrix();
+  third_matrix.FillingMatrix();
+  S21Matrix result = first_matrix + second_matrix - third_matrix * 2.0;
+  S21Matrix expected_result(3, 4);
+  EXPECT_TRUE(result == expected_result);
+  result = first_matrix * 3 - second_matrix;
+  expected_result = first_matrix;
+  expected_result.MulNumber(2);
+  EXPECT_TRUE(result == expected_result);
+}
+
+TEST(expression_suite, assignment_test) {
+  S21Matrix first_matrix(3, 3);
+  S21Matrix second_matrix(3, 3);
+  S21Matrix result(1, 5);
+  first_matrix.FillingMatrix();
+  second_matrix.FillingMatrix();
+  result = first_matrix + second_matrix;
+  EXPECT_EQ(result.GetRows(), 3);
+  EXPECT_EQ(result.GetCols(), 3);
+  first_matrix = first_matrix + first_matrix * 2.0;
+  first_matrix -= second_matrix * 2.0;
+  EXPECT_TRUE(first_matrix == second_matrix);
+  first_matrix += second_matrix - second_matrix;
+  EXPECT_TRUE(first_matrix == second_matrix);
+}
+
+TEST(expression_suite, exceptional_test) {
+  S21Matrix first_matrix(3, 3);
+  S21Matrix second_matrix(3, 3);
+  S21Matrix third_matrix(2, 3);
+  ASSERT_THROW(first_matrix + second_matrix - third_matrix, std::out_of_range);
+  ASSERT_THROW(first_matrix += third_matrix * 2.0, std::out_of_range);
+  ASSERT_THROW(first_matrix -= third_matrix * 2.0, std::out_of_range);
+}
+
+TEST(expression_suite, matrix_interface_test) {
+  S21Matrix first_matrix(3, 3);
+  S21Matrix second_matrix(3, 3);
+  S21Matrix third_matrix(3, 3);
+  first_matrix.FillingMatrix();
+  second_matrix.FillingMatrix();
+  third_matrix.FillingMatrix();
+  third_matrix.MulNumber(2);
+  EXPECT_TRUE((first_matrix + second_matrix) == third_matrix);
+  EXPECT_TRUE(third_matrix == first_matrix + second_matrix);
+  EXPECT_TRUE((first_matrix * 2.0).EqMatrix(third_matrix));
+  EXPECT_FALSE((first_matrix - second_matrix) == third_matrix);
+  EXPECT_TRUE((first_matrix + second_matrix) == third_matrix.View());
+  EXPECT_TRUE((first_matrix + second_matrix).Transpose() ==
+              third_matrix.Transpose());
+  EXPECT_DOUBLE_EQ((first_matrix + second_matrix)(2, 1), 14);
+  EXPECT_THROW((first_matrix + second_matrix)(3, 0), std::out_of_range);
+  EXPECT_TRUE((first_matrix * 2.0) * first_matrix ==
+              third_matrix * first_matrix);
+  first_matrix(0, 0) = 10;
+  EXPECT_DOUBLE_EQ((first_matrix * 2.0).Determinant(),
+                   first_matrix.Determinant() * 8);
+  EXPECT_TRUE((first_matrix - second_matrix * 0.0).InverseMatrix() ==
+              first_matrix.InverseMatrix());
+  EXPECT_TRUE((first_matrix + second_matrix * 0.0).CalcComplements() ==
+              first_matrix.CalcComplements());
+}
+
 TEST(MulMatrix_operator_suite, four_four_true_test) {
   S21Matrix first_matrix(4, 4);
   S21Matrix second_matrix(4, 4);
@@ -534,6 +1651,1150 @@ TEST(MulNumber_operator_suite, num_test) {
   EXPECT_TRUE(second_matrix.EqMatrix(third_matrix));
 }
 
+TEST(data_accessor_suite, contiguous_test) {
+  S21Matrix matrix(3, 4);
+  matrix.FillingMatrix();
+  EXPECT_EQ(matrix.stride(), 4);
+  for (int i = 0; i < matrix.GetRows(); ++i) {
+    for (int j = 0; j < matrix.GetCols(); ++j) {
+      EXPECT_EQ(matrix.data()[i * matrix.stride() + j], matrix(i, j));
+    }
+  }
+  S21Matrix copy(matrix);
+  EXPECT_NE(copy.data(), matrix.data());
+  EXPECT_TRUE(copy == matrix);
+}
+
+TEST(data_accessor_suite, empty_test) {
+  S21Matrix matrix;
+  EXPECT_EQ(matrix.data(), nullptr);
+  EXPECT_EQ(matrix.stride(), 0);
+}
+
+TEST(view_suite, block_test) {
+  S21Matrix matrix(4, 5);
+  matrix.FillingMatrix();
+  S21MatrixView block = matrix.Block(1, 2, 2, 3);
+  EXPECT_EQ(block.GetRows(), 2);
+  EXPECT_EQ(block.GetCols(), 3);
+  EXPECT_EQ(block(0, 0), 7);
+  EXPECT_EQ(block(1, 2), 14);
+  block.Fill(1);
+  EXPECT_EQ(matrix(1, 2), 1);
+  EXPECT_EQ(matrix(2, 4), 1);
+  EXPECT_EQ(matrix(1, 1), 6);
+  EXPECT_EQ(matrix(3, 2), 17);
+  S21MatrixConstView row = matrix.View().Row(3);
+  S21MatrixConstView col = matrix.View().Col(0);
+  EXPECT_EQ(row(0, 4), 19);
+  EXPECT_EQ(col(2, 0), 10);
+  ASSERT_THROW(matrix.Block(3, 0, 2, 1), std::out_of_range);
+  ASSERT_THROW(block(2, 0), std::out_of_range);
+}
+
+TEST(view_suite, operations_test) {
+  S21Matrix matrix(4, 4);
+  matrix.FillingMatrix();
+  S21Matrix tile(2, 2);
+  tile.FillingMatrix();
+  matrix.Block(2, 2, 2, 2).SumMatrix(tile);
+  EXPECT_EQ(matrix(2, 2), 10);
+  EXPECT_EQ(matrix(3, 3), 18);
+  matrix.Block(2, 2, 2, 2).SubMatrix(tile);
+  matrix.Block(0, 0, 2, 2).MulNumber(2);
+  EXPECT_EQ(matrix(1, 1), 10);
+  EXPECT_EQ(matrix(0, 2), 2);
+  S21Matrix copy(matrix.Block(0, 1, 3, 2));
+  EXPECT_EQ(copy.GetRows(), 3);
+  EXPECT_EQ(copy(2, 1), 10);
+  EXPECT_TRUE(copy.EqMatrix(matrix.Block(0, 1, 3, 2)));
+  copy.SumMatrix(matrix.Block(1, 0, 3, 2));
+  EXPECT_EQ(copy(0, 0), 2 + 8);
+  S21Matrix sum = matrix.Block(0, 0, 2, 2) + tile * 2.0;
+  EXPECT_EQ(sum(1, 1), 10 + 6);
+  ASSERT_THROW(copy.SumMatrix(matrix.View()), std::out_of_range);
+}
+
+TEST(view_suite, transpose_and_external_test) {
+  double buffer[6] = {1, 2, 3, 4, 5, 6};
+  S21MatrixView external(buffer, 2, 3, 3);
+  S21Matrix transposed(external.Transposed());
+  EXPECT_TRUE(transposed == S21Matrix(external).Transpose());
+  external.Transposed().Row(2).MulNumber(10);
+  EXPECT_EQ(buffer[2], 30);
+  EXPECT_EQ(buffer[5], 60);
+  S21Matrix square(3, 3);
+  square.FillingMatrix();
+  const S21Matrix expected_result = square.Transpose();
+  square = square.View().Transposed();
+  EXPECT_TRUE(square == expected_result);
+}
+
+TEST(view_suite, gemm_test) {
+  S21Matrix first_matrix(3, 2);
+  S21Matrix second_matrix(4, 3);
+  first_matrix.FillingMatrix();
+  second_matrix.FillingMatrix();
+  // C block (rows 1..3 of a 4x4) = A^T * B block
+  S21Matrix result(4, 4);
+  S21Matrix::Gemm(1.0, first_matrix.View().Transposed(),
+                  second_matrix.Block(1, 0, 3, 3), 0.0,
+                  result.Block(1, 1, 2, 3));
+  S21Matrix expected_result = first_matrix.Transpose();
+  expected_result.MulMatrix(second_matrix.Block(1, 0, 3, 3));
+  EXPECT_TRUE(S21Matrix(result.Block(1, 1, 2, 3)) == expected_result);
+  EXPECT_EQ(result(0, 0), 0);
+  EXPECT_EQ(result(3, 3), 0);
+  // Output overlapping an input
+  S21Matrix square(3, 3);
+  square.FillingMatrix();
+  expected_result = square * square;
+  S21Matrix::Gemm(1.0, square, square, 0.0, square.View());
+  EXPECT_TRUE(square == expected_result);
+}
+
+TEST(view_suite, aliasing_test) {
+  // Operands that read the destination through another layout
+  S21Matrix filled(3, 3);
+  filled.FillingMatrix();
+  const S21Matrix transposed = filled.Transpose();
+  const S21Matrix zeros(3, 3);
+  S21Matrix y = filled;
+  y += y.View().Transposed();
+  EXPECT_TRUE(y == filled + transposed);
+  S21Matrix z = filled;
+  z.SumMatrix(z.View().Transposed());
+  EXPECT_TRUE(z == filled + transposed);
+  S21Matrix w = filled;
+  w.SubMatrix(w.View().Transposed());
+  EXPECT_TRUE(w == filled - transposed);
+  S21Matrix x = filled;
+  x = x.View().Transposed() + zeros;
+  EXPECT_TRUE(x == transposed);
+  S21Matrix v = filled;
+  v.View().Assign(v.View().Transposed());
+  EXPECT_TRUE(v == transposed);
+  S21Matrix u = filled;
+  u = u.View().Transposed() * 2.0;
+  EXPECT_TRUE(u == transposed * 2.0);
+  u = filled;
+  u -= u.View().Transposed() * 1.0;
+  EXPECT_TRUE(u == filled - transposed);
+  u = filled;
+  u.View().Assign(u.View().Transposed() + zeros);
+  EXPECT_TRUE(u == transposed);
+  // Overlapping blocks of the same layout, shifted by a row
+  u = filled;
+  u.Block(1, 0, 2, 3).Assign(u.Block(0, 0, 2, 3));
+  EXPECT_EQ(u(1, 0), 0);
+  EXPECT_EQ(u(2, 2), 5);
+  // The same layout is still updated in place
+  u = filled;
+  u += u.View() * 1.0;
+  EXPECT_TRUE(u == filled * 2.0);
+}
+
+TEST(fixed_matrix_suite, constexpr_test) {
+  constexpr S21FixedMatrix<3, 3> matrix({2, 5, 7, 6, 3, 4, 5, -2, -3});
+  static_assert(matrix.Determinant() == -1, "determinant at compile time");
+  constexpr S21FixedMatrix<3, 3> inverse = matrix.InverseMatrix();
+  static_assert(inverse.At(0, 1) == -1, "inverse at compile time");
+  constexpr S21FixedMatrix<3, 2> product =
+      matrix * S21FixedMatrix<3, 2>({1, 0, 0, 1, 1, 1});
+  static_assert(product.At(2, 1) == -5, "product at compile time");
+  static_assert(matrix.Transpose().At(0, 2) == 5, "transpose");
+  EXPECT_TRUE(matrix * inverse == (S21FixedMatrix<3, 3>::Identity()));
+}
+
+TEST(fixed_matrix_suite, operations_test) {
+  S21FixedMatrix<4, 4> matrix;
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      matrix(i, j) = (i == j) ? 4 : (i + 2 * j) % 3;
+    }
+  }
+  S21Matrix dynamic = matrix.ToMatrix();
+  EXPECT_NEAR(matrix.Determinant(), dynamic.Determinant(), 1e-9);
+  EXPECT_TRUE(matrix.InverseMatrix().ToMatrix() == dynamic.InverseMatrix());
+  EXPECT_TRUE(matrix.CalcComplements().ToMatrix() ==
+              dynamic.CalcComplements());
+  S21FixedMatrix<4, 4> copy(dynamic);
+  EXPECT_TRUE(copy == matrix);
+  copy += matrix;
+  copy -= matrix * 2.0;
+  const S21FixedMatrix<4, 4> zero;
+  EXPECT_TRUE(copy == zero);
+  copy = matrix;
+  copy *= S21FixedMatrix<4, 4>::Identity();
+  copy *= 0.5;
+  EXPECT_TRUE(copy * 2.0 == matrix);
+  S21FixedMatrix<5, 5> large;
+  for (int i = 0; i < 5; ++i) {
+    for (int j = 0; j < 5; ++j) {
+      large(i, j) = (i * 3 + j * 7) % 5 - 2 + (i == j) * 6;
+    }
+  }
+  EXPECT_NEAR(large.Determinant(), large.ToMatrix().Determinant(), 1e-9);
+  EXPECT_TRUE(large.InverseMatrix().ToMatrix() ==
+              large.ToMatrix().InverseMatrix());
+  const S21FixedMatrix<1, 1> single({5});
+  EXPECT_TRUE(single.CalcComplements().ToMatrix() ==
+              single.ToMatrix().CalcComplements());
+  EXPECT_EQ(single.CalcComplements().At(0, 0), 0);
+  EXPECT_EQ(single.InverseMatrix().At(0, 0), 0.2);
+  ASSERT_THROW((S21FixedMatrix<1, 1>().InverseMatrix()),
+               std::invalid_argument);
+}
+
+TEST(fixed_matrix_suite, complex_test) {
+  using Complex = std::complex<double>;
+  S21FixedMatrix<5, 5, Complex> matrix;
+  for (int i = 0; i < 5; ++i) {
+    for (int j = 0; j < 5; ++j) {
+      matrix(i, j) = Complex((i * 3 + j * 7) % 5 - 2 + (i == j) * 6,
+                             (i + 2 * j) % 3 - 1);
+    }
+  }
+  const S21BasicMatrix<Complex> dynamic = matrix.ToMatrix();
+  EXPECT_LT(std::abs(matrix.Determinant() - dynamic.Determinant()), 1e-9);
+  EXPECT_TRUE(matrix.InverseMatrix().ToMatrix() == dynamic.InverseMatrix());
+  EXPECT_TRUE(matrix * matrix.InverseMatrix() ==
+              (S21FixedMatrix<5, 5, Complex>::Identity()));
+  EXPECT_FALSE((matrix == S21FixedMatrix<5, 5, Complex>()));
+}
+
+TEST(fixed_matrix_suite, exceptional_test) {
+  S21FixedMatrix<2, 3> matrix;
+  ASSERT_THROW(matrix(2, 0), std::out_of_range);
+  ASSERT_THROW((S21FixedMatrix<3, 3>(S21Matrix(3, 2))), std::out_of_range);
+  const S21FixedMatrix<2, 2> zero;
+  ASSERT_THROW(zero.InverseMatrix(), std::invalid_argument);
+}
+
+TEST(generic_suite, float_test) {
+  S21BasicMatrix<float> matrix(3, 3);
+  const float values[] = {2, 5, 7, 6, 3, 4, 5, -2, -3};
+  std::copy(values, values + 9, matrix.data());
+  EXPECT_NEAR(matrix.Determinant(), -1.0f, 1e-5f);
+  S21BasicMatrix<float> identity(3, 3);
+  for (int i = 0; i < 3; ++i) identity(i, i) = 1;
+  EXPECT_TRUE((matrix * matrix.InverseMatrix()).EqMatrix(identity));
+  S21BasicMatrix<float> sum = matrix + matrix * 2.0f;
+  EXPECT_FLOAT_EQ(sum(2, 1), -6.0f);
+  EXPECT_FLOAT_EQ(sum.Transpose()(1, 2), -6.0f);
+}
+
+TEST(generic_suite, long_double_test) {
+  S21BasicMatrix<long double> matrix(6, 6);
+  S21Matrix reference(6, 6);
+  for (int i = 0; i < 6; ++i) {
+    for (int j = 0; j < 6; ++j) {
+      matrix(i, j) = reference(i, j) = ((i * 7 + j * 3) % 5) + (i == j) * 6;
+    }
+  }
+  S21BasicMatrix<long double> identity(6, 6);
+  for (int i = 0; i < 6; ++i) identity(i, i) = 1;
+  EXPECT_TRUE((matrix * matrix.InverseMatrix()).EqMatrix(identity));
+  EXPECT_NEAR(static_cast<double>(matrix.Determinant()),
+              reference.Determinant(), 1e-6);
+}
+
+TEST(generic_suite, complex_test) {
+  using Complex = std::complex<double>;
+  S21BasicMatrix<Complex> matrix(2, 2);
+  matrix(0, 0) = Complex(1, 1);
+  matrix(0, 1) = Complex(2, 0);
+  matrix(1, 0) = Complex(0, -1);
+  matrix(1, 1) = Complex(3, 2);
+  // (1 + i)(3 + 2i) - 2 * (-i) = 1 + 7i
+  const Complex det = matrix.Determinant();
+  EXPECT_DOUBLE_EQ(det.real(), 1.0);
+  EXPECT_DOUBLE_EQ(det.imag(), 7.0);
+  S21BasicMatrix<Complex> identity(2, 2);
+  identity(0, 0) = identity(1, 1) = 1;
+  EXPECT_TRUE((matrix * matrix.InverseMatrix()).EqMatrix(identity));
+  S21BasicMatrix<Complex> scaled = matrix * Complex(0, 1);
+  EXPECT_TRUE(scaled(0, 0) == Complex(-1, 1));
+  S21BasicMatrix<Complex> complements = matrix.CalcComplements();
+  EXPECT_TRUE(complements(0, 1) == Complex(0, 1));
+}
+
+TEST(generic_suite, epsilon_test) {
+  S21BasicMatrix<float> first(2, 2), second(2, 2);
+  second(1, 1) = 1e-5f;
+  EXPECT_TRUE(first.EqMatrix(second));
+  second(1, 1) = 1e-3f;
+  EXPECT_FALSE(first.EqMatrix(second));
+  S21Matrix exact(1, 1), close(1, 1);
+  close(0, 0) = 1e-5;
+  EXPECT_FALSE(exact.EqMatrix(close));
+}
+
+TEST(generic_suite, mixed_multiply_test) {
+  S21BasicMatrix<float> a(37, 70), b(70, 29);
+  S21Matrix a_double(37, 70), b_double(70, 29);
+  for (int i = 0; i < 37; ++i) {
+    for (int j = 0; j < 70; ++j) {
+      a(i, j) = static_cast<float>(((i * 13 + j * 7) % 17) / 9.0);
+      a_double(i, j) = a(i, j);
+    }
+  }
+  for (int i = 0; i < 70; ++i) {
+    for (int j = 0; j < 29; ++j) {
+      b(i, j) = static_cast<float>(((i * 5 + j * 11) % 19) / 7.0);
+      b_double(i, j) = b(i, j);
+    }
+  }
+  S21Matrix product = S21MulMatrixMixed(a, b);
+  EXPECT_TRUE(product.EqMatrix(a_double * b_double));
+  ASSERT_THROW(S21MulMatrixMixed(b, b), std::out_of_range);
+}
+
+static std::vector<double> SimdOutOfCoreInput(std::size_t n, int seed) {
+  std::vector<double> values(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    values[i] = ((static_cast<int>(i) * 37 + seed * 11) % 23 - 11) / 7.0;
+  }
+  return values;
+}
+
+TEST(simd_suite, variants_match_scalar_test) {
+  const S21SimdKernels *scalar = S21SimdKernelsFor(S21SimdLevel::kScalar);
+  ASSERT_NE(scalar, nullptr);
+  for (S21SimdLevel level : {S21SimdLevel::kSse2, S21SimdLevel::kAvx2,
+                             S21SimdLevel::kAvx512}) {
+    const S21SimdKernels *simd = S21SimdKernelsFor(level);
+    if (!simd) continue;
+    SCOPED_TRACE(simd->name);
+    for (std::size_t n : {0, 1, 3, 7, 8, 9, 17, 31, 64, 101}) {
+      // Offset by one element so the vector loads are misaligned.
+      const std::vector<double> src = SimdOutOfCoreInput(n + 1, 1);
+      const std::vector<double> init = SimdOutOfCoreInput(n + 1, 2);
+      std::vector<double> expected(init), actual(init);
+      const std::size_t bytes = (n + 1) * sizeof(double);
+      scalar->add(expected.data() + 1, src.data() + 1, n);
+      simd->add(actual.data() + 1, src.data() + 1, n);
+      EXPECT_EQ(std::memcmp(expected.data(), actual.data(), bytes), 0);
+      scalar->sub(expected.data() + 1, src.data() + 1, n);
+      simd->sub(actual.data() + 1, src.data() + 1, n);
+      EXPECT_EQ(std::memcmp(expected.data(), actual.data(), bytes), 0);
+      scalar->scale(expected.data() + 1, 1.0 / 3.0, n);
+      simd->scale(actual.data() + 1, 1.0 / 3.0, n);
+      EXPECT_EQ(std::memcmp(expected.data(), actual.data(), bytes), 0);
+      scalar->axpy(expected.data() + 1, -0.7, src.data() + 1, n);
+      simd->axpy(actual.data() + 1, -0.7, src.data() + 1, n);
+      EXPECT_EQ(std::memcmp(expected.data(), actual.data(), bytes), 0);
+      scalar->fill(expected.data() + 1, 2.5, n);
+      simd->fill(actual.data() + 1, 2.5, n);
+      EXPECT_EQ(std::memcmp(expected.data(), actual.data(), bytes), 0);
+      scalar->copy(expected.data() + 1, src.data() + 1, n);
+      simd->copy(actual.data() + 1, src.data() + 1, n);
+      EXPECT_EQ(std::memcmp(expected.data(), actual.data(), bytes), 0);
+      EXPECT_TRUE(simd->equal(src.data() + 1, actual.data() + 1, n, 1e-07));
+      for (std::size_t i = 1; i <= n; ++i) {
+        actual[i] += 2e-07;
+        EXPECT_EQ(simd->equal(src.data() + 1, actual.data() + 1, n, 1e-07),
+                  scalar->equal(src.data() + 1, actual.data() + 1, n, 1e-07));
+        actual[i] = src[i];
+      }
+    }
+  }
+}
+
+TEST(simd_suite, float_variants_match_scalar_test) {
+  const S21BasicSimdKernels<float> *scalar =
+      S21SimdKernelsFor<float>(S21SimdLevel::kScalar);
+  ASSERT_NE(scalar, nullptr);
+  for (S21SimdLevel level : {S21SimdLevel::kSse2, S21SimdLevel::kAvx2,
+                             S21SimdLevel::kAvx512}) {
+    const S21BasicSimdKernels<float> *simd = S21SimdKernelsFor<float>(level);
+    if (!simd) continue;
+    SCOPED_TRACE(simd->name);
+    for (std::size_t n : {0, 1, 5, 15, 16, 17, 33, 101}) {
+      const std::vector<double> wide = SimdOutOfCoreInput(n + 1, 3);
+      const std::vector<float> src(wide.begin(), wide.end());
+      std::vector<float> expected(src.size(), 1.5f), actual(expected);
+      const std::size_t bytes = (n + 1) * sizeof(float);
+      scalar->axpy(expected.data() + 1, -0.7f, src.data() + 1, n);
+      simd->axpy(actual.data() + 1, -0.7f, src.data() + 1, n);
+      EXPECT_EQ(std::memcmp(expected.data(), actual.data(), bytes), 0);
+      scalar->scale(expected.data() + 1, 1.0f / 3.0f, n);
+      simd->scale(actual.data() + 1, 1.0f / 3.0f, n);
+      EXPECT_EQ(std::memcmp(expected.data(), actual.data(), bytes), 0);
+      scalar->sub(expected.data() + 1, src.data() + 1, n);
+      simd->sub(actual.data() + 1, src.data() + 1, n);
+      EXPECT_EQ(std::memcmp(expected.data(), actual.data(), bytes), 0);
+      for (std::size_t i = 1; i <= n; ++i) {
+        actual[i] += 2e-4f;
+        EXPECT_EQ(simd->equal(expected.data() + 1, actual.data() + 1, n, 1e-4f),
+                  scalar->equal(expected.data() + 1, actual.data() + 1, n,
+                                1e-4f));
+        actual[i] = expected[i];
+      }
+    }
+  }
+  EXPECT_EQ(S21SimdKernelsFor<long double>(S21SimdLevel::kAvx2), nullptr);
+}
+
+TEST(simd_suite, active_test) {
+  const S21SimdKernels &active = S21SimdActive();
+  EXPECT_EQ(S21SimdKernelsFor(active.level), &active);
+}
+
+TEST(thread_pool_suite, parallel_for_test) {
+  S21ThreadPool pool(4);
+  EXPECT_EQ(pool.GetThreadCount(), 4);
+  std::vector<int> hits(1000);
+  pool.ParallelFor(0, 1000, 7, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    for (std::ptrdiff_t i = begin; i < end; ++i) {
+      // Nested loops are run by the same pool without deadlocking.
+      pool.ParallelFor(0, 4, 1, [&](std::ptrdiff_t, std::ptrdiff_t) {});
+      ++hits[i];
+    }
+  });
+  for (int hit : hits) {
+    EXPECT_EQ(hit, 1);
+  }
+  ASSERT_THROW(pool.ParallelFor(0, 100, 1,
+                                [](std::ptrdiff_t begin, std::ptrdiff_t) {
+                                  if (begin > 50) throw std::runtime_error("");
+                                }),
+               std::runtime_error);
+}
+
+TEST(thread_pool_suite, config_test) {
+  S21SetThreadCount(3);
+  EXPECT_EQ(S21GetThreadCount(), 3);
+  setenv("S21_NUM_THREADS", "5", 1);
+  S21SetThreadCount(0);
+  EXPECT_EQ(S21GetThreadCount(), 5);
+  unsetenv("S21_NUM_THREADS");
+  EXPECT_GE(S21GetThreadCount(), 1);
+  const std::size_t grain = S21GetParallelGrain();
+  S21SetParallelGrain(0);
+  EXPECT_EQ(S21GetParallelGrain(), 1u);
+  S21SetParallelGrain(grain);
+}
+
+TEST(thread_pool_suite, parallel_operations_test) {
+  const int size = 160;
+  S21Matrix first_matrix(size, size);
+  S21Matrix second_matrix(size, size + 3);
+  for (int i = 0; i < size; ++i) {
+    for (int j = 0; j < size; ++j) {
+      first_matrix(i, j) = ((i * 5 + j * 3) % 7 - 3) / 16.0 + (i == j);
+    }
+    for (int j = 0; j < size + 3; ++j) {
+      second_matrix(i, j) = (i * 2 + j) % 5 - 2;
+    }
+  }
+  S21SetThreadCount(1);
+  const S21Matrix product = first_matrix * second_matrix;
+  const S21Matrix transposed = second_matrix.Transpose();
+  const S21Matrix inverse = first_matrix.InverseMatrix();
+  const double determinant = first_matrix.Determinant();
+  S21Matrix sum(second_matrix);
+  sum.SumMatrix(second_matrix);
+  const std::size_t threshold = S21GetSerialThreshold();
+  const std::size_t grain = S21GetParallelGrain();
+  S21SetThreadCount(4);
+  S21SetSerialThreshold(0);
+  S21SetParallelGrain(64);
+  EXPECT_TRUE(first_matrix * second_matrix == product);
+  EXPECT_TRUE(second_matrix.Transpose() == transposed);
+  EXPECT_TRUE(first_matrix.InverseMatrix() == inverse);
+  EXPECT_NEAR(first_matrix.Determinant() / determinant, 1, 1e-12);
+  S21Matrix parallel_sum(second_matrix);
+  parallel_sum.SumMatrix(second_matrix);
+  EXPECT_TRUE(parallel_sum == sum);
+  parallel_sum(size - 1, size + 2) += 1;
+  EXPECT_FALSE(parallel_sum == sum);
+  S21SetSerialThreshold(threshold);
+  S21SetParallelGrain(grain);
+  S21SetThreadCount(0);
+}
+
+TEST(memory_suite, arena_test) {
+  S21ArenaResource arena(1024);
+  void *first = arena.allocate(100, 64);
+  void *second = arena.allocate(8, 8);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(first) % 64, 0u);
+  EXPECT_NE(first, second);
+  EXPECT_EQ(arena.GetBytesUsed(), 108u);
+  EXPECT_NE(arena.allocate(4096, 64), nullptr);
+  arena.Reset();
+  EXPECT_EQ(arena.GetBytesUsed(), 0u);
+  const long before = global_allocations;
+  EXPECT_EQ(arena.allocate(100, 64), first);
+  EXPECT_NE(arena.allocate(4096, 64), nullptr);
+  EXPECT_EQ(global_allocations - before, 0);
+  arena.Release();
+  EXPECT_EQ(arena.GetBytesUsed(), 0u);
+}
+
+TEST(memory_suite, pool_test) {
+  S21PoolResource pool;
+  void *block = pool.allocate(200, 64);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(block) % 64, 0u);
+  void *other = pool.allocate(100, 8);
+  pool.deallocate(block, 200, 64);
+  pool.deallocate(other, 100, 8);
+  const long before = global_allocations;
+  EXPECT_EQ(pool.allocate(256, 64), block);
+  EXPECT_EQ(pool.allocate(128, 8), other);
+  EXPECT_EQ(global_allocations - before, 0);
+  void *large = pool.allocate(S21PoolResource::kMaxBlock + 1, 64);
+  pool.deallocate(large, S21PoolResource::kMaxBlock + 1, 64);
+}
+
+TEST(memory_suite, matrix_resource_test) {
+  S21PoolResource pool;
+  S21Matrix first_matrix(6, 6, &pool);
+  S21Matrix second_matrix(6, 6, &pool);
+  for (int i = 0; i < 6; ++i) {
+    for (int j = 0; j < 6; ++j) {
+      first_matrix(i, j) = ((i * 5 + j * 3) % 7 - 3) / 4.0 + 2 * (i == j);
+      second_matrix(i, j) = (i + 2 * j) % 5 - 2;
+    }
+  }
+  const S21Matrix product = first_matrix * second_matrix;
+  const S21Matrix inverse = first_matrix.InverseMatrix();
+  EXPECT_EQ(product.GetResource(), &pool);
+  EXPECT_EQ(inverse.GetResource(), &pool);
+  S21Matrix result(&pool);
+  auto compute = [&]() {
+    result = first_matrix + second_matrix * 2.0;
+    result.MulMatrix(first_matrix.InverseMatrix());
+    result.SumMatrix(first_matrix.Transpose());
+    result.SetRows(7);
+    result.SetRows(6);
+    return result.Determinant() + first_matrix.CalcComplements()(0, 0);
+  };
+  const double expected = compute();
+  // The first pass filled the pool; later passes only recycle its blocks.
+  const long before = global_allocations;
+  for (int pass = 0; pass < 10; ++pass) EXPECT_EQ(compute(), expected);
+  EXPECT_EQ(global_allocations - before, 0);
+  const S21Matrix copy(result);
+  EXPECT_EQ(copy.GetResource(), std::pmr::get_default_resource());
+}
+
+TEST(memory_suite, strassen_test) {
+  // The workspace comes from the resource of the product, so a pool that
+  // served the first product serves the later ones too.
+  S21PoolResource pool;
+  S21Matrix first_matrix(64, 64, &pool);
+  S21Matrix second_matrix(64, 64, &pool);
+  first_matrix.FillingMatrix();
+  second_matrix.FillingMatrix();
+  const S21Matrix expected = first_matrix * second_matrix;
+  S21SetMulAlgorithm(S21MulAlgorithm::kStrassen);
+  S21SetStrassenCrossover(16);
+  S21Matrix result(&pool);
+  // Two passes fill the pool: the product is built while result still
+  // holds the previous one.
+  for (int pass = 0; pass < 2; ++pass) result = first_matrix * second_matrix;
+  const long before = global_allocations;
+  for (int pass = 0; pass < 3; ++pass) {
+    result = first_matrix * second_matrix;
+    EXPECT_LT(RelativeError(result, expected), 1e-13);
+  }
+  EXPECT_EQ(global_allocations - before, 0);
+  // One buffer for the product and one for the workspace
+  CountingResource counting;
+  const S21Matrix counted(first_matrix, &counting);
+  const S21Matrix product = counted * second_matrix;
+  EXPECT_EQ(counting.allocations, 3);
+  EXPECT_TRUE(product == result);
+  S21SetMulAlgorithm(S21MulAlgorithm::kClassical);
+  S21SetStrassenCrossover(0);
+}
+
+// n x n with a dominant diagonal and a few scattered off-diagonal entries
+static S21SparseMatrix SparseOutOfCoreInput(int rows, int cols, int seed) {
+  S21SparseMatrix matrix(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      const int hash = (i * 31 + j * 17 + seed * 7) % 29;
+      if (i == j) {
+        matrix.Insert(i, j, 10.0 + seed);
+      } else if (hash < 3) {
+        matrix.Insert(i, j, (hash - 1.5) / (seed + 1));
+      }
+    }
+  }
+  return matrix;
+}
+
+TEST(sparse_suite, build_and_convert_test) {
+  S21SparseMatrix coo(3, 4);
+  coo.Insert(2, 1, 5);
+  coo.Insert(0, 3, 1);
+  coo.Insert(0, 0, 2);
+  coo.Insert(2, 1, -1);
+  EXPECT_EQ(coo.GetNonZeros(), 4u);
+  EXPECT_EQ(coo(2, 1), 4);
+  const S21SparseMatrix csr = coo.Convert(S21SparseFormat::kCsr);
+  EXPECT_EQ(csr.GetNonZeros(), 3u);
+  EXPECT_EQ(std::vector<int>(csr.outer().begin(), csr.outer().end()),
+            std::vector<int>({0, 2, 2, 3}));
+  EXPECT_EQ(std::vector<int>(csr.inner().begin(), csr.inner().end()),
+            std::vector<int>({0, 3, 1}));
+  const S21SparseMatrix csc = csr.Convert(S21SparseFormat::kCsc);
+  EXPECT_EQ(std::vector<int>(csc.outer().begin(), csc.outer().end()),
+            std::vector<int>({0, 1, 2, 2, 3}));
+  EXPECT_EQ(csc(0, 3), 1);
+  EXPECT_EQ(csc(1, 3), 0);
+  S21Matrix dense(3, 4);
+  dense(0, 0) = 2;
+  dense(0, 3) = 1;
+  dense(2, 1) = 4;
+  EXPECT_TRUE(dense == coo.ToDense());
+  EXPECT_TRUE(dense == csc.ToDense());
+  EXPECT_TRUE(dense == csc.Convert(S21SparseFormat::kCoo).ToDense());
+  const S21SparseMatrix from_dense(dense, S21SparseFormat::kCsc);
+  EXPECT_EQ(from_dense.GetNonZeros(), 3u);
+  EXPECT_TRUE(dense == from_dense.ToDense());
+}
+
+TEST(sparse_suite, multiply_test) {
+  const S21SparseMatrix coo = SparseOutOfCoreInput(50, 40, 1);
+  S21Matrix a = coo.ToDense();
+  S21Matrix b(40, 7);
+  b.FillingMatrix();
+  std::vector<double> x(40);
+  for (int i = 0; i < 40; ++i) x[i] = (i % 5) - 2.0;
+  S21Matrix x_matrix(40, 1);
+  for (int i = 0; i < 40; ++i) x_matrix(i, 0) = x[i];
+  S21Matrix expected = a * b;
+  S21Matrix expected_vector = a * x_matrix;
+  for (S21SparseFormat format : {S21SparseFormat::kCoo, S21SparseFormat::kCsr,
+                                 S21SparseFormat::kCsc}) {
+    const S21SparseMatrix sparse = coo.Convert(format);
+    EXPECT_TRUE(expected == sparse * b);
+    const std::vector<double> y = sparse * x;
+    for (int i = 0; i < 50; ++i) {
+      EXPECT_NEAR(y[i], expected_vector(i, 0), 1e-12);
+    }
+  }
+  // A strided right-hand side goes through the scalar update.
+  S21Matrix b_transposed = b.Transpose();
+  const S21SparseMatrix csr = coo.Convert(S21SparseFormat::kCsr);
+  EXPECT_TRUE(expected == csr.MulMatrix(b_transposed.View().Transposed()));
+}
+
+TEST(sparse_suite, sum_and_transpose_test) {
+  const S21SparseMatrix a = SparseOutOfCoreInput(30, 20, 1);
+  const S21SparseMatrix b = SparseOutOfCoreInput(30, 20, 2);
+  S21Matrix expected = a.ToDense();
+  expected += b.ToDense();
+  const S21SparseMatrix csr = a.Convert(S21SparseFormat::kCsr);
+  const S21SparseMatrix csc = b.Convert(S21SparseFormat::kCsc);
+  EXPECT_TRUE(expected == (a + b).ToDense());
+  EXPECT_TRUE(expected == (csr + csc).ToDense());
+  EXPECT_TRUE(expected == (csc + csr).ToDense());
+  S21SparseMatrix cancelled = csr;
+  S21Matrix negated = a.ToDense();
+  negated.MulNumber(-1);
+  cancelled += S21SparseMatrix(negated);
+  EXPECT_EQ(cancelled.GetNonZeros(), 0u);
+  const S21SparseMatrix transposed = csr.Transpose();
+  EXPECT_EQ(transposed.GetFormat(), S21SparseFormat::kCsc);
+  EXPECT_EQ(transposed.GetRows(), 20);
+  EXPECT_TRUE(csr.ToDense().Transpose() == transposed.ToDense());
+  EXPECT_TRUE(a.ToDense().Transpose() == a.Transpose().ToDense());
+}
+
+TEST(sparse_suite, lu_test) {
+  const S21SparseMatrix matrix = SparseOutOfCoreInput(80, 80, 3);
+  S21Matrix dense = matrix.ToDense();
+  const S21SparseLU lu(matrix);
+  EXPECT_FALSE(lu.IsSingular());
+  std::vector<double> b(80);
+  for (int i = 0; i < 80; ++i) b[i] = i % 7 - 3.0;
+  const std::vector<double> x = lu.Solve(b);
+  const std::vector<double> expected = S21LU(dense).Solve(b);
+  for (int i = 0; i < 80; ++i) {
+    EXPECT_NEAR(x[i], expected[i], 1e-12);
+  }
+  S21Matrix rhs(80, 3);
+  rhs.FillingMatrix();
+  EXPECT_TRUE(S21LU(dense).Solve(rhs) == lu.Solve(rhs));
+  // A zero diagonal forces row exchanges.
+  S21Matrix pivoting(4, 4);
+  const double values[] = {0, 2, 0, 1, 3, 0, 0, 0, 0, 1, 0, 4, 1, 0, 5, 0};
+  std::copy(values, values + 16, pivoting.data());
+  const S21SparseLU pivoted{S21SparseMatrix(pivoting)};
+  EXPECT_NEAR(pivoted.Determinant(), pivoting.Determinant(), 1e-12);
+  EXPECT_TRUE(pivoted.Solve(pivoting) == S21LU(pivoting).Solve(pivoting));
+  EXPECT_LT(pivoted.GetNonZeros(), 16u);
+}
+
+TEST(sparse_suite, exceptional_test) {
+  S21SparseMatrix coo(3, 3);
+  ASSERT_THROW(coo.Insert(3, 0, 1), std::out_of_range);
+  ASSERT_THROW(S21SparseMatrix(-1, 2), std::out_of_range);
+  S21SparseMatrix csr = coo.Convert(S21SparseFormat::kCsr);
+  ASSERT_THROW(csr.Insert(0, 0, 1), std::invalid_argument);
+  ASSERT_THROW(csr(0, 3), std::out_of_range);
+  ASSERT_THROW(csr += S21SparseMatrix(3, 2), std::out_of_range);
+  ASSERT_THROW(csr * std::vector<double>(2), std::out_of_range);
+  ASSERT_THROW(csr * S21Matrix(2, 2), std::out_of_range);
+  ASSERT_THROW(S21SparseLU(S21SparseMatrix(2, 3)), std::out_of_range);
+  coo.Insert(0, 0, 1);
+  coo.Insert(1, 1, 1);
+  const S21SparseLU singular(coo);
+  EXPECT_TRUE(singular.IsSingular());
+  EXPECT_EQ(singular.Determinant(), 0);
+  ASSERT_THROW(singular.Solve(std::vector<double>(3)), std::invalid_argument);
+}
+
+// Well-conditioned matrices that differ from one index to the next and
+// need row exchanges now and then.
+static S21MatrixBatch BatchOutOfCoreInput(int count, int n, int seed) {
+  S21MatrixBatch batch(count, n, n);
+  for (int index = 0; index < count; ++index) {
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) {
+        const int hash = (index * 13 + i * 7 + j * 5 + seed) % 17;
+        batch(index, i, j) =
+            (hash - 8) / 8.0 + (i == (j + index) % n ? n + 1 : 0);
+      }
+    }
+  }
+  return batch;
+}
+
+TEST(batch_suite, layout_test) {
+  S21MatrixBatch batch(20, 2, 3);
+  EXPECT_EQ(batch.GetCount(), 20);
+  EXPECT_EQ(batch.GetRows(), 2);
+  EXPECT_EQ(batch.GetCols(), 3);
+  const int lanes = S21MatrixBatch::kLanes;
+  batch(17, 1, 0) = 5;
+  EXPECT_EQ(batch.data()[(17 / lanes * 6 + 1 * 3) * lanes + 17 % lanes], 5);
+  S21Matrix matrix(2, 3);
+  matrix.FillingMatrix();
+  batch.Set(1, matrix.View());
+  EXPECT_TRUE(batch.Get(1) == matrix);
+  EXPECT_EQ(batch.View(1)(1, 2), matrix(1, 2));
+  S21MatrixBatch copy(batch);
+  copy.MulNumber(2);
+  copy.SubMatrix(batch);
+  EXPECT_TRUE(copy.Get(1) == matrix);
+  copy.SumMatrix(batch);
+  matrix.MulNumber(2);
+  EXPECT_TRUE(copy.Get(1) == matrix);
+  S21MatrixBatch transposed = copy.Transpose();
+  EXPECT_EQ(transposed.GetRows(), 3);
+  EXPECT_TRUE(transposed.Get(1) == matrix.Transpose());
+  EXPECT_EQ(transposed(17, 0, 1), 10);
+}
+
+TEST(batch_suite, multiply_test) {
+  for (int n : {3, 4, 7}) {
+    S21MatrixBatch a = BatchOutOfCoreInput(37, n, 1);
+    const S21MatrixBatch b = BatchOutOfCoreInput(37, n, 2);
+    S21MatrixBatch product = a;
+    product.MulMatrix(b);
+    for (int index = 0; index < 37; ++index) {
+      S21Matrix expected = a.Get(index) * b.Get(index);
+      EXPECT_TRUE(product.Get(index) == expected);
+    }
+  }
+  S21MatrixBatch wide(5, 2, 3);
+  wide.MulMatrix(S21MatrixBatch(5, 3, 4));
+  EXPECT_EQ(wide.GetCols(), 4);
+}
+
+TEST(batch_suite, determinant_and_inverse_test) {
+  for (int n : {1, 2, 3, 4, 6}) {
+    const S21MatrixBatch batch = BatchOutOfCoreInput(21, n, 3);
+    const std::vector<double> det = batch.Determinant();
+    const S21MatrixBatch inverse = batch.InverseMatrix();
+    ASSERT_EQ(det.size(), 21u);
+    for (int index = 0; index < 21; ++index) {
+      S21Matrix matrix = batch.Get(index);
+      EXPECT_NEAR(det[index], matrix.Determinant(),
+                  1e-9 * std::abs(matrix.Determinant()) + 1e-12);
+      EXPECT_TRUE(inverse.Get(index) == matrix.InverseMatrix());
+    }
+  }
+  S21BasicMatrixBatch<float> floats(20, 4, 4);
+  for (int index = 0; index < 20; ++index) {
+    for (int i = 0; i < 4; ++i) floats(index, i, (i + index) % 4) = index + 1;
+  }
+  const std::vector<float> float_det = floats.Determinant();
+  for (int index = 0; index < 20; ++index) {
+    S21BasicMatrix<float> matrix = floats.Get(index);
+    EXPECT_FLOAT_EQ(float_det[index], matrix.Determinant());
+  }
+}
+
+TEST(batch_suite, exceptional_test) {
+  ASSERT_THROW(S21MatrixBatch(-1, 2, 2), std::out_of_range);
+  S21MatrixBatch batch = BatchOutOfCoreInput(9, 3, 4);
+  ASSERT_THROW(batch(9, 0, 0), std::out_of_range);
+  ASSERT_THROW(batch(0, 3, 0), std::out_of_range);
+  ASSERT_THROW(batch.SumMatrix(S21MatrixBatch(8, 3, 3)), std::out_of_range);
+  ASSERT_THROW(batch.MulMatrix(S21MatrixBatch(9, 2, 3)), std::out_of_range);
+  ASSERT_THROW(batch.Set(0, S21Matrix(2, 2).View()), std::out_of_range);
+  ASSERT_THROW(S21MatrixBatch(2, 2, 3).Determinant(), std::out_of_range);
+  ASSERT_THROW(S21MatrixBatch(2, 3, 2).InverseMatrix(), std::out_of_range);
+  // One singular matrix among regular ones.
+  for (int j = 0; j < 3; ++j) batch(5, 2, j) = 2 * batch(5, 0, j);
+  EXPECT_EQ(batch.Determinant()[5], 0);
+  ASSERT_THROW(batch.InverseMatrix(), std::invalid_argument);
+}
+
+// A file in the temporary directory, removed again at the end of a test.
+class TemporaryFile {
+ public:
+  explicit TemporaryFile(const std::string &name)
+      : path_((std::filesystem::temp_directory_path() / name).string()) {}
+  ~TemporaryFile() { std::filesystem::remove(path_); }
+  const std::string &Path() const { return path_; }
+
+ private:
+  std::string path_;
+};
+
+TEST(io_suite, save_load_test) {
+  const TemporaryFile file("s21_io_save_load.s21m");
+  S21Matrix matrix(37, 53);
+  matrix.FillingMatrix();
+  matrix(5, 7) = -1.25e300;
+  S21SaveMatrix(matrix, file.Path());
+  const S21MatrixFileHeader header = S21ReadMatrixHeader(file.Path());
+  EXPECT_EQ(header.rows, 37);
+  EXPECT_EQ(header.cols, 53);
+  EXPECT_EQ(header.element_type, S21ElementType::kDouble);
+  EXPECT_EQ(header.data_offset % 64, 0u);
+  EXPECT_EQ(std::filesystem::file_size(file.Path()),
+            header.data_offset + 37 * 53 * sizeof(double));
+  S21Matrix loaded = S21LoadMatrix(file.Path());
+  EXPECT_TRUE(loaded == matrix);
+  EXPECT_EQ(loaded(5, 7), -1.25e300);
+  // Strided views are written packed.
+  S21SaveMatrix(matrix.Block(3, 4, 10, 6), file.Path());
+  EXPECT_TRUE(S21LoadMatrix(file.Path()).EqMatrix(matrix.Block(3, 4, 10, 6)));
+  S21SaveMatrix(matrix.View().Transposed(), file.Path());
+  EXPECT_TRUE(S21LoadMatrix(file.Path()) == matrix.Transpose());
+  S21SaveMatrix(S21Matrix(), file.Path());
+  EXPECT_EQ(S21LoadMatrix(file.Path()).GetRows(), 0);
+  S21BasicMatrix<std::complex<double>> complex(3, 2);
+  complex(2, 1) = {1.5, -2};
+  S21SaveMatrix(complex, file.Path());
+  EXPECT_TRUE(S21LoadMatrix<std::complex<double>>(file.Path()) == complex);
+  S21BasicMatrix<float> floats(5, 3);
+  floats.FillingMatrix();
+  S21SaveMatrix(floats, file.Path());
+  EXPECT_TRUE(S21LoadMatrix<float>(file.Path()) == floats);
+}
+
+TEST(io_suite, mapped_test) {
+  const TemporaryFile file("s21_io_mapped.s21m");
+  S21Matrix matrix(20, 30);
+  matrix.FillingMatrix();
+  S21SaveMatrix(matrix, file.Path());
+  const S21MappedMatrix mapped(file.Path(), S21MapMode::kReadOnly, true);
+  EXPECT_EQ(mapped.GetRows(), 20);
+  EXPECT_EQ(mapped.GetCols(), 30);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(mapped.data()) % 64, 0u);
+  EXPECT_EQ(mapped(19, 29), matrix(19, 29));
+  EXPECT_TRUE(matrix.EqMatrix(mapped.View()));
+  S21Matrix product(20, 20);
+  S21Matrix::Gemm(1, mapped.View(), matrix.View().Transposed(), 0, product);
+  EXPECT_TRUE(product == matrix * matrix.Transpose());
+  S21MappedMatrix writable(file.Path(), S21MapMode::kCopyOnWrite);
+  writable.WritableView()(0, 0) = 42;
+  EXPECT_EQ(writable(0, 0), 42);
+  EXPECT_EQ(mapped(0, 0), matrix(0, 0));
+  EXPECT_EQ(S21LoadMatrix(file.Path())(0, 0), matrix(0, 0));
+  S21MappedMatrix moved(std::move(writable));
+  EXPECT_EQ(moved(0, 0), 42);
+  EXPECT_EQ(writable.data(), nullptr);
+  S21MappedMatrix read_only(file.Path());
+  ASSERT_THROW(read_only.WritableView(), std::invalid_argument);
+  ASSERT_THROW(read_only(20, 0), std::out_of_range);
+}
+
+TEST(io_suite, byte_order_test) {
+  const TemporaryFile file("s21_io_byte_order.s21m");
+  S21Matrix matrix(4, 5);
+  matrix.FillingMatrix();
+  S21SaveMatrix(matrix, file.Path());
+  // Rewrite the file as a machine of the other byte order would have.
+  std::vector<char> bytes(std::filesystem::file_size(file.Path()));
+  std::ifstream(file.Path(), std::ios::binary).read(bytes.data(),
+                                                    bytes.size());
+  auto swap = [&bytes](std::size_t offset, std::size_t size) {
+    std::reverse(bytes.begin() + offset, bytes.begin() + offset + size);
+  };
+  swap(4, 4);
+  swap(8, 2);
+  swap(12, 4);
+  for (std::size_t offset = 16; offset < 64; offset += 8) swap(offset, 8);
+  for (std::size_t offset = 64; offset < bytes.size(); offset += 8) {
+    swap(offset, 8);
+  }
+  std::ofstream(file.Path(), std::ios::binary).write(bytes.data(),
+                                                     bytes.size());
+  const S21MatrixFileHeader header = S21ReadMatrixHeader(file.Path());
+  EXPECT_NE(header.byte_order, S21MatrixFileHeader::kByteOrder);
+  EXPECT_EQ(header.rows, 4);
+  // The checksum covers the bytes as stored, so it no longer matches.
+  ASSERT_THROW(S21LoadMatrix(file.Path()), std::invalid_argument);
+  EXPECT_TRUE(S21LoadMatrix(file.Path(), false) == matrix);
+  ASSERT_THROW(S21MappedMatrix{file.Path()}, std::invalid_argument);
+}
+
+TEST(io_suite, exceptional_test) {
+  const TemporaryFile file("s21_io_exceptional.s21m");
+  ASSERT_THROW(S21LoadMatrix(file.Path()), std::system_error);
+  ASSERT_THROW(S21MappedMatrix{file.Path()}, std::system_error);
+  std::ofstream(file.Path()) << "rows cols and some numbers";
+  ASSERT_THROW(S21LoadMatrix(file.Path()), std::invalid_argument);
+  S21Matrix matrix(6, 6);
+  matrix.FillingMatrix();
+  S21SaveMatrix(matrix, file.Path());
+  ASSERT_THROW(S21LoadMatrix<float>(file.Path()), std::invalid_argument);
+  ASSERT_THROW(S21BasicMappedMatrix<float>{file.Path()},
+               std::invalid_argument);
+  {
+    std::fstream stream(file.Path(),
+                        std::ios::binary | std::ios::in | std::ios::out);
+    stream.seekp(64 + 8 * 10 + 7);
+    stream.put('x');
+  }
+  ASSERT_THROW(S21LoadMatrix(file.Path()), std::invalid_argument);
+  ASSERT_THROW(S21MappedMatrix(file.Path(), S21MapMode::kReadOnly, true),
+               std::invalid_argument);
+  EXPECT_FALSE(S21LoadMatrix(file.Path(), false) == matrix);
+  std::filesystem::resize_file(file.Path(), 64 + 8 * 35);
+  ASSERT_THROW(S21LoadMatrix(file.Path(), false), std::invalid_argument);
+  // 2^30 x 2^30 complex elements take 2^64 bytes, which wraps around to 0
+  S21SaveMatrix(S21BasicMatrix<std::complex<double>>(2, 2), file.Path());
+  {
+    std::fstream stream(file.Path(),
+                        std::ios::binary | std::ios::in | std::ios::out);
+    const std::int64_t size[2] = {std::int64_t{1} << 30,
+                                  std::int64_t{1} << 30};
+    const std::uint64_t data_bytes = 0;
+    stream.seekp(16);
+    stream.write(reinterpret_cast<const char*>(size), sizeof(size));
+    stream.seekp(40);
+    stream.write(reinterpret_cast<const char*>(&data_bytes),
+                 sizeof(data_bytes));
+  }
+  ASSERT_THROW(S21ReadMatrixHeader(file.Path()), std::invalid_argument);
+  ASSERT_THROW(S21LoadMatrix<std::complex<double>>(file.Path()),
+               std::invalid_argument);
+  ASSERT_THROW(S21BasicMappedMatrix<std::complex<double>>{file.Path()},
+               std::invalid_argument);
+}
+
+S21Matrix OutOfCoreInput(int rows, int cols, int seed) {
+  S21Matrix matrix(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      matrix(i, j) = ((i * 31 + j * 17 + seed) % 23 - 11) / 4.0;
+    }
+  }
+  return matrix;
+}
+
+TEST(out_of_core_suite, multiply_test) {
+  const TemporaryFile a_file("s21_ooc_a.s21m");
+  const TemporaryFile b_file("s21_ooc_b.s21m");
+  const TemporaryFile c_file("s21_ooc_c.s21m");
+  // A few kilobytes split the matrices into many tiles, partial ones at the
+  // edges included.
+  S21SetOutOfCoreBudget(4096);
+  S21Matrix a = OutOfCoreInput(37, 29, 1);
+  S21Matrix b = OutOfCoreInput(29, 41, 2);
+  S21SaveMatrix(a, a_file.Path());
+  S21SaveMatrix(b, b_file.Path());
+  const S21OutOfCoreMatrix disk_a(a_file.Path());
+  const S21OutOfCoreMatrix disk_b(b_file.Path());
+  const S21OutOfCoreMatrix product = disk_a.MulMatrix(disk_b, c_file.Path());
+  EXPECT_EQ(product.GetRows(), 37);
+  EXPECT_EQ(product.GetCols(), 41);
+  // Loading verifies the checksum of the result.
+  EXPECT_TRUE(S21LoadMatrix(c_file.Path()) == a * b);
+  S21SetOutOfCoreBudget(std::size_t{1} << 20);
+  disk_a.MulMatrix(disk_b, c_file.Path());
+  EXPECT_TRUE(S21LoadMatrix(c_file.Path()) == a * b);
+  ASSERT_THROW(disk_a.MulMatrix(disk_a, c_file.Path()), std::out_of_range);
+  ASSERT_THROW(disk_a.MulMatrix(disk_b, b_file.Path()),
+               std::invalid_argument);
+  S21SetOutOfCoreBudget(0);
+}
+
+TEST(out_of_core_suite, transpose_and_sum_test) {
+  const TemporaryFile a_file("s21_ooc_a.s21m");
+  const TemporaryFile b_file("s21_ooc_b.s21m");
+  const TemporaryFile c_file("s21_ooc_c.s21m");
+  S21SetOutOfCoreBudget(4096);
+  S21Matrix a = OutOfCoreInput(45, 19, 3);
+  S21Matrix b = OutOfCoreInput(45, 19, 4);
+  S21SaveMatrix(a, a_file.Path());
+  S21SaveMatrix(b, b_file.Path());
+  S21OutOfCoreMatrix disk_a(a_file.Path());
+  const S21OutOfCoreMatrix disk_b(b_file.Path());
+  disk_a.Transpose(c_file.Path());
+  S21Matrix transposed = S21LoadMatrix(c_file.Path());
+  EXPECT_EQ(transposed.GetRows(), 19);
+  EXPECT_EQ(std::memcmp(transposed.data(), a.Transpose().data(),
+                        sizeof(double) * 45 * 19),
+            0);
+  disk_a.SumMatrix(disk_b);
+  S21Matrix sum = a + b;
+  S21Matrix loaded = S21LoadMatrix(a_file.Path());
+  EXPECT_EQ(std::memcmp(loaded.data(), sum.data(), sizeof(double) * 45 * 19),
+            0);
+  disk_a.SubMatrix(disk_a);
+  EXPECT_TRUE(S21LoadMatrix(a_file.Path()) == S21Matrix(45, 19));
+  ASSERT_THROW(disk_a.SumMatrix(S21OutOfCoreMatrix(c_file.Path())),
+               std::out_of_range);
+  S21SetOutOfCoreBudget(0);
+}
+
+TEST(out_of_core_suite, block_test) {
+  const TemporaryFile a_file("s21_ooc_a.s21m");
+  const TemporaryFile b_file("s21_ooc_b.s21m");
+  {
+    S21OutOfCoreMatrix matrix(a_file.Path(), 10, 12);
+    EXPECT_TRUE(S21LoadMatrix(a_file.Path()) == S21Matrix(10, 12));
+    S21Matrix block = OutOfCoreInput(4, 3, 5);
+    matrix.WriteBlock(2, 7, block.View());
+    matrix.Sync();
+    S21Matrix expected(10, 12);
+    expected.Block(2, 7, 4, 3).Assign(block.View());
+    EXPECT_TRUE(S21LoadMatrix(a_file.Path()) == expected);
+    EXPECT_TRUE(matrix.ReadBlock(2, 7, 4, 3) == block);
+    // Strided views on both sides
+    matrix.WriteBlock(0, 0, block.View().Transposed());
+    S21Matrix read(4, 3);
+    matrix.ReadBlock(0, 0, read.View().Transposed());
+    EXPECT_TRUE(read == block);
+    ASSERT_THROW(matrix.ReadBlock(8, 0, 3, 1), std::out_of_range);
+    ASSERT_THROW(matrix.WriteBlock(0, 10, block.View()), std::out_of_range);
+  }
+  // The destructor brought the checksum up to date.
+  EXPECT_NO_THROW(S21LoadMatrix(a_file.Path()));
+  ASSERT_THROW(S21OutOfCoreMatrix(b_file.Path(), -1, 2), std::out_of_range);
+  EXPECT_FALSE(std::filesystem::exists(b_file.Path()));
+  ASSERT_THROW(S21BasicOutOfCoreMatrix<float>{a_file.Path()},
+               std::invalid_argument);
+}
+
+TEST(stats_suite, scope_test) {
+  S21StatsReset();
+  {
+    const S21StatsScope outer(S21Operation::kInverseMatrix, {3, 3, 0}, 54);
+    S21StatsRecordAllocation(72);
+    // Nested operations belong to the outer one.
+    const S21StatsScope inner(S21Operation::kDeterminant, {3, 3, 0}, 18);
+    S21StatsRecordAllocation(8);
+  }
+  S21StatsRecordAllocation(16);
+  for (int i = 0; i < 2; ++i) {
+    const S21StatsScope scope(S21Operation::kMulMatrix, {2, 4, 3}, 48);
+  }
+  const S21StatsSnapshot stats = S21StatsSnapshotNow();
+  const S21OperationStats& inverse = stats[S21Operation::kInverseMatrix];
+  EXPECT_EQ(inverse.calls, 1u);
+  EXPECT_EQ(inverse.flops, 54u);
+  EXPECT_EQ(inverse.allocated_bytes, 80u);
+  std::uint64_t latencies = 0;
+  for (std::uint64_t bucket : inverse.latency_buckets) latencies += bucket;
+  EXPECT_EQ(latencies, 1u);
+  EXPECT_EQ(stats[S21Operation::kDeterminant].calls, 0u);
+  EXPECT_EQ(stats[S21Operation::kOther].allocated_bytes, 16u);
+  const S21OperationStats& product = stats[S21Operation::kMulMatrix];
+  EXPECT_EQ(product.calls, 2u);
+  EXPECT_EQ(product.flops, 96u);
+  ASSERT_EQ(product.shapes.size(), 1u);
+  EXPECT_EQ(product.shapes.begin()->first.ToString(), "2x3x4");
+  EXPECT_EQ(product.shapes.begin()->second, 2u);
+  S21StatsReset();
+  EXPECT_EQ(S21StatsSnapshotNow()[S21Operation::kMulMatrix].calls, 0u);
+  EXPECT_TRUE(S21StatsSnapshotNow()[S21Operation::kMulMatrix].shapes.empty());
+}
+
+TEST(stats_suite, shape_limit_test) {
+  S21StatsReset();
+  for (int i = 0; i <= static_cast<int>(kS21StatsMaxShapes); ++i) {
+    const S21StatsScope scope(S21Operation::kSumMatrix, {i + 1, 1, 0}, 0);
+  }
+  const S21StatsSnapshot stats = S21StatsSnapshotNow();
+  const S21OperationStats& sum = stats[S21Operation::kSumMatrix];
+  EXPECT_EQ(sum.calls, kS21StatsMaxShapes + 1);
+  EXPECT_EQ(sum.shapes.size(), kS21StatsMaxShapes);
+  S21StatsReset();
+}
+
+TEST(stats_suite, dump_test) {
+  S21StatsReset();
+  {
+    const S21StatsScope scope(S21Operation::kTranspose, {5, 7, 0}, 0);
+    S21StatsRecordAllocation(280);
+  }
+  const S21StatsSnapshot stats = S21StatsSnapshotNow();
+  const std::string prometheus = stats.ToPrometheus();
+  EXPECT_NE(prometheus.find("# TYPE s21_matrix_latency_seconds histogram\n"),
+            std::string::npos);
+  EXPECT_NE(prometheus.find("s21_matrix_calls_total{operation=\"Transpose\"}"
+                            " 1\n"),
+            std::string::npos);
+  EXPECT_NE(prometheus.find("s21_matrix_latency_seconds_bucket{operation="
+                            "\"Transpose\",le=\"+Inf\"} 1\n"),
+            std::string::npos);
+  EXPECT_NE(prometheus.find("s21_matrix_latency_seconds_count{operation="
+                            "\"Transpose\"} 1\n"),
+            std::string::npos);
+  EXPECT_NE(prometheus.find("s21_matrix_allocated_bytes_total{operation="
+                            "\"Transpose\"} 280\n"),
+            std::string::npos);
+  EXPECT_NE(prometheus.find("s21_matrix_shape_calls_total{operation="
+                            "\"Transpose\",shape=\"5x7\"} 1\n"),
+            std::string::npos);
+  const std::string json = stats.ToJson();
+  EXPECT_NE(json.find("{\"operation\": \"Transpose\", \"calls\": 1, "),
+            std::string::npos);
+  EXPECT_NE(json.find("\"shapes\": {\"5x7\": 1}"), std::string::npos);
+  EXPECT_NE(json.find("\"latency_bounds_seconds\": [1e-06, 4e-06, "),
+            std::string::npos);
+  S21StatsReset();
+}
+
+TEST(stats_suite, operations_test) {
+  S21StatsReset();
+  S21Matrix a(4, 3);
+  S21Matrix b(3, 5);
+  a.MulMatrix(b);
+  S21Matrix square(6, 6);
+  square(0, 0) = 1;
+  square.Determinant();
+  const S21StatsSnapshot stats = S21StatsSnapshotNow();
+  const S21OperationStats& product = stats[S21Operation::kMulMatrix];
+  if (S21StatsEnabled()) {
+    EXPECT_EQ(product.calls, 1u);
+    EXPECT_EQ(product.flops, 120u);
+    EXPECT_EQ(product.shapes.count(S21Shape{4, 5, 3}), 1u);
+    EXPECT_GE(product.allocated_bytes, 4u * 5 * sizeof(double));
+    EXPECT_EQ(stats[S21Operation::kDeterminant].calls, 1u);
+    // The Gemm inside MulMatrix is not a call of its own.
+    EXPECT_EQ(stats[S21Operation::kGemm].calls, 0u);
+    EXPECT_GT(stats[S21Operation::kOther].allocated_bytes, 0u);
+  } else {
+    EXPECT_EQ(product.calls, 0u);
+    EXPECT_EQ(stats[S21Operation::kOther].allocated_bytes, 0u);
+  }
+  S21StatsReset();
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
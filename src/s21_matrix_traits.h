@@ -0,0 +1,39 @@
+#ifndef SRC_S21_MATRIX_TRAITS_H_
+#define SRC_S21_MATRIX_TRAITS_H_
+
+#include <complex>
+
+// Per-element-type constants of S21BasicMatrix. Real is the type of a
+// magnitude (std::abs of an element) and kEpsilon the absolute tolerance
+// EqMatrix allows between two elements: 1e-07 for double as before, and
+// roughly the square root of machine epsilon for the other types, so float
+// compares at a tolerance it can actually resolve. Complex elements use the
+// constants of their component type.
+template <typename T>
+struct S21MatrixTraits;
+
+template <>
+struct S21MatrixTraits<float> {
+  using Real = float;
+  static constexpr Real kEpsilon = 1e-4f;
+};
+
+template <>
+struct S21MatrixTraits<double> {
+  using Real = double;
+  static constexpr Real kEpsilon = 1e-07;
+};
+
+template <>
+struct S21MatrixTraits<long double> {
+  using Real = long double;
+  static constexpr Real kEpsilon = 1e-09L;
+};
+
+template <typename R>
+struct S21MatrixTraits<std::complex<R>> {
+  using Real = R;
+  static constexpr Real kEpsilon = S21MatrixTraits<R>::kEpsilon;
+};
+
+#endif  // SRC_S21_MATRIX_TRAITS_H_
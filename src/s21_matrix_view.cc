@@ -0,0 +1,158 @@
+#include "s21_matrix_view.h"
+
+#include <atomic>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+// Runs run(dst_run, src_run, length) over the rows of two rows x cols
+// blocks with unit column stride (as one run when both are packed), and
+// element(dst_element, src_element) over every element otherwise. Large
+// blocks are split across the shared thread pool.
+template <typename D, typename S, typename Run, typename Element>
+void ForEachRun(int rows, int cols, D* dst, int dst_row_stride,
+                int dst_col_stride, const S* src, int src_row_stride,
+                int src_col_stride, Run run, Element element) {
+  if (rows <= 0 || cols <= 0) return;
+  if (dst_col_stride == 1 && src_col_stride == 1) {
+    if (dst_row_stride == cols && src_row_stride == cols) {
+      S21ParallelFor(0, static_cast<std::ptrdiff_t>(rows) * cols, 1.0,
+                     [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                       run(dst + begin, src + begin,
+                           static_cast<std::size_t>(end - begin));
+                     });
+    } else {
+      S21ParallelFor(0, rows, cols,
+                     [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                       for (std::ptrdiff_t i = begin; i < end; ++i) {
+                         run(dst + i * dst_row_stride,
+                             src + i * src_row_stride,
+                             static_cast<std::size_t>(cols));
+                       }
+                     });
+    }
+  } else {
+    S21ParallelFor(0, rows, cols,
+                   [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                     for (std::ptrdiff_t i = begin; i < end; ++i) {
+                       D* dst_row = dst + i * dst_row_stride;
+                       const S* src_row = src + i * src_row_stride;
+                       for (std::ptrdiff_t j = 0; j < cols; ++j) {
+                         element(dst_row[j * dst_col_stride],
+                                 src_row[j * src_col_stride]);
+                       }
+                     }
+                   });
+  }
+}
+
+}  // namespace
+
+template <typename T>
+void S21StridedUpdate(S21StridedOp op, int rows, int cols, T* dst,
+                      int dst_row_stride, int dst_col_stride, const T* src,
+                      int src_row_stride, int src_col_stride) {
+  if (S21Aliases(S21BasicMatrixView<const T>(src, rows, cols, src_row_stride,
+                                             src_col_stride),
+                 S21BasicMatrixView<const T>(dst, rows, cols, dst_row_stride,
+                                             dst_col_stride))) {
+    // Packed aside first, or the update would read what it already wrote
+    std::vector<T> packed(static_cast<std::size_t>(rows) * cols);
+    S21StridedUpdate(S21StridedOp::kCopy, rows, cols, packed.data(), cols, 1,
+                     src, src_row_stride, src_col_stride);
+    S21StridedUpdate(op, rows, cols, dst, dst_row_stride, dst_col_stride,
+                     packed.data(), cols, 1);
+    return;
+  }
+  const S21BasicSimdKernels<T>& simd = S21SimdActive<T>();
+  if (op == S21StridedOp::kCopy) {
+    ForEachRun(rows, cols, dst, dst_row_stride, dst_col_stride, src,
+               src_row_stride, src_col_stride, simd.copy,
+               [](T& d, const T& s) { d = s; });
+  } else if (op == S21StridedOp::kAdd) {
+    ForEachRun(rows, cols, dst, dst_row_stride, dst_col_stride, src,
+               src_row_stride, src_col_stride, simd.add,
+               [](T& d, const T& s) { d += s; });
+  } else {
+    ForEachRun(rows, cols, dst, dst_row_stride, dst_col_stride, src,
+               src_row_stride, src_col_stride, simd.sub,
+               [](T& d, const T& s) { d -= s; });
+  }
+}
+
+template <typename T>
+void S21StridedScale(int rows, int cols, T* dst, int row_stride,
+                     int col_stride, T number) {
+  const S21BasicSimdKernels<T>& simd = S21SimdActive<T>();
+  ForEachRun(
+      rows, cols, dst, row_stride, col_stride, dst, row_stride, col_stride,
+      [&](T* run, const T*, std::size_t n) { simd.scale(run, number, n); },
+      [&](T& d, const T&) { d *= number; });
+}
+
+template <typename T>
+void S21StridedFill(int rows, int cols, T* dst, int row_stride,
+                    int col_stride, T value) {
+  const S21BasicSimdKernels<T>& simd = S21SimdActive<T>();
+  ForEachRun(
+      rows, cols, dst, row_stride, col_stride, dst, row_stride, col_stride,
+      [&](T* run, const T*, std::size_t n) { simd.fill(run, value, n); },
+      [&](T& d, const T&) { d = value; });
+}
+
+template <typename T>
+bool S21StridedEqual(int rows, int cols, const T* a, int a_row_stride,
+                     int a_col_stride, const T* b, int b_row_stride,
+                     int b_col_stride,
+                     typename S21MatrixTraits<T>::Real epsilon) {
+  const S21BasicSimdKernels<T>& simd = S21SimdActive<T>();
+  std::atomic<bool> equal(true);
+  ForEachRun(
+      rows, cols, a, a_row_stride, a_col_stride, b, b_row_stride,
+      b_col_stride,
+      [&](const T* a_run, const T* b_run, std::size_t n) {
+        if (equal.load(std::memory_order_relaxed) &&
+            !simd.equal(a_run, b_run, n, epsilon)) {
+          equal.store(false, std::memory_order_relaxed);
+        }
+      },
+      [&](const T& x, const T& y) {
+        if (std::abs(x - y) > epsilon) {
+          equal.store(false, std::memory_order_relaxed);
+        }
+      });
+  return equal.load();
+}
+
+template void S21StridedUpdate(S21StridedOp, int, int, float*, int, int,
+                               const float*, int, int);
+template void S21StridedUpdate(S21StridedOp, int, int, double*, int, int,
+                               const double*, int, int);
+template void S21StridedUpdate(S21StridedOp, int, int, long double*, int,
+                               int, const long double*, int, int);
+template void S21StridedUpdate(S21StridedOp, int, int,
+                               std::complex<double>*, int, int,
+                               const std::complex<double>*, int, int);
+template void S21StridedScale(int, int, float*, int, int, float);
+template void S21StridedScale(int, int, double*, int, int, double);
+template void S21StridedScale(int, int, long double*, int, int, long double);
+template void S21StridedScale(int, int, std::complex<double>*, int, int,
+                              std::complex<double>);
+template void S21StridedFill(int, int, float*, int, int, float);
+template void S21StridedFill(int, int, double*, int, int, double);
+template void S21StridedFill(int, int, long double*, int, int, long double);
+template void S21StridedFill(int, int, std::complex<double>*, int, int,
+                             std::complex<double>);
+template bool S21StridedEqual(int, int, const float*, int, int, const float*,
+                              int, int, float);
+template bool S21StridedEqual(int, int, const double*, int, int,
+                              const double*, int, int, double);
+template bool S21StridedEqual(int, int, const long double*, int, int,
+                              const long double*, int, int, long double);
+template bool S21StridedEqual(int, int, const std::complex<double>*, int, int,
+                              const std::complex<double>*, int, int, double);
@@ -0,0 +1,239 @@
+#ifndef SRC_S21_MATRIX_VIEW_H_
+#define SRC_S21_MATRIX_VIEW_H_
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+
+#include "s21_matrix_expr.h"
+#include "s21_matrix_traits.h"
+
+// Strided elementwise kernels shared by S21BasicMatrix and its views.
+// Element (i, j) of a block lives at data[i * row_stride + j * col_stride];
+// blocks with unit column stride run through the SIMD kernels of their
+// element type, row by row, on the shared thread pool. Defined for float,
+// double, long double and std::complex<double>.
+enum class S21StridedOp { kCopy, kAdd, kSub };
+
+template <typename T>
+void S21StridedUpdate(S21StridedOp op, int rows, int cols, T* dst,
+                      int dst_row_stride, int dst_col_stride, const T* src,
+                      int src_row_stride, int src_col_stride);
+template <typename T>
+void S21StridedScale(int rows, int cols, T* dst, int row_stride,
+                     int col_stride, T number);
+template <typename T>
+void S21StridedFill(int rows, int cols, T* dst, int row_stride,
+                    int col_stride, T value);
+template <typename T>
+bool S21StridedEqual(int rows, int cols, const T* a, int a_row_stride,
+                     int a_col_stride, const T* b, int b_row_stride,
+                     int b_col_stride,
+                     typename S21MatrixTraits<T>::Real epsilon);
+
+// Non-owning window onto matrix storage: a block, a row, a column, a
+// transpose of an S21Matrix, or an external buffer. Views never allocate and
+// are cheap to copy; copying or assigning a view rebinds it, while Assign,
+// SumMatrix and friends write through it. A view must not outlive the
+// storage it refers to. T is the element type, const-qualified for a
+// read-only view: double for S21MatrixView and const double for
+// S21MatrixConstView.
+template <typename T>
+class S21BasicMatrixView : public S21MatrixExpr<S21BasicMatrixView<T>> {
+ public:
+  using Value = std::remove_const_t<T>;
+  using ConstView = S21BasicMatrixView<const Value>;
+
+ private:
+  using Matrix = std::conditional_t<std::is_const<T>::value,
+                                    const S21BasicMatrix<Value>,
+                                    S21BasicMatrix<Value>>;
+
+ public:
+  // Constructors
+  S21BasicMatrixView()
+      : data_(nullptr), rows_(0), cols_(0), row_stride_(0), col_stride_(0) {}
+  S21BasicMatrixView(T* data, int rows, int cols, int row_stride,
+                     int col_stride = 1)
+      : data_(data),
+        rows_(rows),
+        cols_(cols),
+        row_stride_(row_stride),
+        col_stride_(col_stride) {
+    if (rows < 0 || cols < 0) {
+      throw std::out_of_range("Incorrect size of matrix");
+    }
+  }
+  // Whole-matrix view; defined in s21_matrix_oop.h.
+  S21BasicMatrixView(Matrix& matrix);
+  // A mutable view converts to a read-only one.
+  template <typename U, typename = std::enable_if_t<
+                            std::is_same<const U, T>::value &&
+                            !std::is_same<U, T>::value>>
+  S21BasicMatrixView(const S21BasicMatrixView<U>& other)
+      : S21BasicMatrixView(other.data(), other.GetRows(), other.GetCols(),
+                           other.RowStride(), other.ColStride()) {}
+  // Accessors
+  T* data() const { return data_; }
+  int GetRows() const { return rows_; }
+  int GetCols() const { return cols_; }
+  int RowStride() const { return row_stride_; }
+  int ColStride() const { return col_stride_; }
+  bool Empty() const { return rows_ == 0 || cols_ == 0 || !data_; }
+  Value Coeff(int i, int j) const { return *Element(i, j); }
+  T& operator()(int i, int j) const {
+    if (rows_ <= i || i < 0 || cols_ <= j || j < 0) {
+      throw std::out_of_range("The index out of matrix limit");
+    }
+    return *Element(i, j);
+  }
+  // Sub-views
+  S21BasicMatrixView Block(int row, int col, int rows, int cols) const {
+    if (row < 0 || col < 0 || rows < 0 || cols < 0 || row + rows > rows_ ||
+        col + cols > cols_) {
+      throw std::out_of_range("The index out of matrix limit");
+    }
+    return S21BasicMatrixView(Element(row, col), rows, cols, row_stride_,
+                              col_stride_);
+  }
+  S21BasicMatrixView Row(int i) const { return Block(i, 0, 1, cols_); }
+  S21BasicMatrixView Col(int j) const { return Block(0, j, rows_, 1); }
+  S21BasicMatrixView Transposed() const {
+    return S21BasicMatrixView(data_, cols_, rows_, col_stride_, row_stride_);
+  }
+  // Operations, writing through the view
+  template <typename E>
+  void Assign(const S21MatrixExpr<E>& expr) const;
+  void Assign(const ConstView& other) const {
+    CheckSize(other);
+    S21StridedUpdate(S21StridedOp::kCopy, rows_, cols_, data_, row_stride_,
+                     col_stride_, other.data(), other.RowStride(),
+                     other.ColStride());
+  }
+  void SumMatrix(const ConstView& other) const {
+    CheckSize(other);
+    S21StridedUpdate(S21StridedOp::kAdd, rows_, cols_, data_, row_stride_,
+                     col_stride_, other.data(), other.RowStride(),
+                     other.ColStride());
+  }
+  void SubMatrix(const ConstView& other) const {
+    CheckSize(other);
+    S21StridedUpdate(S21StridedOp::kSub, rows_, cols_, data_, row_stride_,
+                     col_stride_, other.data(), other.RowStride(),
+                     other.ColStride());
+  }
+  void MulNumber(Value number) const {
+    S21StridedScale(rows_, cols_, data_, row_stride_, col_stride_, number);
+  }
+  void Fill(Value value) const {
+    S21StridedFill(rows_, cols_, data_, row_stride_, col_stride_, value);
+  }
+  // Elements may differ by S21MatrixTraits<Value>::kEpsilon
+  bool EqMatrix(const ConstView& other) const {
+    return !Empty() && !other.Empty() && rows_ == other.GetRows() &&
+           cols_ == other.GetCols() &&
+           S21StridedEqual<Value>(rows_, cols_, data_, row_stride_,
+                                  col_stride_, other.data(), other.RowStride(),
+                                  other.ColStride(),
+                                  S21MatrixTraits<Value>::kEpsilon);
+  }
+
+ private:
+  T* data_;
+  int rows_;
+  int cols_;
+  int row_stride_;
+  int col_stride_;
+  // Additional
+  T* Element(int i, int j) const {
+    return data_ + static_cast<std::ptrdiff_t>(i) * row_stride_ +
+           static_cast<std::ptrdiff_t>(j) * col_stride_;
+  }
+  template <typename E>
+  void CheckSize(const S21MatrixExpr<E>& other) const {
+    if (rows_ != other.GetRows() || cols_ != other.GetCols()) {
+      throw std::out_of_range("Different size of matrix");
+    }
+  }
+};
+
+using S21MatrixView = S21BasicMatrixView<double>;
+using S21MatrixConstView = S21BasicMatrixView<const double>;
+
+// Views are not expression nodes: S21Matrix only materialises them
+// explicitly, so passing a view never builds a hidden copy.
+template <typename E>
+struct S21IsMatrixView : std::false_type {};
+
+template <typename T>
+struct S21IsMatrixView<S21BasicMatrixView<T>> : std::true_type {};
+
+template <typename E>
+struct S21IsBasicMatrix : std::false_type {};
+
+template <typename T>
+struct S21IsBasicMatrix<S21BasicMatrix<T>> : std::true_type {};
+
+// True when the memory spanned by the two views intersects.
+template <typename T>
+bool S21Overlaps(const S21BasicMatrixView<const T>& x,
+                 const S21BasicMatrixView<const T>& y) {
+  if (x.Empty() || y.Empty()) return false;
+  auto last = [](const S21BasicMatrixView<const T>& view) {
+    return view.data() +
+           static_cast<std::ptrdiff_t>(view.GetRows() - 1) * view.RowStride() +
+           static_cast<std::ptrdiff_t>(view.GetCols() - 1) * view.ColStride();
+  };
+  return std::less_equal<const T*>()(x.data(), last(y)) &&
+         std::less_equal<const T*>()(y.data(), last(x));
+}
+
+// True when writing dst element by element may overwrite an element of src
+// before it is read: they overlap with a different layout, as a matrix and
+// its transposed view do. Identical layouts update in place safely.
+template <typename T>
+bool S21Aliases(const S21BasicMatrixView<const T>& src,
+                const S21BasicMatrixView<const T>& dst) {
+  const bool same_layout = src.data() == dst.data() &&
+                           src.RowStride() == dst.RowStride() &&
+                           src.ColStride() == dst.ColStride();
+  return !same_layout && S21Overlaps(src, dst);
+}
+
+// S21Aliases over every operand of an expression; the nodes forward to
+// their operands and the leaves, views and matrices, compare their memory.
+template <typename E>
+bool S21ExprAliases(
+    const S21MatrixExpr<E>& expr,
+    const S21BasicMatrixView<const S21MatrixExprValue<E>>& dst) {
+  return expr.Self().Aliases(dst);
+}
+
+template <typename T>
+bool S21ExprAliases(
+    const S21BasicMatrixView<T>& view,
+    const typename S21BasicMatrixView<T>::ConstView& dst) {
+  return S21Aliases(typename S21BasicMatrixView<T>::ConstView(view), dst);
+}
+
+template <typename T>
+template <typename E>
+void S21BasicMatrixView<T>::Assign(const S21MatrixExpr<E>& expr) const {
+  if constexpr (S21IsMatrixView<E>::value || S21IsBasicMatrix<E>::value) {
+    Assign(ConstView(expr.Self()));
+  } else if (S21ExprAliases(expr.Self(), ConstView(*this))) {
+    // The expression reads this memory through another layout
+    const S21BasicMatrix<Value> evaluated(expr);
+    Assign(ConstView(evaluated));
+  } else {
+    CheckSize(expr);
+    for (int i = 0; i < rows_; ++i) {
+      for (int j = 0; j < cols_; ++j) {
+        *Element(i, j) = expr.Coeff(i, j);
+      }
+    }
+  }
+}
+
+#endif  // SRC_S21_MATRIX_VIEW_H_
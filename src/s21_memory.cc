@@ -0,0 +1,136 @@
+#include "s21_memory.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+namespace {
+
+std::size_t AlignUp(std::size_t value, std::size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+}  // namespace
+
+// S21ArenaResource
+
+S21ArenaResource::S21ArenaResource(std::size_t chunk_size,
+                                   std::pmr::memory_resource* upstream)
+    : chunk_size_(std::max(chunk_size, kChunkAlignment)),
+      upstream_(upstream),
+      current_(0),
+      offset_(0),
+      used_(0) {}
+
+S21ArenaResource::~S21ArenaResource() { Release(); }
+
+void S21ArenaResource::Reset() {
+  current_ = 0;
+  offset_ = 0;
+  used_ = 0;
+}
+
+void S21ArenaResource::Release() {
+  for (const Chunk& chunk : chunks_) {
+    upstream_->deallocate(chunk.data, chunk.size, kChunkAlignment);
+  }
+  chunks_.clear();
+  Reset();
+}
+
+std::size_t S21ArenaResource::GetBytesUsed() const { return used_; }
+
+void* S21ArenaResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+  bytes = std::max<std::size_t>(bytes, 1);
+  void* p = current_ < chunks_.size() ? Carve(bytes, alignment) : nullptr;
+  if (!p) {
+    NextChunk(bytes + alignment);
+    p = Carve(bytes, alignment);
+  }
+  return p;
+}
+
+void S21ArenaResource::do_deallocate(void*, std::size_t, std::size_t) {}
+
+bool S21ArenaResource::do_is_equal(
+    const std::pmr::memory_resource& other) const noexcept {
+  return this == &other;
+}
+
+void* S21ArenaResource::Carve(std::size_t bytes, std::size_t alignment) {
+  const Chunk& chunk = chunks_[current_];
+  const auto base = reinterpret_cast<std::uintptr_t>(chunk.data);
+  const std::size_t start = AlignUp(base + offset_, alignment) - base;
+  if (start + bytes > chunk.size) return nullptr;
+  offset_ = start + bytes;
+  used_ += bytes;
+  return chunk.data + start;
+}
+
+void S21ArenaResource::NextChunk(std::size_t bytes) {
+  std::size_t next = chunks_.empty() ? 0 : current_ + 1;
+  while (next < chunks_.size() && chunks_[next].size < bytes) ++next;
+  if (next == chunks_.size()) {
+    const std::size_t size = std::max(chunk_size_, bytes);
+    char* data =
+        static_cast<char*>(upstream_->allocate(size, kChunkAlignment));
+    chunks_.push_back({data, size});
+  }
+  if (!chunks_.empty() && next > current_ + 1) {
+    // Chunks skipped as too small stay ahead for later requests.
+    std::swap(chunks_[current_ + 1], chunks_[next]);
+    next = current_ + 1;
+  }
+  current_ = next;
+  offset_ = 0;
+}
+
+// S21PoolResource
+
+S21PoolResource::S21PoolResource(std::pmr::memory_resource* upstream)
+    : upstream_(upstream), free_() {}
+
+S21PoolResource::~S21PoolResource() { Release(); }
+
+void S21PoolResource::Release() {
+  for (const auto& [block, size_class] : owned_) {
+    upstream_->deallocate(block, kMinBlock << size_class, kMinBlock);
+  }
+  owned_.clear();
+  std::fill(std::begin(free_), std::end(free_), nullptr);
+}
+
+void* S21PoolResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+  if (bytes > kMaxBlock || alignment > kMinBlock) {
+    return upstream_->allocate(bytes, alignment);
+  }
+  const int size_class = SizeClass(bytes);
+  if (FreeBlock* block = free_[size_class]) {
+    free_[size_class] = block->next;
+    return block;
+  }
+  void* block = upstream_->allocate(kMinBlock << size_class, kMinBlock);
+  owned_.emplace_back(block, size_class);
+  return block;
+}
+
+void S21PoolResource::do_deallocate(void* p, std::size_t bytes,
+                                    std::size_t alignment) {
+  if (bytes > kMaxBlock || alignment > kMinBlock) {
+    upstream_->deallocate(p, bytes, alignment);
+    return;
+  }
+  const int size_class = SizeClass(bytes);
+  free_[size_class] = new (p) FreeBlock{free_[size_class]};
+}
+
+bool S21PoolResource::do_is_equal(
+    const std::pmr::memory_resource& other) const noexcept {
+  return this == &other;
+}
+
+int S21PoolResource::SizeClass(std::size_t bytes) {
+  int size_class = 0;
+  while ((kMinBlock << size_class) < bytes) ++size_class;
+  return size_class;
+}
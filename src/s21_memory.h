@@ -0,0 +1,99 @@
+#ifndef SRC_S21_MEMORY_H_
+#define SRC_S21_MEMORY_H_
+
+#include <cstddef>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+// Memory resources for S21Matrix buffers and temporaries. Neither is
+// thread-safe: a resource should be used from one thread at a time, which
+// holds for S21Matrix since parallel kernels never allocate matrices.
+
+// Bump allocator. Allocations are carved from chunks obtained from the
+// upstream resource and deallocation is a no-op. Reset() rewinds to the
+// first chunk but keeps every chunk, so a loop that resets the arena once
+// per iteration stops calling upstream after its first pass.
+class S21ArenaResource : public std::pmr::memory_resource {
+ public:
+  explicit S21ArenaResource(
+      std::size_t chunk_size = kDefaultChunkSize,
+      std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+  ~S21ArenaResource() override;
+  S21ArenaResource(const S21ArenaResource&) = delete;
+  S21ArenaResource& operator=(const S21ArenaResource&) = delete;
+
+  // Invalidates every allocation made so far
+  void Reset();
+  // Reset() and hand every chunk back to upstream
+  void Release();
+  // Bytes handed out since the last Reset() or Release()
+  std::size_t GetBytesUsed() const;
+
+ private:
+  static constexpr std::size_t kDefaultChunkSize = std::size_t(1) << 20;
+  static constexpr std::size_t kChunkAlignment = 64;
+
+  struct Chunk {
+    char* data;
+    std::size_t size;
+  };
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+  void do_deallocate(void* p, std::size_t bytes,
+                     std::size_t alignment) override;
+  bool do_is_equal(const std::pmr::memory_resource& other) const
+      noexcept override;
+  // Takes bytes from the current chunk, or nullptr when they do not fit
+  void* Carve(std::size_t bytes, std::size_t alignment);
+  // Moves to the next kept chunk of at least bytes, or adds a new one
+  void NextChunk(std::size_t bytes);
+
+  std::size_t chunk_size_;
+  std::pmr::memory_resource* upstream_;
+  std::vector<Chunk> chunks_;
+  std::size_t current_;
+  std::size_t offset_;
+  std::size_t used_;
+};
+
+// Size-class pool. Requests are rounded up to a power of two of at least
+// kMinBlock bytes and served from a free list per class; freed blocks go
+// back on their list instead of upstream. Requests above kMaxBlock, or
+// aligned past kMinBlock, go straight to upstream.
+class S21PoolResource : public std::pmr::memory_resource {
+ public:
+  static constexpr std::size_t kMinBlock = 64;
+  static constexpr std::size_t kMaxBlock = std::size_t(1) << 24;
+
+  explicit S21PoolResource(
+      std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+  ~S21PoolResource() override;
+  S21PoolResource(const S21PoolResource&) = delete;
+  S21PoolResource& operator=(const S21PoolResource&) = delete;
+
+  // Returns every pooled block to upstream; outstanding blocks become
+  // invalid
+  void Release();
+
+ private:
+  static constexpr int kClasses = 19;  // 64 B .. 16 MiB
+
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+  void do_deallocate(void* p, std::size_t bytes,
+                     std::size_t alignment) override;
+  bool do_is_equal(const std::pmr::memory_resource& other) const
+      noexcept override;
+  static int SizeClass(std::size_t bytes);
+
+  std::pmr::memory_resource* upstream_;
+  FreeBlock* free_[kClasses];
+  // Every block ever taken from upstream, as (pointer, size class)
+  std::vector<std::pair<void*, int>> owned_;
+};
+
+#endif  // SRC_S21_MEMORY_H_
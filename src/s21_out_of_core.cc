@@ -0,0 +1,508 @@
+#include "s21_out_of_core.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <filesystem>
+#include <future>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "s21_transpose.h"
+
+namespace {
+
+constexpr std::size_t kDefaultBudget = std::size_t{1} << 30;
+
+std::atomic<std::size_t> out_of_core_budget{kDefaultBudget};
+
+// Elements of T the budget holds, at least one.
+template <typename T>
+std::size_t BudgetElements() {
+  return std::max<std::size_t>(S21GetOutOfCoreBudget() / sizeof(T), 1);
+}
+
+// Side of the square tiles when count of them must fit in the budget,
+// rounded down to a multiple of 64 (the blocking of Gemm and of the
+// transpose kernel) once it is that large.
+template <typename T>
+int TileSide(std::size_t count) {
+  const double side =
+      std::floor(std::sqrt(static_cast<double>(BudgetElements<T>()) / count));
+  int tile = static_cast<int>(
+      std::min(side, static_cast<double>(std::numeric_limits<int>::max())));
+  if (tile >= 64) tile -= tile % 64;
+  return std::max(tile, 1);
+}
+
+// Runs a read on a second thread while the caller computes on the other
+// half of a double buffer. Declared after the buffers it fills, so that a
+// read still running when an exception unwinds finishes before they go.
+class Prefetch {
+ public:
+  template <typename F>
+  void Start(F read) {
+    pending_ = std::async(std::launch::async, std::move(read));
+  }
+  // Rethrows what the read threw
+  void Wait() {
+    if (pending_.valid()) pending_.get();
+  }
+
+ private:
+  std::future<void> pending_;
+};
+
+std::uint64_t ElementOffset(const S21MatrixFileHeader& header, int row,
+                            int col, std::size_t size) {
+  return header.data_offset +
+         (static_cast<std::uint64_t>(row) *
+              static_cast<std::uint64_t>(header.cols) +
+          static_cast<std::uint64_t>(col)) *
+             size;
+}
+
+// Reads the rows x cols block at (row, col) into data with leading
+// dimension ld: a single read when the block spans whole rows, one per row
+// otherwise.
+template <typename T>
+void ReadTile(const S21File& file, const S21MatrixFileHeader& header,
+              int row, int col, int rows, int cols, T* data,
+              std::ptrdiff_t ld) {
+  if (rows == 0 || cols == 0) return;
+  const std::uint64_t offset = ElementOffset(header, row, col, sizeof(T));
+  const std::size_t row_bytes = sizeof(T) * static_cast<std::size_t>(cols);
+  if (cols == header.cols && ld == cols) {
+    file.ReadAt(data, row_bytes * rows, offset);
+    return;
+  }
+  const std::uint64_t file_stride = sizeof(T) * header.cols;
+  for (int i = 0; i < rows; ++i) {
+    file.ReadAt(data + i * ld, row_bytes, offset + i * file_stride);
+  }
+}
+
+template <typename T>
+void WriteTile(const S21File& file, const S21MatrixFileHeader& header,
+               int row, int col, int rows, int cols, const T* data,
+               std::ptrdiff_t ld) {
+  if (rows == 0 || cols == 0) return;
+  const std::uint64_t offset = ElementOffset(header, row, col, sizeof(T));
+  const std::size_t row_bytes = sizeof(T) * static_cast<std::size_t>(cols);
+  if (cols == header.cols && ld == cols) {
+    file.WriteAt(data, row_bytes * rows, offset);
+    return;
+  }
+  const std::uint64_t file_stride = sizeof(T) * header.cols;
+  for (int i = 0; i < rows; ++i) {
+    file.WriteAt(data + i * ld, row_bytes, offset + i * file_stride);
+  }
+}
+
+// Packed view of the first rows x cols elements of a tile buffer.
+template <typename T>
+S21BasicMatrixView<T> TileView(S21BasicMatrix<T>& tile, int rows, int cols) {
+  return S21BasicMatrixView<T>(tile.data(), rows, cols, cols);
+}
+
+// Checked before the file is created, so a bad shape leaves path alone.
+const std::string& CheckedShape(const std::string& path, int rows,
+                                int cols) {
+  if (rows < 0 || cols < 0) {
+    throw std::out_of_range("Incorrect size of matrix");
+  }
+  return path;
+}
+
+// Creating the result truncates its file, which must not be an operand.
+void CheckResultPath(const std::string& path, const std::string& operand) {
+  std::error_code error;
+  if (std::filesystem::equivalent(path, operand, error)) {
+    throw std::invalid_argument("The result file is an operand");
+  }
+}
+
+}  // namespace
+
+void S21SetOutOfCoreBudget(std::size_t bytes) {
+  out_of_core_budget.store(bytes == 0 ? kDefaultBudget : bytes);
+}
+
+std::size_t S21GetOutOfCoreBudget() { return out_of_core_budget.load(); }
+
+// Constructors
+
+template <typename T>
+S21BasicOutOfCoreMatrix<T>::S21BasicOutOfCoreMatrix(const std::string& path)
+    : file_(path, S21File::Mode::kReadWrite),
+      header_(S21ReadMatrixHeader(file_)),
+      dirty_(false) {
+  S21CheckMatrixElements<T>(header_);
+  if (header_.byte_order != S21MatrixFileHeader::kByteOrder) {
+    throw std::invalid_argument("The byte order of the file does not match");
+  }
+}
+
+// The checksum of all-zero data has a closed form, so a new file is valid
+// at once without writing its data.
+template <typename T>
+S21BasicOutOfCoreMatrix<T>::S21BasicOutOfCoreMatrix(const std::string& path,
+                                                    int rows, int cols)
+    : file_(CheckedShape(path, rows, cols), S21File::Mode::kCreate),
+      header_(S21MakeMatrixHeader<T>(rows, cols)),
+      dirty_(false) {
+  file_.Resize(header_.data_offset + header_.data_bytes);
+  S21Checksum checksum;
+  checksum.UpdateZeros(header_.data_bytes);
+  WriteChecksum(checksum.Final());
+}
+
+template <typename T>
+S21BasicOutOfCoreMatrix<T>::S21BasicOutOfCoreMatrix(
+    S21BasicOutOfCoreMatrix&& other) noexcept
+    : file_(std::move(other.file_)),
+      header_(other.header_),
+      dirty_(std::exchange(other.dirty_, false)) {}
+
+template <typename T>
+S21BasicOutOfCoreMatrix<T>::~S21BasicOutOfCoreMatrix() {
+  if (dirty_) {
+    try {
+      Sync();
+    } catch (...) {
+      // A destructor must not throw; Sync() reports errors to callers that
+      // need them.
+    }
+  }
+}
+
+// Operations
+
+template <typename T>
+void S21BasicOutOfCoreMatrix<T>::SumMatrix(
+    const S21BasicOutOfCoreMatrix& other) {
+  UpdateMatrix(other, false);
+}
+
+template <typename T>
+void S21BasicOutOfCoreMatrix<T>::SubMatrix(
+    const S21BasicOutOfCoreMatrix& other) {
+  UpdateMatrix(other, true);
+}
+
+// C is tiled into squares of side tile and each one accumulated over k
+// panels a quarter as deep, so the tile of C and both halves of the A and B
+// panels fill the budget: tile^2 + 2 * 2 * tile * tile / 4 = 2 * tile^2.
+template <typename T>
+S21BasicOutOfCoreMatrix<T> S21BasicOutOfCoreMatrix<T>::MulMatrix(
+    const S21BasicOutOfCoreMatrix& other, const std::string& path) const {
+  if (GetCols() != other.GetRows()) {
+    throw std::out_of_range(
+        "The number of columns of the first matrix does not equal the number "
+        "of rows of the second matrix");
+  }
+  CheckResultPath(path, GetPath());
+  CheckResultPath(path, other.GetPath());
+  const int rows = GetRows();
+  const int inner = GetCols();
+  const int cols = other.GetCols();
+  S21BasicOutOfCoreMatrix result(path, rows, cols);
+  if (rows == 0 || cols == 0 || inner == 0) return result;
+  const int tile = TileSide<T>(2);
+  const int depth = std::max(tile / 4, 1);
+  const int tile_rows = std::min(tile, rows);
+  const int tile_cols = std::min(tile, cols);
+  const int tile_depth = std::min(depth, inner);
+  S21BasicMatrix<T> c(tile_rows, tile_cols);
+  S21BasicMatrix<T> a[2] = {S21BasicMatrix<T>(tile_rows, tile_depth),
+                            S21BasicMatrix<T>(tile_rows, tile_depth)};
+  S21BasicMatrix<T> b[2] = {S21BasicMatrix<T>(tile_depth, tile_cols),
+                            S21BasicMatrix<T>(tile_depth, tile_cols)};
+  struct Step {
+    int i;
+    int j;
+    int k;
+  };
+  auto next = [&](Step step) {
+    step.k += depth;
+    if (step.k >= inner) {
+      step.k = 0;
+      step.j += tile;
+      if (step.j >= cols) {
+        step.j = 0;
+        step.i += tile;
+      }
+    }
+    return step;
+  };
+  auto load = [&](Step step, int half) {
+    const int h = std::min(tile, rows - step.i);
+    const int w = std::min(tile, cols - step.j);
+    const int d = std::min(depth, inner - step.k);
+    ReadTile(file_, header_, step.i, step.k, h, d, a[half].data(), d);
+    ReadTile(other.file_, other.header_, step.k, step.j, d, w,
+             b[half].data(), w);
+  };
+  Prefetch prefetch;
+  Step step{0, 0, 0};
+  load(step, 0);
+  for (int half = 0; step.i < rows; half ^= 1) {
+    const Step following = next(step);
+    if (following.i < rows) {
+      prefetch.Start([&load, following, half] { load(following, half ^ 1); });
+    }
+    const int h = std::min(tile, rows - step.i);
+    const int w = std::min(tile, cols - step.j);
+    const int d = std::min(depth, inner - step.k);
+    S21BasicMatrix<T>::Gemm(T(1), TileView(a[half], h, d),
+                            TileView(b[half], d, w),
+                            step.k == 0 ? T(0) : T(1), TileView(c, h, w));
+    if (following.k == 0) {
+      WriteTile(result.file_, result.header_, step.i, step.j, h, w, c.data(),
+                w);
+      result.dirty_ = true;
+    }
+    prefetch.Wait();
+    step = following;
+  }
+  result.Sync();
+  return result;
+}
+
+// Square tiles are read in file order, transposed in memory and written to
+// the mirrored place; two input tiles and one output tile fill the budget.
+template <typename T>
+S21BasicOutOfCoreMatrix<T> S21BasicOutOfCoreMatrix<T>::Transpose(
+    const std::string& path) const {
+  CheckResultPath(path, GetPath());
+  const int rows = GetRows();
+  const int cols = GetCols();
+  S21BasicOutOfCoreMatrix result(path, cols, rows);
+  if (rows == 0 || cols == 0) return result;
+  const int tile = TileSide<T>(3);
+  const int tile_rows = std::min(tile, rows);
+  const int tile_cols = std::min(tile, cols);
+  S21BasicMatrix<T> in[2] = {S21BasicMatrix<T>(tile_rows, tile_cols),
+                             S21BasicMatrix<T>(tile_rows, tile_cols)};
+  S21BasicMatrix<T> out(tile_cols, tile_rows);
+  auto load = [&](int i, int j, int half) {
+    const int w = std::min(tile, cols - j);
+    ReadTile(file_, header_, i, j, std::min(tile, rows - i), w,
+             in[half].data(), w);
+  };
+  Prefetch prefetch;
+  int i = 0;
+  int j = 0;
+  load(i, j, 0);
+  for (int half = 0; i < rows; half ^= 1) {
+    int next_i = i;
+    int next_j = j + tile;
+    if (next_j >= cols) {
+      next_j = 0;
+      next_i += tile;
+    }
+    if (next_i < rows) {
+      prefetch.Start([&load, next_i, next_j, half] {
+        load(next_i, next_j, half ^ 1);
+      });
+    }
+    const int h = std::min(tile, rows - i);
+    const int w = std::min(tile, cols - j);
+    S21Transpose(h, w, in[half].data(), w, out.data(), h);
+    WriteTile(result.file_, result.header_, j, i, w, h, out.data(), h);
+    result.dirty_ = true;
+    prefetch.Wait();
+    i = next_i;
+    j = next_j;
+  }
+  result.Sync();
+  return result;
+}
+
+// Overloadings opertators
+
+template <typename T>
+S21BasicOutOfCoreMatrix<T>& S21BasicOutOfCoreMatrix<T>::operator=(
+    S21BasicOutOfCoreMatrix&& other) noexcept {
+  if (this != &other) {
+    if (dirty_) {
+      try {
+        Sync();
+      } catch (...) {
+        // As in the destructor
+      }
+    }
+    file_ = std::move(other.file_);
+    header_ = other.header_;
+    dirty_ = std::exchange(other.dirty_, false);
+  }
+  return *this;
+}
+
+// Accessors & mutators
+
+template <typename T>
+S21BasicMatrix<T> S21BasicOutOfCoreMatrix<T>::ReadBlock(int row, int col,
+                                                        int rows,
+                                                        int cols) const {
+  CheckBlock(row, col, rows, cols);
+  S21BasicMatrix<T> block(rows, cols);
+  ReadTile(file_, header_, row, col, rows, cols, block.data(), cols);
+  return block;
+}
+
+template <typename T>
+void S21BasicOutOfCoreMatrix<T>::ReadBlock(
+    int row, int col, const S21BasicMatrixView<T>& block) const {
+  CheckBlock(row, col, block.GetRows(), block.GetCols());
+  if (block.Empty()) return;
+  if (block.ColStride() == 1) {
+    ReadTile(file_, header_, row, col, block.GetRows(), block.GetCols(),
+             block.data(), block.RowStride());
+  } else {
+    block.Assign(ReadBlock(row, col, block.GetRows(), block.GetCols()));
+  }
+}
+
+template <typename T>
+void S21BasicOutOfCoreMatrix<T>::WriteBlock(
+    int row, int col, const S21BasicMatrixView<const T>& block) {
+  CheckBlock(row, col, block.GetRows(), block.GetCols());
+  if (block.Empty()) return;
+  dirty_ = true;
+  if (block.ColStride() == 1) {
+    WriteTile(file_, header_, row, col, block.GetRows(), block.GetCols(),
+              block.data(), block.RowStride());
+  } else {
+    const S21BasicMatrix<T> packed(block);
+    WriteTile(file_, header_, row, col, packed.GetRows(), packed.GetCols(),
+              packed.data(), packed.GetCols());
+  }
+}
+
+// Hashing one half of the buffer while the other is read.
+template <typename T>
+void S21BasicOutOfCoreMatrix<T>::Sync() {
+  const std::uint64_t total = header_.data_bytes;
+  const std::size_t chunk = static_cast<std::size_t>(std::min<std::uint64_t>(
+      total, BudgetElements<T>() / 2 * sizeof(T)));
+  S21Checksum checksum;
+  if (chunk > 0) {
+    std::vector<unsigned char> buffer[2] = {
+        std::vector<unsigned char>(chunk), std::vector<unsigned char>(chunk)};
+    auto load = [&](std::uint64_t offset, int half) {
+      file_.ReadAt(buffer[half].data(), std::min<std::uint64_t>(
+                                            chunk, total - offset),
+                   header_.data_offset + offset);
+    };
+    Prefetch prefetch;
+    load(0, 0);
+    int half = 0;
+    for (std::uint64_t offset = 0; offset < total;
+         offset += chunk, half ^= 1) {
+      const std::uint64_t following = offset + chunk;
+      if (following < total) {
+        prefetch.Start([&load, following, half] { load(following, half ^ 1); });
+      }
+      checksum.Update(buffer[half].data(),
+                      std::min<std::uint64_t>(chunk, total - offset));
+      prefetch.Wait();
+    }
+  }
+  WriteChecksum(checksum.Final());
+  dirty_ = false;
+}
+
+template <typename T>
+int S21BasicOutOfCoreMatrix<T>::GetRows() const {
+  return static_cast<int>(header_.rows);
+}
+
+template <typename T>
+int S21BasicOutOfCoreMatrix<T>::GetCols() const {
+  return static_cast<int>(header_.cols);
+}
+
+template <typename T>
+const std::string& S21BasicOutOfCoreMatrix<T>::GetPath() const {
+  return file_.GetPath();
+}
+
+// Additional
+
+template <typename T>
+void S21BasicOutOfCoreMatrix<T>::CheckBlock(int row, int col, int rows,
+                                            int cols) const {
+  if (row < 0 || col < 0 || rows < 0 || cols < 0 ||
+      row > GetRows() - rows || col > GetCols() - cols) {
+    throw std::out_of_range("The index out of matrix limit");
+  }
+}
+
+// Chunks of this and other are read together into one half of the buffer
+// while the other half is updated, hashed and written back, so the new
+// checksum comes out of the same pass.
+template <typename T>
+void S21BasicOutOfCoreMatrix<T>::UpdateMatrix(
+    const S21BasicOutOfCoreMatrix& other, bool subtract) {
+  if (GetRows() != other.GetRows() || GetCols() != other.GetCols()) {
+    throw std::out_of_range("Different size of matrix");
+  }
+  const std::uint64_t total = static_cast<std::uint64_t>(header_.rows) *
+                              static_cast<std::uint64_t>(header_.cols);
+  if (total == 0) return;
+  const std::uint64_t limit = std::min<std::uint64_t>(
+      {total, std::max<std::size_t>(BudgetElements<T>() / 4, 1),
+       static_cast<std::uint64_t>(std::numeric_limits<int>::max())});
+  const int chunk = static_cast<int>(limit);
+  S21BasicMatrix<T> a[2] = {S21BasicMatrix<T>(1, chunk),
+                            S21BasicMatrix<T>(1, chunk)};
+  S21BasicMatrix<T> b[2] = {S21BasicMatrix<T>(1, chunk),
+                            S21BasicMatrix<T>(1, chunk)};
+  auto length = [&](std::uint64_t start) {
+    return static_cast<int>(std::min<std::uint64_t>(limit, total - start));
+  };
+  auto load = [&](std::uint64_t start, int half) {
+    const std::uint64_t offset = header_.data_offset + start * sizeof(T);
+    const std::size_t bytes = sizeof(T) * length(start);
+    file_.ReadAt(a[half].data(), bytes, offset);
+    other.file_.ReadAt(b[half].data(), bytes, offset);
+  };
+  S21Checksum checksum;
+  Prefetch prefetch;
+  load(0, 0);
+  int half = 0;
+  for (std::uint64_t start = 0; start < total; start += limit, half ^= 1) {
+    const std::uint64_t following = start + limit;
+    if (following < total) {
+      prefetch.Start([&load, following, half] { load(following, half ^ 1); });
+    }
+    const int n = length(start);
+    const S21BasicMatrixView<T> sum = TileView(a[half], 1, n);
+    if (subtract) {
+      sum.SubMatrix(TileView(b[half], 1, n));
+    } else {
+      sum.SumMatrix(TileView(b[half], 1, n));
+    }
+    checksum.Update(a[half].data(), sizeof(T) * n);
+    file_.WriteAt(a[half].data(), sizeof(T) * n,
+                  header_.data_offset + start * sizeof(T));
+    prefetch.Wait();
+  }
+  WriteChecksum(checksum.Final());
+  dirty_ = false;
+}
+
+template <typename T>
+void S21BasicOutOfCoreMatrix<T>::WriteChecksum(std::uint64_t checksum) {
+  header_.checksum = checksum;
+  file_.WriteAt(&header_, sizeof(header_), 0);
+}
+
+template class S21BasicOutOfCoreMatrix<float>;
+template class S21BasicOutOfCoreMatrix<double>;
+template class S21BasicOutOfCoreMatrix<long double>;
+template class S21BasicOutOfCoreMatrix<std::complex<double>>;
@@ -0,0 +1,85 @@
+#ifndef SRC_S21_OUT_OF_CORE_H_
+#define SRC_S21_OUT_OF_CORE_H_
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "s21_file.h"
+#include "s21_matrix_io.h"
+#include "s21_matrix_oop.h"
+#include "s21_matrix_view.h"
+
+// A matrix that stays in its file (the format of s21_matrix_io.h) and is
+// processed tile by tile, for operands larger than memory. Operations hold
+// at most S21GetOutOfCoreBudget() bytes of tiles; while one tile is being
+// computed on the thread pool, a second thread already reads the next one
+// into the other half of a double buffer, so disk and CPU work overlap.
+// Tiles are computed with the in-memory kernels (Gemm, the SIMD add and
+// the cache-oblivious transpose): sums and transposes are bitwise those of
+// S21BasicMatrix, products differ only in how the inner sums are split.
+// Files must have the byte order of this machine.
+template <typename T>
+class S21BasicOutOfCoreMatrix {
+ public:
+  // Constructors
+  // Opens a matrix file for reading and writing
+  explicit S21BasicOutOfCoreMatrix(const std::string& path);
+  // Creates path holding a zero rows x cols matrix; the file is sparse, so
+  // it takes disk space only as tiles are written
+  S21BasicOutOfCoreMatrix(const std::string& path, int rows, int cols);
+  S21BasicOutOfCoreMatrix(const S21BasicOutOfCoreMatrix&) = delete;
+  S21BasicOutOfCoreMatrix(S21BasicOutOfCoreMatrix&& other) noexcept;
+  // Updates the checksum if tiles were written since the last Sync(),
+  // ignoring errors
+  ~S21BasicOutOfCoreMatrix();
+  // Operations
+  // Streamed in place in chunks, as S21BasicMatrix does in memory
+  void SumMatrix(const S21BasicOutOfCoreMatrix& other);
+  void SubMatrix(const S21BasicOutOfCoreMatrix& other);
+  // Writes this times other to path. The product is tiled into square
+  // blocks of C, each accumulated over panels of A and B, so the operands
+  // are read about 2 * n / tile times over; larger budgets mean fewer reads.
+  S21BasicOutOfCoreMatrix MulMatrix(const S21BasicOutOfCoreMatrix& other,
+                                    const std::string& path) const;
+  // Writes the transpose to path, one square tile at a time
+  S21BasicOutOfCoreMatrix Transpose(const std::string& path) const;
+  // Overloadings opertators
+  S21BasicOutOfCoreMatrix& operator=(const S21BasicOutOfCoreMatrix&) = delete;
+  S21BasicOutOfCoreMatrix& operator=(S21BasicOutOfCoreMatrix&& other) noexcept;
+  // Accessors & mutators
+  // Copies the block of rows x cols elements at (row, col) into memory
+  S21BasicMatrix<T> ReadBlock(int row, int col, int rows, int cols) const;
+  void ReadBlock(int row, int col, const S21BasicMatrixView<T>& block) const;
+  void WriteBlock(int row, int col, const S21BasicMatrixView<const T>& block);
+  // Recomputes the checksum of the file after WriteBlock, one streamed pass
+  void Sync();
+  int GetRows() const;
+  int GetCols() const;
+  const std::string& GetPath() const;
+
+ private:
+  S21File file_;
+  S21MatrixFileHeader header_;
+  bool dirty_;
+  // Additional
+  void CheckBlock(int row, int col, int rows, int cols) const;
+  void UpdateMatrix(const S21BasicOutOfCoreMatrix& other, bool subtract);
+  void WriteChecksum(std::uint64_t checksum);
+};
+
+// Bytes of tiles an out-of-core operation may hold at once, both halves of
+// the double buffer included; 1 GiB by default. Budgets too small for a
+// single tile are raised to the smallest one that works.
+void S21SetOutOfCoreBudget(std::size_t bytes);
+std::size_t S21GetOutOfCoreBudget();
+
+extern template class S21BasicOutOfCoreMatrix<float>;
+extern template class S21BasicOutOfCoreMatrix<double>;
+extern template class S21BasicOutOfCoreMatrix<long double>;
+extern template class S21BasicOutOfCoreMatrix<std::complex<double>>;
+
+using S21OutOfCoreMatrix = S21BasicOutOfCoreMatrix<double>;
+
+#endif  // SRC_S21_OUT_OF_CORE_H_
@@ -0,0 +1,237 @@
+#include "s21_qr.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+template <typename T>
+T* RowOf(T* a, int lda, int i) {
+  return a + static_cast<std::ptrdiff_t>(i) * lda;
+}
+
+template <typename T>
+T Conj(T value) {
+  return value;
+}
+
+template <typename R>
+std::complex<R> Conj(std::complex<R> value) {
+  return std::conj(value);
+}
+
+// Euclidean norm of a[first..last) of column col, scaled by its largest
+// magnitude so that the squares neither overflow nor underflow.
+template <typename T>
+typename S21MatrixTraits<T>::Real ColumnNorm(const T* a, int lda, int col,
+                                             int first, int last) {
+  using Real = typename S21MatrixTraits<T>::Real;
+  Real scale = 0;
+  for (int i = first; i < last; ++i) {
+    scale = std::max(scale, std::abs(RowOf(a, lda, i)[col]));
+  }
+  if (scale == Real(0)) return 0;
+  Real sum = 0;
+  for (int i = first; i < last; ++i) {
+    const Real value = std::abs(RowOf(a, lda, i)[col]) / scale;
+    sum += value * value;
+  }
+  return scale * std::sqrt(sum);
+}
+
+// C = (I - tau v v^H) * C on rows [k, m) of the nrhs columns of c, where
+// v_k = 1 and v_i is column k of qr below the diagonal. The columns are
+// split into parallel slices, each accumulating w = v^H C in its own part
+// of work and then subtracting tau v w.
+template <typename T>
+void ApplyReflector(int m, int k, const T* qr, int lda, T tau, int nrhs, T* c,
+                    int ldc, T* work) {
+  if (tau == T(0) || nrhs == 0) return;
+  const S21BasicSimdKernels<T>& simd = S21SimdActive<T>();
+  S21ParallelFor(
+      0, nrhs, 4.0 * (m - k), [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        const std::size_t count = static_cast<std::size_t>(end - begin);
+        T* w = work + begin;
+        simd.copy(w, RowOf(c, ldc, k) + begin, count);
+        for (int i = k + 1; i < m; ++i) {
+          const T v = RowOf(qr, lda, i)[k];
+          if (v == T(0)) continue;
+          simd.axpy(w, Conj(v), RowOf(c, ldc, i) + begin, count);
+        }
+        simd.axpy(RowOf(c, ldc, k) + begin, -tau, w, count);
+        for (int i = k + 1; i < m; ++i) {
+          const T v = RowOf(qr, lda, i)[k];
+          if (v == T(0)) continue;
+          simd.axpy(RowOf(c, ldc, i) + begin, -tau * v, w, count);
+        }
+      });
+}
+
+}  // namespace
+
+template <typename T>
+void S21QrFactor(int m, int n, T* a, int lda, T* tau) {
+  using Real = typename S21MatrixTraits<T>::Real;
+  std::vector<T> work(static_cast<std::size_t>(n));
+  for (int k = 0; k < n; ++k) {
+    T* row_k = RowOf(a, lda, k);
+    const T alpha = row_k[k];
+    const Real norm = ColumnNorm(a, lda, k, k + 1, m);
+    tau[k] = 0;
+    if (norm == Real(0) && std::imag(alpha) == Real(0)) continue;
+    // H^H * (alpha, x) = (beta, 0) with a real beta of the opposite sign to
+    // alpha, so that alpha - beta does not cancel.
+    const Real magnitude = std::hypot(std::abs(alpha), norm);
+    const Real beta = std::real(alpha) < Real(0) ? magnitude : -magnitude;
+    tau[k] = (T(beta) - alpha) / T(beta);
+    const T inverse = T(1) / (alpha - T(beta));
+    for (int i = k + 1; i < m; ++i) RowOf(a, lda, i)[k] *= inverse;
+    row_k[k] = beta;
+    // The trailing columns, addressed from row 0 like a itself
+    ApplyReflector(m, k, a, lda, Conj(tau[k]), n - k - 1, a + k + 1, lda,
+                   work.data());
+  }
+}
+
+template <typename T>
+void S21QrApplyQt(int m, int n, const T* qr, int lda, const T* tau, int nrhs,
+                  T* b, int ldb) {
+  std::vector<T> work(static_cast<std::size_t>(nrhs));
+  for (int k = 0; k < n; ++k) {
+    ApplyReflector(m, k, qr, lda, Conj(tau[k]), nrhs, b, ldb, work.data());
+  }
+}
+
+template void S21QrFactor(int, int, float*, int, float*);
+template void S21QrFactor(int, int, double*, int, double*);
+template void S21QrFactor(int, int, long double*, int, long double*);
+template void S21QrFactor(int, int, std::complex<double>*, int,
+                          std::complex<double>*);
+template void S21QrApplyQt(int, int, const float*, int, const float*, int,
+                           float*, int);
+template void S21QrApplyQt(int, int, const double*, int, const double*, int,
+                           double*, int);
+template void S21QrApplyQt(int, int, const long double*, int,
+                           const long double*, int, long double*, int);
+template void S21QrApplyQt(int, int, const std::complex<double>*, int,
+                           const std::complex<double>*, int,
+                           std::complex<double>*, int);
+
+// S21BasicQR
+
+template <typename T>
+S21BasicQR<T>::S21BasicQR(const S21BasicMatrix<T>& matrix)
+    : factors_(matrix, matrix.GetResource()),
+      tau_(static_cast<std::size_t>(matrix.GetCols())) {
+  if (matrix.GetRows() < matrix.GetCols()) {
+    throw std::out_of_range("Incorrect size of matrix");
+  }
+  if (factors_.data()) {
+    S21QrFactor(factors_.GetRows(), factors_.GetCols(), factors_.data(),
+                factors_.stride(), tau_.data());
+  }
+}
+
+template <typename T>
+bool S21BasicQR<T>::IsRankDeficient() const {
+  const int n = GetCols();
+  Real largest = 0;
+  for (int i = 0; i < n; ++i) {
+    largest = std::max(largest, std::abs(factors_[i][i]));
+  }
+  const Real tolerance = largest * std::max(GetRows(), n) *
+                         std::numeric_limits<Real>::epsilon();
+  for (int i = 0; i < n; ++i) {
+    if (!(std::abs(factors_[i][i]) > tolerance)) return true;
+  }
+  return false;
+}
+
+template <typename T>
+std::vector<T> S21BasicQR<T>::Solve(const std::vector<T>& b) const {
+  S21BasicMatrix<T> column(static_cast<int>(b.size()), 1);
+  std::copy(b.begin(), b.end(), column.begin());
+  const S21BasicMatrix<T> x = Solve(column);
+  return std::vector<T>(x.begin(), x.end());
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicQR<T>::Solve(const S21BasicMatrix<T>& b) const {
+  if (b.GetRows() != GetRows()) {
+    throw std::out_of_range("Different size of matrix");
+  }
+  CheckSolvable();
+  const int n = GetCols();
+  const int nrhs = b.GetCols();
+  S21BasicMatrix<T> y(b, factors_.GetResource());
+  if (!y.data() || n == 0) {
+    return S21BasicMatrix<T>(n, nrhs, factors_.GetResource());
+  }
+  S21QrApplyQt(GetRows(), n, factors_.data(), factors_.stride(), tau_.data(),
+               nrhs, y.data(), y.stride());
+  // R * X = (Q^H B) restricted to its first n rows
+  S21BasicMatrix<T> x(y.Block(0, 0, n, nrhs), factors_.GetResource());
+  const S21BasicSimdKernels<T>& simd = S21SimdActive<T>();
+  for (int i = n - 1; i >= 0; --i) {
+    const T* r_i = factors_[i];
+    for (int k = i + 1; k < n; ++k) {
+      if (r_i[k] == T(0)) continue;
+      simd.axpy(x[i], -r_i[k], x[k], nrhs);
+    }
+    simd.scale(x[i], T(1) / r_i[i], nrhs);
+  }
+  return x;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicQR<T>::GetQ() const {
+  const int m = GetRows();
+  const int n = GetCols();
+  S21BasicMatrix<T> q(m, n, factors_.GetResource());
+  for (int i = 0; i < n; ++i) q[i][i] = 1;
+  std::vector<T> work(static_cast<std::size_t>(n));
+  for (int k = n - 1; k >= 0; --k) {
+    ApplyReflector(m, k, factors_.data(), factors_.stride(), tau_[k], n,
+                   q.data(), q.stride(), work.data());
+  }
+  return q;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicQR<T>::GetR() const {
+  const int n = GetCols();
+  S21BasicMatrix<T> r(n, n, factors_.GetResource());
+  for (int i = 0; i < n; ++i) {
+    std::copy(factors_[i] + i, factors_[i] + n, r[i] + i);
+  }
+  return r;
+}
+
+template <typename T>
+int S21BasicQR<T>::GetRows() const {
+  return factors_.GetRows();
+}
+
+template <typename T>
+int S21BasicQR<T>::GetCols() const {
+  return factors_.GetCols();
+}
+
+template <typename T>
+void S21BasicQR<T>::CheckSolvable() const {
+  if (IsRankDeficient()) {
+    throw std::invalid_argument("The matrix is rank deficient");
+  }
+}
+
+template class S21BasicQR<float>;
+template class S21BasicQR<double>;
+template class S21BasicQR<long double>;
+template class S21BasicQR<std::complex<double>>;
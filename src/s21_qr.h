@@ -0,0 +1,61 @@
+#ifndef SRC_S21_QR_H_
+#define SRC_S21_QR_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+#include "s21_matrix_traits.h"
+
+// In-place Householder QR factorisation A = Q * R of the row-major m x n
+// matrix a (m >= n) with leading dimension lda. On return the upper triangle
+// holds R and column k below the diagonal the reflector v_k (its leading 1
+// implied); Q = H_0 * H_1 * ... * H_{n-1} with H_k = I - tau[k] v_k v_k^H.
+// Each reflector is applied to the trailing columns in parallel slices, both
+// of its passes running over contiguous rows.
+template <typename T>
+void S21QrFactor(int m, int n, T* a, int lda, T* tau);
+
+// Overwrites the m x nrhs matrix b with Q^H * B.
+template <typename T>
+void S21QrApplyQt(int m, int n, const T* qr, int lda, const T* tau, int nrhs,
+                  T* b, int ldb);
+
+// Householder QR of an S21BasicMatrix with at least as many rows as
+// columns, for least-squares problems: Solve(b) minimises ||A x - b|| and so
+// also solves square systems, without squaring the condition number the
+// way the normal equations A^H A x = A^H b would.
+template <typename T>
+class S21BasicQR {
+ public:
+  using Real = typename S21MatrixTraits<T>::Real;
+
+  explicit S21BasicQR(const S21BasicMatrix<T>& matrix);
+  // Operations
+  // Whether R has a diagonal entry negligible next to the largest one, in
+  // which case the least-squares solution is not unique
+  bool IsRankDeficient() const;
+  std::vector<T> Solve(const std::vector<T>& b) const;
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T>& b) const;
+  // The thin factors: Q is rows x cols with orthonormal columns, R is
+  // cols x cols upper triangular
+  S21BasicMatrix<T> GetQ() const;
+  S21BasicMatrix<T> GetR() const;
+  // Accessors
+  int GetRows() const;
+  int GetCols() const;
+
+ private:
+  S21BasicMatrix<T> factors_;
+  std::vector<T> tau_;
+  // Additional
+  void CheckSolvable() const;
+};
+
+extern template class S21BasicQR<float>;
+extern template class S21BasicQR<double>;
+extern template class S21BasicQR<long double>;
+extern template class S21BasicQR<std::complex<double>>;
+
+using S21QR = S21BasicQR<double>;
+
+#endif  // SRC_S21_QR_H_
@@ -0,0 +1,606 @@
+#include "s21_simd.h"
+
+#include <cmath>
+#include <complex>
+#include <initializer_list>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define S21_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Scalar fallback, also used for the tails of the vector loops.
+
+template <typename T>
+void AddScalar(T* dst, const T* src, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) dst[i] += src[i];
+}
+
+template <typename T>
+void SubScalar(T* dst, const T* src, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) dst[i] -= src[i];
+}
+
+template <typename T>
+void ScaleScalar(T* dst, T alpha, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) dst[i] *= alpha;
+}
+
+template <typename T>
+void AxpyScalar(T* dst, T alpha, const T* src, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) dst[i] += alpha * src[i];
+}
+
+template <typename T>
+bool EqualScalar(const T* a, const T* b, std::size_t n,
+                 typename S21MatrixTraits<T>::Real epsilon) {
+  for (std::size_t i = 0; i < n; ++i) {
+    if (std::abs(a[i] - b[i]) > epsilon) return false;
+  }
+  return true;
+}
+
+template <typename T>
+void CopyScalar(T* dst, const T* src, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) dst[i] = src[i];
+}
+
+template <typename T>
+void FillScalar(T* dst, T value, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) dst[i] = value;
+}
+
+template <typename T>
+constexpr S21BasicSimdKernels<T> kScalarKernels = {
+    S21SimdLevel::kScalar, "scalar",      AddScalar<T>,   SubScalar<T>,
+    ScaleScalar<T>,        AxpyScalar<T>, EqualScalar<T>, CopyScalar<T>,
+    FillScalar<T>};
+
+// Vector tables of one element type, whatever the CPU supports; only float
+// and double have any.
+template <typename T>
+const S21BasicSimdKernels<T>* VectorKernels(S21SimdLevel) {
+  return nullptr;
+}
+
+#ifdef S21_SIMD_X86
+
+// SSE2: two doubles per register.
+
+__attribute__((target("sse2"))) void AddSse2(double* dst, const double* src,
+                                             std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(dst + i,
+                  _mm_add_pd(_mm_loadu_pd(dst + i), _mm_loadu_pd(src + i)));
+  }
+  AddScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("sse2"))) void SubSse2(double* dst, const double* src,
+                                             std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(dst + i,
+                  _mm_sub_pd(_mm_loadu_pd(dst + i), _mm_loadu_pd(src + i)));
+  }
+  SubScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("sse2"))) void ScaleSse2(double* dst, double alpha,
+                                               std::size_t n) {
+  const __m128d factor = _mm_set1_pd(alpha);
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(dst + i, _mm_mul_pd(_mm_loadu_pd(dst + i), factor));
+  }
+  ScaleScalar(dst + i, alpha, n - i);
+}
+
+__attribute__((target("sse2"))) void AxpySse2(double* dst, double alpha,
+                                              const double* src,
+                                              std::size_t n) {
+  const __m128d factor = _mm_set1_pd(alpha);
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(dst + i,
+                  _mm_add_pd(_mm_loadu_pd(dst + i),
+                             _mm_mul_pd(factor, _mm_loadu_pd(src + i))));
+  }
+  AxpyScalar(dst + i, alpha, src + i, n - i);
+}
+
+__attribute__((target("sse2"))) bool EqualSse2(const double* a,
+                                               const double* b, std::size_t n,
+                                               double epsilon) {
+  const __m128d sign = _mm_set1_pd(-0.0);
+  const __m128d limit = _mm_set1_pd(epsilon);
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    const __m128d diff = _mm_andnot_pd(
+        sign, _mm_sub_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+    if (_mm_movemask_pd(_mm_cmpgt_pd(diff, limit))) return false;
+  }
+  return EqualScalar(a + i, b + i, n - i, epsilon);
+}
+
+__attribute__((target("sse2"))) void CopySse2(double* dst, const double* src,
+                                              std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) _mm_storeu_pd(dst + i, _mm_loadu_pd(src + i));
+  CopyScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("sse2"))) void FillSse2(double* dst, double value,
+                                              std::size_t n) {
+  const __m128d broadcast = _mm_set1_pd(value);
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) _mm_storeu_pd(dst + i, broadcast);
+  FillScalar(dst + i, value, n - i);
+}
+
+// AVX2: four doubles per register.
+
+__attribute__((target("avx2"))) void AddAvx2(double* dst, const double* src,
+                                             std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(dst + i, _mm256_add_pd(_mm256_loadu_pd(dst + i),
+                                            _mm256_loadu_pd(src + i)));
+  }
+  AddScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx2"))) void SubAvx2(double* dst, const double* src,
+                                             std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(dst + i, _mm256_sub_pd(_mm256_loadu_pd(dst + i),
+                                            _mm256_loadu_pd(src + i)));
+  }
+  SubScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx2"))) void ScaleAvx2(double* dst, double alpha,
+                                               std::size_t n) {
+  const __m256d factor = _mm256_set1_pd(alpha);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(dst + i, _mm256_mul_pd(_mm256_loadu_pd(dst + i), factor));
+  }
+  ScaleScalar(dst + i, alpha, n - i);
+}
+
+__attribute__((target("avx2"))) void AxpyAvx2(double* dst, double alpha,
+                                              const double* src,
+                                              std::size_t n) {
+  const __m256d factor = _mm256_set1_pd(alpha);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m256d product = _mm256_mul_pd(factor, _mm256_loadu_pd(src + i));
+    _mm256_storeu_pd(dst + i, _mm256_add_pd(_mm256_loadu_pd(dst + i), product));
+  }
+  AxpyScalar(dst + i, alpha, src + i, n - i);
+}
+
+__attribute__((target("avx2"))) bool EqualAvx2(const double* a,
+                                               const double* b, std::size_t n,
+                                               double epsilon) {
+  const __m256d sign = _mm256_set1_pd(-0.0);
+  const __m256d limit = _mm256_set1_pd(epsilon);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m256d diff = _mm256_andnot_pd(
+        sign, _mm256_sub_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+    if (_mm256_movemask_pd(_mm256_cmp_pd(diff, limit, _CMP_GT_OQ))) {
+      return false;
+    }
+  }
+  return EqualScalar(a + i, b + i, n - i, epsilon);
+}
+
+__attribute__((target("avx2"))) void CopyAvx2(double* dst, const double* src,
+                                              std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(dst + i, _mm256_loadu_pd(src + i));
+  }
+  CopyScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx2"))) void FillAvx2(double* dst, double value,
+                                              std::size_t n) {
+  const __m256d broadcast = _mm256_set1_pd(value);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) _mm256_storeu_pd(dst + i, broadcast);
+  FillScalar(dst + i, value, n - i);
+}
+
+// AVX-512F: eight doubles per register.
+
+__attribute__((target("avx512f"))) void AddAvx512(double* dst,
+                                                  const double* src,
+                                                  std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(dst + i, _mm512_add_pd(_mm512_loadu_pd(dst + i),
+                                            _mm512_loadu_pd(src + i)));
+  }
+  AddScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx512f"))) void SubAvx512(double* dst,
+                                                  const double* src,
+                                                  std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(dst + i, _mm512_sub_pd(_mm512_loadu_pd(dst + i),
+                                            _mm512_loadu_pd(src + i)));
+  }
+  SubScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx512f"))) void ScaleAvx512(double* dst, double alpha,
+                                                    std::size_t n) {
+  const __m512d factor = _mm512_set1_pd(alpha);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(dst + i, _mm512_mul_pd(_mm512_loadu_pd(dst + i), factor));
+  }
+  ScaleScalar(dst + i, alpha, n - i);
+}
+
+__attribute__((target("avx512f"))) void AxpyAvx512(double* dst, double alpha,
+                                                   const double* src,
+                                                   std::size_t n) {
+  const __m512d factor = _mm512_set1_pd(alpha);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m512d product = _mm512_mul_pd(factor, _mm512_loadu_pd(src + i));
+    _mm512_storeu_pd(dst + i, _mm512_add_pd(_mm512_loadu_pd(dst + i), product));
+  }
+  AxpyScalar(dst + i, alpha, src + i, n - i);
+}
+
+__attribute__((target("avx512f"))) bool EqualAvx512(const double* a,
+                                                    const double* b,
+                                                    std::size_t n,
+                                                    double epsilon) {
+  const __m512d limit = _mm512_set1_pd(epsilon);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m512d diff = _mm512_abs_pd(
+        _mm512_sub_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i)));
+    if (_mm512_cmp_pd_mask(diff, limit, _CMP_GT_OQ)) return false;
+  }
+  return EqualScalar(a + i, b + i, n - i, epsilon);
+}
+
+__attribute__((target("avx512f"))) void CopyAvx512(double* dst,
+                                                   const double* src,
+                                                   std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(dst + i, _mm512_loadu_pd(src + i));
+  }
+  CopyScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx512f"))) void FillAvx512(double* dst, double value,
+                                                   std::size_t n) {
+  const __m512d broadcast = _mm512_set1_pd(value);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) _mm512_storeu_pd(dst + i, broadcast);
+  FillScalar(dst + i, value, n - i);
+}
+
+// float: twice as many lanes per register at every level.
+
+__attribute__((target("sse2"))) void AddSse2(float* dst, const float* src,
+                                             std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(dst + i,
+                  _mm_add_ps(_mm_loadu_ps(dst + i), _mm_loadu_ps(src + i)));
+  }
+  AddScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("sse2"))) void SubSse2(float* dst, const float* src,
+                                             std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(dst + i,
+                  _mm_sub_ps(_mm_loadu_ps(dst + i), _mm_loadu_ps(src + i)));
+  }
+  SubScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("sse2"))) void ScaleSse2(float* dst, float alpha,
+                                               std::size_t n) {
+  const __m128 factor = _mm_set1_ps(alpha);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(dst + i), factor));
+  }
+  ScaleScalar(dst + i, alpha, n - i);
+}
+
+__attribute__((target("sse2"))) void AxpySse2(float* dst, float alpha,
+                                              const float* src,
+                                              std::size_t n) {
+  const __m128 factor = _mm_set1_ps(alpha);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(dst + i,
+                  _mm_add_ps(_mm_loadu_ps(dst + i),
+                             _mm_mul_ps(factor, _mm_loadu_ps(src + i))));
+  }
+  AxpyScalar(dst + i, alpha, src + i, n - i);
+}
+
+__attribute__((target("sse2"))) bool EqualSse2(const float* a, const float* b,
+                                               std::size_t n, float epsilon) {
+  const __m128 sign = _mm_set1_ps(-0.0f);
+  const __m128 limit = _mm_set1_ps(epsilon);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m128 diff = _mm_andnot_ps(
+        sign, _mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    if (_mm_movemask_ps(_mm_cmpgt_ps(diff, limit))) return false;
+  }
+  return EqualScalar(a + i, b + i, n - i, epsilon);
+}
+
+__attribute__((target("sse2"))) void CopySse2(float* dst, const float* src,
+                                              std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) _mm_storeu_ps(dst + i, _mm_loadu_ps(src + i));
+  CopyScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("sse2"))) void FillSse2(float* dst, float value,
+                                              std::size_t n) {
+  const __m128 broadcast = _mm_set1_ps(value);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) _mm_storeu_ps(dst + i, broadcast);
+  FillScalar(dst + i, value, n - i);
+}
+
+__attribute__((target("avx2"))) void AddAvx2(float* dst, const float* src,
+                                             std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i),
+                                            _mm256_loadu_ps(src + i)));
+  }
+  AddScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx2"))) void SubAvx2(float* dst, const float* src,
+                                             std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(dst + i, _mm256_sub_ps(_mm256_loadu_ps(dst + i),
+                                            _mm256_loadu_ps(src + i)));
+  }
+  SubScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx2"))) void ScaleAvx2(float* dst, float alpha,
+                                               std::size_t n) {
+  const __m256 factor = _mm256_set1_ps(alpha);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(dst + i), factor));
+  }
+  ScaleScalar(dst + i, alpha, n - i);
+}
+
+__attribute__((target("avx2"))) void AxpyAvx2(float* dst, float alpha,
+                                              const float* src,
+                                              std::size_t n) {
+  const __m256 factor = _mm256_set1_ps(alpha);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m256 product = _mm256_mul_ps(factor, _mm256_loadu_ps(src + i));
+    _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), product));
+  }
+  AxpyScalar(dst + i, alpha, src + i, n - i);
+}
+
+__attribute__((target("avx2"))) bool EqualAvx2(const float* a, const float* b,
+                                               std::size_t n, float epsilon) {
+  const __m256 sign = _mm256_set1_ps(-0.0f);
+  const __m256 limit = _mm256_set1_ps(epsilon);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m256 diff = _mm256_andnot_ps(
+        sign, _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+    if (_mm256_movemask_ps(_mm256_cmp_ps(diff, limit, _CMP_GT_OQ))) {
+      return false;
+    }
+  }
+  return EqualScalar(a + i, b + i, n - i, epsilon);
+}
+
+__attribute__((target("avx2"))) void CopyAvx2(float* dst, const float* src,
+                                              std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(dst + i, _mm256_loadu_ps(src + i));
+  }
+  CopyScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx2"))) void FillAvx2(float* dst, float value,
+                                              std::size_t n) {
+  const __m256 broadcast = _mm256_set1_ps(value);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) _mm256_storeu_ps(dst + i, broadcast);
+  FillScalar(dst + i, value, n - i);
+}
+
+__attribute__((target("avx512f"))) void AddAvx512(float* dst,
+                                                  const float* src,
+                                                  std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    _mm512_storeu_ps(dst + i, _mm512_add_ps(_mm512_loadu_ps(dst + i),
+                                            _mm512_loadu_ps(src + i)));
+  }
+  AddScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx512f"))) void SubAvx512(float* dst,
+                                                  const float* src,
+                                                  std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    _mm512_storeu_ps(dst + i, _mm512_sub_ps(_mm512_loadu_ps(dst + i),
+                                            _mm512_loadu_ps(src + i)));
+  }
+  SubScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx512f"))) void ScaleAvx512(float* dst, float alpha,
+                                                    std::size_t n) {
+  const __m512 factor = _mm512_set1_ps(alpha);
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    _mm512_storeu_ps(dst + i, _mm512_mul_ps(_mm512_loadu_ps(dst + i), factor));
+  }
+  ScaleScalar(dst + i, alpha, n - i);
+}
+
+__attribute__((target("avx512f"))) void AxpyAvx512(float* dst, float alpha,
+                                                   const float* src,
+                                                   std::size_t n) {
+  const __m512 factor = _mm512_set1_ps(alpha);
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m512 product = _mm512_mul_ps(factor, _mm512_loadu_ps(src + i));
+    _mm512_storeu_ps(dst + i, _mm512_add_ps(_mm512_loadu_ps(dst + i), product));
+  }
+  AxpyScalar(dst + i, alpha, src + i, n - i);
+}
+
+__attribute__((target("avx512f"))) bool EqualAvx512(const float* a,
+                                                    const float* b,
+                                                    std::size_t n,
+                                                    float epsilon) {
+  const __m512 limit = _mm512_set1_ps(epsilon);
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m512 diff = _mm512_abs_ps(
+        _mm512_sub_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+    if (_mm512_cmp_ps_mask(diff, limit, _CMP_GT_OQ)) return false;
+  }
+  return EqualScalar(a + i, b + i, n - i, epsilon);
+}
+
+__attribute__((target("avx512f"))) void CopyAvx512(float* dst,
+                                                   const float* src,
+                                                   std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    _mm512_storeu_ps(dst + i, _mm512_loadu_ps(src + i));
+  }
+  CopyScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx512f"))) void FillAvx512(float* dst, float value,
+                                                   std::size_t n) {
+  const __m512 broadcast = _mm512_set1_ps(value);
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) _mm512_storeu_ps(dst + i, broadcast);
+  FillScalar(dst + i, value, n - i);
+}
+
+// The overload of each kernel that matches T lands in the table.
+template <typename T>
+constexpr S21BasicSimdKernels<T> kSse2Kernels = {
+    S21SimdLevel::kSse2, "sse2",    AddSse2,  SubSse2, ScaleSse2,
+    AxpySse2,            EqualSse2, CopySse2, FillSse2};
+
+template <typename T>
+constexpr S21BasicSimdKernels<T> kAvx2Kernels = {
+    S21SimdLevel::kAvx2, "avx2",    AddAvx2,  SubAvx2, ScaleAvx2,
+    AxpyAvx2,            EqualAvx2, CopyAvx2, FillAvx2};
+
+template <typename T>
+constexpr S21BasicSimdKernels<T> kAvx512Kernels = {
+    S21SimdLevel::kAvx512, "avx512f",   AddAvx512,  SubAvx512, ScaleAvx512,
+    AxpyAvx512,            EqualAvx512, CopyAvx512, FillAvx512};
+
+template <typename T>
+const S21BasicSimdKernels<T>* X86Kernels(S21SimdLevel level) {
+  const S21BasicSimdKernels<T>* kernels = nullptr;
+  if (level == S21SimdLevel::kSse2) {
+    kernels = &kSse2Kernels<T>;
+  } else if (level == S21SimdLevel::kAvx2) {
+    kernels = &kAvx2Kernels<T>;
+  } else if (level == S21SimdLevel::kAvx512) {
+    kernels = &kAvx512Kernels<T>;
+  }
+  return kernels;
+}
+
+template <>
+const S21BasicSimdKernels<double>* VectorKernels(S21SimdLevel level) {
+  return X86Kernels<double>(level);
+}
+
+template <>
+const S21BasicSimdKernels<float>* VectorKernels(S21SimdLevel level) {
+  return X86Kernels<float>(level);
+}
+
+#endif  // S21_SIMD_X86
+
+template <typename T>
+const S21BasicSimdKernels<T>& SelectKernels() {
+  const S21BasicSimdKernels<T>* best = &kScalarKernels<T>;
+  for (S21SimdLevel level : {S21SimdLevel::kSse2, S21SimdLevel::kAvx2,
+                             S21SimdLevel::kAvx512}) {
+    const S21BasicSimdKernels<T>* kernels = S21SimdKernelsFor<T>(level);
+    if (kernels) best = kernels;
+  }
+  return *best;
+}
+
+}  // namespace
+
+template <typename T>
+const S21BasicSimdKernels<T>& S21SimdActive() {
+  static const S21BasicSimdKernels<T>& kernels = SelectKernels<T>();
+  return kernels;
+}
+
+template <typename T>
+const S21BasicSimdKernels<T>* S21SimdKernelsFor(S21SimdLevel level) {
+  const S21BasicSimdKernels<T>* kernels = nullptr;
+#ifdef S21_SIMD_X86
+  __builtin_cpu_init();
+  if ((level == S21SimdLevel::kSse2 && __builtin_cpu_supports("sse2")) ||
+      (level == S21SimdLevel::kAvx2 && __builtin_cpu_supports("avx2")) ||
+      (level == S21SimdLevel::kAvx512 && __builtin_cpu_supports("avx512f"))) {
+    kernels = VectorKernels<T>(level);
+  }
+#endif
+  if (level == S21SimdLevel::kScalar) kernels = &kScalarKernels<T>;
+  return kernels;
+}
+
+template const S21BasicSimdKernels<float>& S21SimdActive();
+template const S21BasicSimdKernels<double>& S21SimdActive();
+template const S21BasicSimdKernels<long double>& S21SimdActive();
+template const S21BasicSimdKernels<std::complex<double>>& S21SimdActive();
+template const S21BasicSimdKernels<float>* S21SimdKernelsFor(S21SimdLevel);
+template const S21BasicSimdKernels<double>* S21SimdKernelsFor(S21SimdLevel);
+template const S21BasicSimdKernels<long double>* S21SimdKernelsFor(
+    S21SimdLevel);
+template const S21BasicSimdKernels<std::complex<double>>* S21SimdKernelsFor(
+    S21SimdLevel);
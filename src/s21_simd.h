@@ -0,0 +1,48 @@
+#ifndef SRC_S21_SIMD_H_
+#define SRC_S21_SIMD_H_
+
+#include <cstddef>
+
+#include "s21_matrix_traits.h"
+
+// Elementwise kernels behind SumMatrix, SubMatrix, MulNumber, EqMatrix and
+// the copy/fill paths of S21BasicMatrix. Every instruction set gets its own
+// table of kernels per element type; the widest one the CPU supports is
+// picked on first use. float and double have vector variants, long double
+// and complex elements only the scalar table. All variants round exactly
+// like the scalar fallback, so results do not depend on the machine; this
+// relies on building with -ffp-contract=off, which keeps the compiler from
+// fusing a * b + c.
+enum class S21SimdLevel { kScalar, kSse2, kAvx2, kAvx512 };
+
+template <typename T>
+struct S21BasicSimdKernels {
+  using Real = typename S21MatrixTraits<T>::Real;
+
+  S21SimdLevel level;
+  const char* name;
+  // dst[i] += src[i]
+  void (*add)(T* dst, const T* src, std::size_t n);
+  // dst[i] -= src[i]
+  void (*sub)(T* dst, const T* src, std::size_t n);
+  // dst[i] *= alpha
+  void (*scale)(T* dst, T alpha, std::size_t n);
+  // dst[i] += alpha * src[i]
+  void (*axpy)(T* dst, T alpha, const T* src, std::size_t n);
+  // True unless some |a[i] - b[i]| > epsilon
+  bool (*equal)(const T* a, const T* b, std::size_t n, Real epsilon);
+  void (*copy)(T* dst, const T* src, std::size_t n);
+  void (*fill)(T* dst, T value, std::size_t n);
+};
+
+using S21SimdKernels = S21BasicSimdKernels<double>;
+
+// Kernels for the best instruction set available on this CPU.
+template <typename T = double>
+const S21BasicSimdKernels<T>& S21SimdActive();
+// Kernels for one specific level, or nullptr when the compiler or the CPU
+// cannot run it, or the element type has no vector variant at that level.
+template <typename T = double>
+const S21BasicSimdKernels<T>* S21SimdKernelsFor(S21SimdLevel level);
+
+#endif  // SRC_S21_SIMD_H_
@@ -0,0 +1,685 @@
+#include "s21_sparse.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+
+// S21BasicSparseMatrix
+
+template <typename T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(
+    int rows, int cols, std::pmr::memory_resource* resource)
+    : S21BasicSparseMatrix(S21SparseFormat::kCoo, rows, cols, resource) {}
+
+template <typename T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(
+    const S21BasicMatrixView<const T>& dense, S21SparseFormat format,
+    std::pmr::memory_resource* resource)
+    : S21BasicSparseMatrix(S21SparseFormat::kCsr, dense.GetRows(),
+                           dense.GetCols(), resource) {
+  for (int i = 0; i < rows_; ++i) {
+    for (int j = 0; j < cols_; ++j) {
+      const T value = dense.Coeff(i, j);
+      if (value != T(0)) {
+        inner_.push_back(j);
+        values_.push_back(value);
+      }
+    }
+    outer_[i + 1] = static_cast<int>(inner_.size());
+  }
+  if (format != S21SparseFormat::kCsr) *this = Convert(format);
+}
+
+template <typename T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(
+    S21SparseFormat format, int rows, int cols,
+    std::pmr::memory_resource* resource)
+    : format_(format),
+      rows_(rows),
+      cols_(cols),
+      outer_(resource),
+      inner_(resource),
+      values_(resource) {
+  if (rows < 0 || cols < 0) {
+    throw std::out_of_range("Incorrect size of matrix");
+  }
+  if (format_ != S21SparseFormat::kCoo) outer_.assign(OuterSize() + 1, 0);
+}
+
+// Building
+
+template <typename T>
+void S21BasicSparseMatrix<T>::Insert(int i, int j, T value) {
+  if (format_ != S21SparseFormat::kCoo) {
+    throw std::invalid_argument("The sparse matrix isn't in COO format");
+  }
+  if (rows_ <= i || i < 0 || cols_ <= j || j < 0) {
+    throw std::out_of_range("The index out of matrix limit");
+  }
+  outer_.push_back(i);
+  inner_.push_back(j);
+  values_.push_back(value);
+}
+
+template <typename T>
+void S21BasicSparseMatrix<T>::Reserve(std::size_t non_zeros) {
+  if (format_ == S21SparseFormat::kCoo) outer_.reserve(non_zeros);
+  inner_.reserve(non_zeros);
+  values_.reserve(non_zeros);
+}
+
+// Conversions
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::Convert(
+    S21SparseFormat format) const {
+  if (format == format_) {
+    S21BasicSparseMatrix result(format_, rows_, cols_, GetResource());
+    result.outer_ = outer_;
+    result.inner_ = inner_;
+    result.values_ = values_;
+    return result;
+  }
+  if (format_ == S21SparseFormat::kCoo) {
+    S21BasicSparseMatrix result = Compress();
+    return format == S21SparseFormat::kCsr ? result : result.Flip();
+  }
+  if (format != S21SparseFormat::kCoo) return Flip();
+  S21BasicSparseMatrix result(S21SparseFormat::kCoo, rows_, cols_,
+                              GetResource());
+  result.Reserve(values_.size());
+  for (int o = 0; o < OuterSize(); ++o) {
+    for (int p = outer_[o]; p < outer_[o + 1]; ++p) {
+      if (format_ == S21SparseFormat::kCsr) {
+        result.Insert(o, inner_[p], values_[p]);
+      } else {
+        result.Insert(inner_[p], o, values_[p]);
+      }
+    }
+  }
+  return result;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicSparseMatrix<T>::ToDense() const {
+  S21BasicMatrix<T> dense(rows_, cols_, GetResource());
+  T* data = dense.data();
+  const std::ptrdiff_t stride = dense.stride();
+  if (format_ == S21SparseFormat::kCoo) {
+    for (std::size_t p = 0; p < values_.size(); ++p) {
+      data[outer_[p] * stride + inner_[p]] += values_[p];
+    }
+  } else {
+    const bool by_rows = format_ == S21SparseFormat::kCsr;
+    for (int o = 0; o < OuterSize(); ++o) {
+      for (int p = outer_[o]; p < outer_[o + 1]; ++p) {
+        const std::ptrdiff_t i = by_rows ? o : inner_[p];
+        const std::ptrdiff_t j = by_rows ? inner_[p] : o;
+        data[i * stride + j] = values_[p];
+      }
+    }
+  }
+  return dense;
+}
+
+// Operations
+
+template <typename T>
+void S21BasicSparseMatrix<T>::SumMatrix(const S21BasicSparseMatrix& other) {
+  if (rows_ != other.rows_ || cols_ != other.cols_) {
+    throw std::out_of_range("Different size of matrix");
+  }
+  if (format_ == S21SparseFormat::kCoo) {
+    const S21BasicSparseMatrix entries =
+        other.Convert(S21SparseFormat::kCoo);
+    outer_.insert(outer_.end(), entries.outer_.begin(), entries.outer_.end());
+    inner_.insert(inner_.end(), entries.inner_.begin(), entries.inner_.end());
+    values_.insert(values_.end(), entries.values_.begin(),
+                   entries.values_.end());
+  } else if (other.format_ == format_) {
+    MergeCompressed(other);
+  } else {
+    MergeCompressed(other.Convert(format_));
+  }
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::Transpose() const {
+  S21SparseFormat format = S21SparseFormat::kCoo;
+  if (format_ == S21SparseFormat::kCsr) {
+    format = S21SparseFormat::kCsc;
+  } else if (format_ == S21SparseFormat::kCsc) {
+    format = S21SparseFormat::kCsr;
+  }
+  S21BasicSparseMatrix result(format, cols_, rows_, GetResource());
+  if (format_ == S21SparseFormat::kCoo) {
+    result.outer_ = inner_;
+    result.inner_ = outer_;
+  } else {
+    result.outer_ = outer_;
+    result.inner_ = inner_;
+  }
+  result.values_ = values_;
+  return result;
+}
+
+template <typename T>
+std::vector<T> S21BasicSparseMatrix<T>::MulVector(
+    const std::vector<T>& x) const {
+  if (static_cast<int>(x.size()) != cols_) {
+    throw std::out_of_range("Different size of matrix");
+  }
+  if (format_ == S21SparseFormat::kCoo) {
+    return Convert(S21SparseFormat::kCsr).MulVector(x);
+  }
+  std::vector<T> y(rows_);
+  if (format_ == S21SparseFormat::kCsr) {
+    const double cost =
+        std::max(1.0, static_cast<double>(values_.size()) / (rows_ + 1));
+    S21ParallelFor(0, rows_, cost,
+                   [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                     for (std::ptrdiff_t i = begin; i < end; ++i) {
+                       T sum = 0;
+                       for (int p = outer_[i]; p < outer_[i + 1]; ++p) {
+                         sum += values_[p] * x[inner_[p]];
+                       }
+                       y[i] = sum;
+                     }
+                   });
+  } else {
+    for (int j = 0; j < cols_; ++j) {
+      const T xj = x[j];
+      if (xj == T(0)) continue;
+      for (int p = outer_[j]; p < outer_[j + 1]; ++p) {
+        y[inner_[p]] += values_[p] * xj;
+      }
+    }
+  }
+  return y;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicSparseMatrix<T>::MulMatrix(
+    const S21BasicMatrixView<const T>& dense) const {
+  if (cols_ != dense.GetRows()) {
+    throw std::out_of_range(
+        "The number of columns of the first matrix does not equal the number "
+        "of rows of the second matrix");
+  }
+  if (format_ == S21SparseFormat::kCoo) {
+    return Convert(S21SparseFormat::kCsr).MulMatrix(dense);
+  }
+  const int n = dense.GetCols();
+  S21BasicMatrix<T> product(rows_, n, GetResource());
+  if (!product.data() || dense.Empty()) return product;
+  const S21BasicSimdKernels<T>& simd = S21SimdActive<T>();
+  const T* b = dense.data();
+  const std::ptrdiff_t b_row = dense.RowStride();
+  const std::ptrdiff_t b_col = dense.ColStride();
+  T* c = product.data();
+  const std::ptrdiff_t c_row = product.stride();
+  // c[i][begin, end) += value * b[k][begin, end)
+  auto update = [&](std::ptrdiff_t i, std::ptrdiff_t k, T value,
+                    std::ptrdiff_t begin, std::ptrdiff_t end) {
+    const T* b_k = b + k * b_row + begin * b_col;
+    T* c_i = c + i * c_row + begin;
+    if (b_col == 1) {
+      simd.axpy(c_i, value, b_k, static_cast<std::size_t>(end - begin));
+    } else {
+      for (std::ptrdiff_t j = 0; j < end - begin; ++j) {
+        c_i[j] += value * b_k[j * b_col];
+      }
+    }
+  };
+  if (format_ == S21SparseFormat::kCsr) {
+    const double cost =
+        std::max(1.0, static_cast<double>(values_.size()) * n / (rows_ + 1));
+    S21ParallelFor(0, rows_, cost,
+                   [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                     for (std::ptrdiff_t i = begin; i < end; ++i) {
+                       for (int p = outer_[i]; p < outer_[i + 1]; ++p) {
+                         update(i, inner_[p], values_[p], 0, n);
+                       }
+                     }
+                   });
+  } else {
+    // Every column of A scatters into many rows of C, so tasks own slices
+    // of C's columns instead.
+    S21ParallelFor(0, n, std::max<double>(1.0, values_.size()),
+                   [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                     for (int k = 0; k < cols_; ++k) {
+                       for (int p = outer_[k]; p < outer_[k + 1]; ++p) {
+                         update(inner_[p], k, values_[p], begin, end);
+                       }
+                     }
+                   });
+  }
+  return product;
+}
+
+// Overloadings opertators
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::operator+(
+    const S21BasicSparseMatrix& other) const {
+  S21BasicSparseMatrix result = Convert(format_);
+  result.SumMatrix(other);
+  return result;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T>& S21BasicSparseMatrix<T>::operator+=(
+    const S21BasicSparseMatrix& other) {
+  this->SumMatrix(other);
+  return *this;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicSparseMatrix<T>::operator*(
+    const S21BasicMatrixView<const T>& dense) const {
+  return MulMatrix(dense);
+}
+
+template <typename T>
+std::vector<T> S21BasicSparseMatrix<T>::operator*(
+    const std::vector<T>& x) const {
+  return MulVector(x);
+}
+
+template <typename T>
+T S21BasicSparseMatrix<T>::operator()(int i, int j) const {
+  if (rows_ <= i || i < 0 || cols_ <= j || j < 0) {
+    throw std::out_of_range("The index out of matrix limit");
+  }
+  T value = 0;
+  if (format_ == S21SparseFormat::kCoo) {
+    for (std::size_t p = 0; p < values_.size(); ++p) {
+      if (outer_[p] == i && inner_[p] == j) value += values_[p];
+    }
+  } else {
+    const int o = format_ == S21SparseFormat::kCsr ? i : j;
+    const int target = format_ == S21SparseFormat::kCsr ? j : i;
+    const auto first = inner_.begin() + outer_[o];
+    const auto last = inner_.begin() + outer_[o + 1];
+    const auto found = std::lower_bound(first, last, target);
+    if (found != last && *found == target) {
+      value = values_[found - inner_.begin()];
+    }
+  }
+  return value;
+}
+
+// Accessors
+
+template <typename T>
+int S21BasicSparseMatrix<T>::GetRows() const {
+  return rows_;
+}
+
+template <typename T>
+int S21BasicSparseMatrix<T>::GetCols() const {
+  return cols_;
+}
+
+template <typename T>
+std::size_t S21BasicSparseMatrix<T>::GetNonZeros() const {
+  return values_.size();
+}
+
+template <typename T>
+S21SparseFormat S21BasicSparseMatrix<T>::GetFormat() const {
+  return format_;
+}
+
+template <typename T>
+std::pmr::memory_resource* S21BasicSparseMatrix<T>::GetResource() const {
+  return values_.get_allocator().resource();
+}
+
+template <typename T>
+const std::pmr::vector<int>& S21BasicSparseMatrix<T>::outer() const {
+  return outer_;
+}
+
+template <typename T>
+const std::pmr::vector<int>& S21BasicSparseMatrix<T>::inner() const {
+  return inner_;
+}
+
+template <typename T>
+const std::pmr::vector<T>& S21BasicSparseMatrix<T>::values() const {
+  return values_;
+}
+
+// Additional
+
+template <typename T>
+int S21BasicSparseMatrix<T>::OuterSize() const {
+  return format_ == S21SparseFormat::kCsc ? cols_ : rows_;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::Flip() const {
+  const bool to_rows = format_ == S21SparseFormat::kCsc;
+  S21BasicSparseMatrix result(
+      to_rows ? S21SparseFormat::kCsr : S21SparseFormat::kCsc, rows_, cols_,
+      GetResource());
+  for (int index : inner_) ++result.outer_[index + 1];
+  std::partial_sum(result.outer_.begin(), result.outer_.end(),
+                   result.outer_.begin());
+  result.inner_.resize(inner_.size());
+  result.values_.resize(values_.size());
+  // Walking the outer lists in order leaves every new list sorted.
+  std::pmr::vector<int> next(result.outer_.begin(), result.outer_.end() - 1,
+                             GetResource());
+  for (int o = 0; o < OuterSize(); ++o) {
+    for (int p = outer_[o]; p < outer_[o + 1]; ++p) {
+      const int q = next[inner_[p]]++;
+      result.inner_[q] = o;
+      result.values_[q] = values_[p];
+    }
+  }
+  return result;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::Compress() const {
+  // Bucketing the entries by column and then by row sorts every row by
+  // column and leaves duplicates next to each other.
+  S21BasicSparseMatrix by_cols(S21SparseFormat::kCsc, rows_, cols_,
+                               GetResource());
+  for (int j : inner_) ++by_cols.outer_[j + 1];
+  std::partial_sum(by_cols.outer_.begin(), by_cols.outer_.end(),
+                   by_cols.outer_.begin());
+  by_cols.inner_.resize(inner_.size());
+  by_cols.values_.resize(values_.size());
+  std::pmr::vector<int> next(by_cols.outer_.begin(),
+                             by_cols.outer_.end() - 1, GetResource());
+  for (std::size_t p = 0; p < values_.size(); ++p) {
+    const int q = next[inner_[p]]++;
+    by_cols.inner_[q] = outer_[p];
+    by_cols.values_[q] = values_[p];
+  }
+  S21BasicSparseMatrix result = by_cols.Flip();
+  int kept = 0;
+  for (int i = 0, p = 0; i < rows_; ++i) {
+    const int row_end = result.outer_[i + 1];
+    for (; p < row_end; ++p) {
+      if (kept > result.outer_[i] &&
+          result.inner_[kept - 1] == result.inner_[p]) {
+        result.values_[kept - 1] += result.values_[p];
+      } else {
+        result.inner_[kept] = result.inner_[p];
+        result.values_[kept] = result.values_[p];
+        ++kept;
+      }
+    }
+    result.outer_[i + 1] = kept;
+  }
+  result.inner_.resize(kept);
+  result.values_.resize(kept);
+  return result;
+}
+
+template <typename T>
+void S21BasicSparseMatrix<T>::MergeCompressed(
+    const S21BasicSparseMatrix& other) {
+  S21BasicSparseMatrix result(format_, rows_, cols_, GetResource());
+  result.Reserve(values_.size() + other.values_.size());
+  for (int o = 0; o < OuterSize(); ++o) {
+    int p = outer_[o];
+    int q = other.outer_[o];
+    while (p < outer_[o + 1] || q < other.outer_[o + 1]) {
+      const int a = p < outer_[o + 1] ? inner_[p] : cols_ + rows_;
+      const int b = q < other.outer_[o + 1] ? other.inner_[q] : cols_ + rows_;
+      T value = 0;
+      if (a <= b) value += values_[p++];
+      if (b <= a) value += other.values_[q++];
+      // Entries that cancel out are dropped.
+      if (value != T(0)) {
+        result.inner_.push_back(std::min(a, b));
+        result.values_.push_back(value);
+      }
+    }
+    result.outer_[o + 1] = static_cast<int>(result.inner_.size());
+  }
+  *this = std::move(result);
+}
+
+// S21BasicSparseLU
+
+template <typename T>
+S21BasicSparseLU<T>::S21BasicSparseLU(const S21BasicSparseMatrix<T>& matrix)
+    : size_(matrix.GetRows()),
+      singular_(matrix.GetRows() == 0),
+      lower_outer_(matrix.GetResource()),
+      lower_inner_(matrix.GetResource()),
+      lower_values_(matrix.GetResource()),
+      upper_outer_(matrix.GetResource()),
+      upper_inner_(matrix.GetResource()),
+      upper_values_(matrix.GetResource()),
+      pivot_of_(matrix.GetResource()) {
+  if (matrix.GetRows() != matrix.GetCols()) {
+    throw std::out_of_range("The matrix isn't square");
+  }
+  std::pmr::memory_resource* resource = matrix.GetResource();
+  const S21BasicSparseMatrix<T> a = matrix.Convert(S21SparseFormat::kCsc);
+  const int n = size_;
+  pivot_of_.assign(n, -1);
+  lower_outer_.assign(n + 1, 0);
+  upper_outer_.assign(n + 1, 0);
+  lower_inner_.reserve(a.GetNonZeros() + n);
+  lower_values_.reserve(a.GetNonZeros() + n);
+  upper_inner_.reserve(a.GetNonZeros() + n);
+  upper_values_.reserve(a.GetNonZeros() + n);
+  // x is the dense accumulator of the current column; reach[top, n) lists
+  // its nonzero rows in topological order of the graph of L.
+  std::pmr::vector<T> x(n, T(0), resource);
+  std::pmr::vector<int> reach(n, 0, resource);
+  std::pmr::vector<int> stack(n, 0, resource);
+  std::pmr::vector<int> resume(n, 0, resource);
+  std::pmr::vector<char> marked(n, 0, resource);
+  // Depth-first search from row start through the columns of L computed so
+  // far; finished rows are pushed in front of reach[top].
+  auto search = [&](int start, int top) {
+    int head = 0;
+    stack[0] = start;
+    while (head >= 0) {
+      const int row = stack[head];
+      const int column = pivot_of_[row];
+      if (!marked[row]) {
+        marked[row] = 1;
+        resume[head] = column < 0 ? 0 : lower_outer_[column];
+      }
+      const int end = column < 0 ? 0 : lower_outer_[column + 1];
+      bool done = true;
+      for (int p = resume[head]; p < end; ++p) {
+        const int next = lower_inner_[p];
+        if (marked[next]) continue;
+        resume[head] = p + 1;
+        stack[++head] = next;
+        done = false;
+        break;
+      }
+      if (done) {
+        --head;
+        reach[--top] = row;
+      }
+    }
+    return top;
+  };
+  for (int k = 0; k < n && !singular_; ++k) {
+    lower_outer_[k] = static_cast<int>(lower_inner_.size());
+    upper_outer_[k] = static_cast<int>(upper_inner_.size());
+    int top = n;
+    for (int p = a.outer()[k]; p < a.outer()[k + 1]; ++p) {
+      if (!marked[a.inner()[p]]) top = search(a.inner()[p], top);
+    }
+    for (int p = top; p < n; ++p) {
+      marked[reach[p]] = 0;
+      x[reach[p]] = T(0);
+    }
+    for (int p = a.outer()[k]; p < a.outer()[k + 1]; ++p) {
+      x[a.inner()[p]] = a.values()[p];
+    }
+    // x = L^-1 * A(:, k) over the reachable rows only
+    for (int p = top; p < n; ++p) {
+      const int column = pivot_of_[reach[p]];
+      if (column < 0) continue;
+      const T factor = x[reach[p]];
+      for (int q = lower_outer_[column] + 1; q < lower_outer_[column + 1];
+           ++q) {
+        x[lower_inner_[q]] -= lower_values_[q] * factor;
+      }
+    }
+    // Pivoted rows form column k of U; the largest of the rest is the pivot.
+    int pivot = -1;
+    Real pivot_value = 0;
+    for (int p = top; p < n; ++p) {
+      const int row = reach[p];
+      if (pivot_of_[row] < 0) {
+        const Real value = std::abs(x[row]);
+        if (value > pivot_value) {
+          pivot = row;
+          pivot_value = value;
+        }
+      } else {
+        upper_inner_.push_back(pivot_of_[row]);
+        upper_values_.push_back(x[row]);
+      }
+    }
+    if (pivot < 0) {
+      singular_ = true;
+      break;
+    }
+    pivot_of_[pivot] = k;
+    upper_inner_.push_back(k);
+    upper_values_.push_back(x[pivot]);
+    lower_inner_.push_back(pivot);
+    lower_values_.push_back(T(1));
+    const T inverse_pivot = T(1) / x[pivot];
+    for (int p = top; p < n; ++p) {
+      const int row = reach[p];
+      if (pivot_of_[row] < 0) {
+        lower_inner_.push_back(row);
+        lower_values_.push_back(x[row] * inverse_pivot);
+      }
+    }
+  }
+  if (!singular_) {
+    lower_outer_[n] = static_cast<int>(lower_inner_.size());
+    upper_outer_[n] = static_cast<int>(upper_inner_.size());
+    for (int& row : lower_inner_) row = pivot_of_[row];
+  }
+}
+
+template <typename T>
+T S21BasicSparseLU<T>::Determinant() const {
+  if (singular_) return T(0);
+  // The sign of the row permutation is -1 per even-length cycle.
+  std::vector<char> visited(size_, 0);
+  T det = T(1);
+  for (int i = 0; i < size_; ++i) {
+    det *= upper_values_[upper_outer_[i + 1] - 1];
+    if (visited[i]) continue;
+    int length = 0;
+    for (int j = i; !visited[j]; j = pivot_of_[j]) {
+      visited[j] = 1;
+      ++length;
+    }
+    if (length % 2 == 0) det = -det;
+  }
+  return det;
+}
+
+template <typename T>
+bool S21BasicSparseLU<T>::IsSingular() const {
+  return singular_;
+}
+
+template <typename T>
+std::vector<T> S21BasicSparseLU<T>::Solve(const std::vector<T>& b) const {
+  if (static_cast<int>(b.size()) != size_) {
+    throw std::out_of_range("Different size of matrix");
+  }
+  CheckSolvable();
+  std::vector<T> x(size_), scratch(size_);
+  SolveInto(b.data(), 1, x.data(), 1, scratch.data());
+  return x;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicSparseLU<T>::Solve(
+    const S21BasicMatrix<T>& b) const {
+  if (b.GetRows() != size_) {
+    throw std::out_of_range("Different size of matrix");
+  }
+  CheckSolvable();
+  S21BasicMatrix<T> x(b.GetRows(), b.GetCols(), b.GetResource());
+  if (!x.data()) return x;
+  // Right-hand sides are independent; each task solves a slice of columns.
+  S21ParallelFor(0, b.GetCols(), 2.0 * GetNonZeros(),
+                 [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                   std::vector<T> scratch(size_);
+                   for (std::ptrdiff_t j = begin; j < end; ++j) {
+                     SolveInto(b.data() + j, b.stride(), x.data() + j,
+                               x.stride(), scratch.data());
+                   }
+                 });
+  return x;
+}
+
+template <typename T>
+int S21BasicSparseLU<T>::GetSize() const {
+  return size_;
+}
+
+template <typename T>
+std::size_t S21BasicSparseLU<T>::GetNonZeros() const {
+  return lower_values_.size() + upper_values_.size();
+}
+
+template <typename T>
+void S21BasicSparseLU<T>::CheckSolvable() const {
+  if (IsSingular()) {
+    throw std::invalid_argument("the Determinant of the matrix is 0");
+  }
+}
+
+template <typename T>
+void S21BasicSparseLU<T>::SolveInto(const T* b, std::ptrdiff_t b_stride, T* x,
+                                    std::ptrdiff_t x_stride,
+                                    T* scratch) const {
+  for (int i = 0; i < size_; ++i) scratch[pivot_of_[i]] = b[i * b_stride];
+  for (int j = 0; j < size_; ++j) {
+    const T factor = scratch[j];
+    if (factor == T(0)) continue;
+    for (int p = lower_outer_[j] + 1; p < lower_outer_[j + 1]; ++p) {
+      scratch[lower_inner_[p]] -= lower_values_[p] * factor;
+    }
+  }
+  for (int j = size_ - 1; j >= 0; --j) {
+    const int diagonal = upper_outer_[j + 1] - 1;
+    scratch[j] /= upper_values_[diagonal];
+    const T factor = scratch[j];
+    if (factor == T(0)) continue;
+    for (int p = upper_outer_[j]; p < diagonal; ++p) {
+      scratch[upper_inner_[p]] -= upper_values_[p] * factor;
+    }
+  }
+  for (int i = 0; i < size_; ++i) x[i * x_stride] = scratch[i];
+}
+
+template class S21BasicSparseMatrix<float>;
+template class S21BasicSparseMatrix<double>;
+template class S21BasicSparseMatrix<long double>;
+template class S21BasicSparseMatrix<std::complex<double>>;
+template class S21BasicSparseLU<float>;
+template class S21BasicSparseLU<double>;
+template class S21BasicSparseLU<long double>;
+template class S21BasicSparseLU<std::complex<double>>;
@@ -0,0 +1,151 @@
+#ifndef SRC_S21_SPARSE_H_
+#define SRC_S21_SPARSE_H_
+
+#include <complex>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+#include "s21_matrix_traits.h"
+
+// Storage layouts of S21BasicSparseMatrix. COO is the building format:
+// entries are appended in any order and duplicates are summed when the
+// matrix is compressed. CSR and CSC are the compute formats, with the
+// entries of each row (CSR) or column (CSC) sorted and unique.
+enum class S21SparseFormat { kCoo, kCsr, kCsc };
+
+// Sparse matrix that stores only its nonzero entries in three arrays:
+//   CSR: outer() holds rows + 1 row pointers, inner() the column of each
+//        entry, so row i is [outer()[i], outer()[i + 1]);
+//   CSC: the same with rows and columns exchanged;
+//   COO: outer() holds the row and inner() the column of every entry.
+// The arrays come from a std::pmr::memory_resource, like the buffer of
+// S21BasicMatrix, and so do the temporaries of every operation. Defined for
+// the element types of S21BasicMatrix; S21SparseMatrix is the double one.
+template <typename T>
+class S21BasicSparseMatrix {
+ public:
+  // Constructors
+  // Empty rows x cols matrix in COO format, ready for Insert()
+  S21BasicSparseMatrix(int rows, int cols,
+                       std::pmr::memory_resource* resource =
+                           std::pmr::get_default_resource());
+  // Keeps the nonzero elements of a dense matrix
+  explicit S21BasicSparseMatrix(
+      const S21BasicMatrixView<const T>& dense,
+      S21SparseFormat format = S21SparseFormat::kCsr,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+  // Building
+  // Appends element (i, j); COO format only
+  void Insert(int i, int j, T value);
+  void Reserve(std::size_t non_zeros);
+  // Conversions
+  S21BasicSparseMatrix Convert(S21SparseFormat format) const;
+  S21BasicMatrix<T> ToDense() const;
+  // Operations
+  // Merges other into the format of this matrix; a COO matrix just appends
+  // the entries of other.
+  void SumMatrix(const S21BasicSparseMatrix& other);
+  // Reuses the arrays as they are: the transpose of a CSR matrix comes back
+  // as CSC and vice versa, so nothing is sorted.
+  S21BasicSparseMatrix Transpose() const;
+  // Sparse times dense. CSR runs parallel over its rows; CSC runs the
+  // matrix product parallel over the columns of the dense operand and the
+  // vector product serially. COO is compressed to CSR first.
+  std::vector<T> MulVector(const std::vector<T>& x) const;
+  S21BasicMatrix<T> MulMatrix(const S21BasicMatrixView<const T>& dense) const;
+  // Overloadings opertators
+  S21BasicSparseMatrix operator+(const S21BasicSparseMatrix& other) const;
+  S21BasicSparseMatrix& operator+=(const S21BasicSparseMatrix& other);
+  S21BasicMatrix<T> operator*(const S21BasicMatrixView<const T>& dense) const;
+  std::vector<T> operator*(const std::vector<T>& x) const;
+  // Element (i, j), zero when it is not stored
+  T operator()(int i, int j) const;
+  // Accessors
+  int GetRows() const;
+  int GetCols() const;
+  std::size_t GetNonZeros() const;
+  S21SparseFormat GetFormat() const;
+  std::pmr::memory_resource* GetResource() const;
+  const std::pmr::vector<int>& outer() const;
+  const std::pmr::vector<int>& inner() const;
+  const std::pmr::vector<T>& values() const;
+
+ private:
+  S21BasicSparseMatrix(S21SparseFormat format, int rows, int cols,
+                       std::pmr::memory_resource* resource);
+
+  S21SparseFormat format_;
+  int rows_;
+  int cols_;
+  std::pmr::vector<int> outer_;
+  std::pmr::vector<int> inner_;
+  std::pmr::vector<T> values_;
+  // Additional
+  // Rows for CSR and columns for CSC
+  int OuterSize() const;
+  // CSR <-> CSC of the same matrix, by a counting sort on inner()
+  S21BasicSparseMatrix Flip() const;
+  // COO -> CSR with sorted, unique entries in every row
+  S21BasicSparseMatrix Compress() const;
+  // Row or column lists of a compressed matrix merged entry by entry
+  void MergeCompressed(const S21BasicSparseMatrix& other);
+};
+
+// Sparse LU factorisation with partial pivoting, P * A = L * U, computed
+// column by column (Gilbert-Peierls): each column of L and U comes from a
+// sparse triangular solve that only visits the rows it can reach, so the
+// work grows with the fill-in rather than with n^2. No fill-reducing column
+// ordering is applied, so matrices whose nonzeros sit near the diagonal
+// factor best. Like S21BasicLU, a singular matrix factors without error
+// and the solves throw.
+template <typename T>
+class S21BasicSparseLU {
+ public:
+  explicit S21BasicSparseLU(const S21BasicSparseMatrix<T>& matrix);
+  // Operations
+  T Determinant() const;
+  bool IsSingular() const;
+  std::vector<T> Solve(const std::vector<T>& b) const;
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T>& b) const;
+  // Accessors
+  int GetSize() const;
+  // Entries of L and U together, a measure of the fill-in
+  std::size_t GetNonZeros() const;
+
+ private:
+  using Real = typename S21MatrixTraits<T>::Real;
+
+  int size_;
+  bool singular_;
+  // Both factors in CSC; the unit diagonal of L is stored first in each of
+  // its columns and the diagonal of U last.
+  std::pmr::vector<int> lower_outer_;
+  std::pmr::vector<int> lower_inner_;
+  std::pmr::vector<T> lower_values_;
+  std::pmr::vector<int> upper_outer_;
+  std::pmr::vector<int> upper_inner_;
+  std::pmr::vector<T> upper_values_;
+  // Row i of A is row pivot_of_[i] of L * U
+  std::pmr::vector<int> pivot_of_;
+  // Additional
+  void CheckSolvable() const;
+  // x = U^-1 * L^-1 * P * b, for b of size n and scratch of size n
+  void SolveInto(const T* b, std::ptrdiff_t b_stride, T* x,
+                 std::ptrdiff_t x_stride, T* scratch) const;
+};
+
+extern template class S21BasicSparseMatrix<float>;
+extern template class S21BasicSparseMatrix<double>;
+extern template class S21BasicSparseMatrix<long double>;
+extern template class S21BasicSparseMatrix<std::complex<double>>;
+extern template class S21BasicSparseLU<float>;
+extern template class S21BasicSparseLU<double>;
+extern template class S21BasicSparseLU<long double>;
+extern template class S21BasicSparseLU<std::complex<double>>;
+
+using S21SparseMatrix = S21BasicSparseMatrix<double>;
+using S21SparseLU = S21BasicSparseLU<double>;
+
+#endif  // SRC_S21_SPARSE_H_
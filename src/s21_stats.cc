@@ -0,0 +1,280 @@
+#include "s21_stats.h"
+
+#include <atomic>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <mutex>
+#include <sstream>
+
+namespace {
+
+constexpr int kOperations = static_cast<int>(S21Operation::kCount);
+constexpr int kBuckets = S21OperationStats::kBuckets;
+
+struct Counters {
+  std::atomic<std::uint64_t> calls;
+  std::atomic<std::uint64_t> nanoseconds;
+  std::array<std::atomic<std::uint64_t>, kBuckets> latency_buckets;
+  std::atomic<std::uint64_t> flops;
+  std::atomic<std::uint64_t> allocated_bytes;
+};
+
+// Static storage, so every counter starts at zero.
+std::array<Counters, kOperations> counters;
+std::mutex shapes_mutex;
+std::array<std::map<S21Shape, std::uint64_t>, kOperations> shapes;
+
+thread_local int running = 0;
+thread_local S21Operation current = S21Operation::kOther;
+
+Counters& CountersOf(S21Operation operation) {
+  return counters[static_cast<int>(operation)];
+}
+
+// Smallest bucket whose bound holds the latency
+int Bucket(std::uint64_t nanoseconds) {
+  double bound = 1000;
+  int bucket = 0;
+  while (bucket < kBuckets - 1 && static_cast<double>(nanoseconds) > bound) {
+    bound *= 4;
+    ++bucket;
+  }
+  return bucket;
+}
+
+void Reset(std::atomic<std::uint64_t>& counter) {
+  counter.store(0, std::memory_order_relaxed);
+}
+
+std::uint64_t Load(const std::atomic<std::uint64_t>& counter) {
+  return counter.load(std::memory_order_relaxed);
+}
+
+// One Prometheus sample per operation, labelled by it.
+template <typename Value>
+void WriteFamily(std::ostringstream& out, const S21StatsSnapshot& snapshot,
+                 const char* name, const char* type, const char* help,
+                 Value value) {
+  out << "# HELP " << name << ' ' << help << "\n# TYPE " << name << ' '
+      << type << '\n';
+  for (int i = 0; i < kOperations; ++i) {
+    out << name << "{operation=\""
+        << S21OperationName(static_cast<S21Operation>(i)) << "\"} "
+        << value(snapshot.operations[i]) << '\n';
+  }
+}
+
+}  // namespace
+
+const char* S21OperationName(S21Operation operation) {
+  switch (operation) {
+    case S21Operation::kSumMatrix:
+      return "SumMatrix";
+    case S21Operation::kSubMatrix:
+      return "SubMatrix";
+    case S21Operation::kMulNumber:
+      return "MulNumber";
+    case S21Operation::kMulMatrix:
+      return "MulMatrix";
+    case S21Operation::kGemm:
+      return "Gemm";
+    case S21Operation::kTranspose:
+      return "Transpose";
+    case S21Operation::kCalcComplements:
+      return "CalcComplements";
+    case S21Operation::kDeterminant:
+      return "Determinant";
+    case S21Operation::kInverseMatrix:
+      return "InverseMatrix";
+    case S21Operation::kEqMatrix:
+      return "EqMatrix";
+    case S21Operation::kSetRows:
+      return "SetRows";
+    case S21Operation::kSetCols:
+      return "SetCols";
+    case S21Operation::kOther:
+    case S21Operation::kCount:
+      break;
+  }
+  return "Other";
+}
+
+std::string S21Shape::ToString() const {
+  std::string text = std::to_string(rows) + "x";
+  if (depth > 0) text += std::to_string(depth) + "x";
+  return text + std::to_string(cols);
+}
+
+double S21OperationStats::BucketBound(int bucket) {
+  if (bucket >= kBuckets - 1) return std::numeric_limits<double>::infinity();
+  return 1e-6 * std::pow(4.0, bucket);
+}
+
+// S21StatsSnapshot
+
+std::string S21StatsSnapshot::ToPrometheus() const {
+  std::ostringstream out;
+  out << std::setprecision(9);
+  WriteFamily(out, *this, "s21_matrix_calls_total", "counter",
+              "Calls of S21Matrix operations.",
+              [](const S21OperationStats& stats) { return stats.calls; });
+  out << "# HELP s21_matrix_latency_seconds Latency of S21Matrix "
+         "operations.\n# TYPE s21_matrix_latency_seconds histogram\n";
+  for (int i = 0; i < kOperations; ++i) {
+    const S21OperationStats& stats = operations[i];
+    const std::string label = std::string("operation=\"") +
+                              S21OperationName(static_cast<S21Operation>(i)) +
+                              '"';
+    std::uint64_t cumulative = 0;
+    for (int bucket = 0; bucket < kBuckets; ++bucket) {
+      cumulative += stats.latency_buckets[bucket];
+      out << "s21_matrix_latency_seconds_bucket{" << label << ",le=\"";
+      if (bucket == kBuckets - 1) {
+        out << "+Inf";
+      } else {
+        out << S21OperationStats::BucketBound(bucket);
+      }
+      out << "\"} " << cumulative << '\n';
+    }
+    out << "s21_matrix_latency_seconds_sum{" << label << "} "
+        << stats.nanoseconds * 1e-9 << '\n'
+        << "s21_matrix_latency_seconds_count{" << label << "} " << stats.calls
+        << '\n';
+  }
+  WriteFamily(out, *this, "s21_matrix_flops_total", "counter",
+              "Nominal floating-point operations of S21Matrix operations.",
+              [](const S21OperationStats& stats) { return stats.flops; });
+  WriteFamily(
+      out, *this, "s21_matrix_allocated_bytes_total", "counter",
+      "Bytes of matrix buffers allocated, by the operation running.",
+      [](const S21OperationStats& stats) { return stats.allocated_bytes; });
+  out << "# HELP s21_matrix_shape_calls_total Calls of S21Matrix operations "
+         "by operand shape.\n# TYPE s21_matrix_shape_calls_total counter\n";
+  for (int i = 0; i < kOperations; ++i) {
+    for (const auto& [shape, calls] : operations[i].shapes) {
+      out << "s21_matrix_shape_calls_total{operation=\""
+          << S21OperationName(static_cast<S21Operation>(i)) << "\",shape=\""
+          << shape.ToString() << "\"} " << calls << '\n';
+    }
+  }
+  return out.str();
+}
+
+std::string S21StatsSnapshot::ToJson() const {
+  std::ostringstream out;
+  out << std::setprecision(9) << "{\n  \"enabled\": "
+      << (S21StatsEnabled() ? "true" : "false")
+      << ",\n  \"latency_bounds_seconds\": [";
+  for (int bucket = 0; bucket < kBuckets - 1; ++bucket) {
+    out << (bucket ? ", " : "") << S21OperationStats::BucketBound(bucket);
+  }
+  out << "],\n  \"operations\": [";
+  for (int i = 0; i < kOperations; ++i) {
+    const S21OperationStats& stats = operations[i];
+    out << (i ? "," : "") << "\n    {\"operation\": \""
+        << S21OperationName(static_cast<S21Operation>(i))
+        << "\", \"calls\": " << stats.calls
+        << ", \"seconds\": " << stats.nanoseconds * 1e-9
+        << ", \"flops\": " << stats.flops
+        << ", \"allocated_bytes\": " << stats.allocated_bytes
+        << ",\n     \"latency_buckets\": [";
+    for (int bucket = 0; bucket < kBuckets; ++bucket) {
+      out << (bucket ? ", " : "") << stats.latency_buckets[bucket];
+    }
+    out << "],\n     \"shapes\": {";
+    bool first = true;
+    for (const auto& [shape, calls] : stats.shapes) {
+      out << (first ? "" : ", ") << '"' << shape.ToString() << "\": " << calls;
+      first = false;
+    }
+    out << "}}";
+  }
+  out << "\n  ]\n}\n";
+  return out.str();
+}
+
+bool S21StatsEnabled() {
+#ifdef S21_MATRIX_STATS
+  return true;
+#else
+  return false;
+#endif
+}
+
+S21StatsSnapshot S21StatsSnapshotNow() {
+  S21StatsSnapshot snapshot;
+  for (int i = 0; i < kOperations; ++i) {
+    const Counters& from = counters[i];
+    S21OperationStats& to = snapshot.operations[i];
+    to.calls = Load(from.calls);
+    to.nanoseconds = Load(from.nanoseconds);
+    for (int bucket = 0; bucket < kBuckets; ++bucket) {
+      to.latency_buckets[bucket] = Load(from.latency_buckets[bucket]);
+    }
+    to.flops = Load(from.flops);
+    to.allocated_bytes = Load(from.allocated_bytes);
+  }
+  const std::lock_guard<std::mutex> lock(shapes_mutex);
+  for (int i = 0; i < kOperations; ++i) {
+    snapshot.operations[i].shapes = shapes[i];
+  }
+  return snapshot;
+}
+
+void S21StatsReset() {
+  for (Counters& operation : counters) {
+    Reset(operation.calls);
+    Reset(operation.nanoseconds);
+    for (auto& bucket : operation.latency_buckets) Reset(bucket);
+    Reset(operation.flops);
+    Reset(operation.allocated_bytes);
+  }
+  const std::lock_guard<std::mutex> lock(shapes_mutex);
+  for (auto& operation : shapes) operation.clear();
+}
+
+// S21StatsScope
+
+S21StatsScope::S21StatsScope(S21Operation operation, S21Shape shape,
+                             double flops)
+    : operation_(operation), outermost_(running++ == 0) {
+  if (outermost_) {
+    current = operation;
+    Counters& counters = CountersOf(operation);
+    counters.calls.fetch_add(1, std::memory_order_relaxed);
+    counters.flops.fetch_add(static_cast<std::uint64_t>(std::llround(flops)),
+                             std::memory_order_relaxed);
+    {
+      const std::lock_guard<std::mutex> lock(shapes_mutex);
+      auto& distribution = shapes[static_cast<int>(operation)];
+      auto found = distribution.find(shape);
+      if (found != distribution.end()) {
+        ++found->second;
+      } else if (distribution.size() < kS21StatsMaxShapes) {
+        distribution.emplace(shape, 1);
+      }
+    }
+    start_ = std::chrono::steady_clock::now();
+  }
+}
+
+S21StatsScope::~S21StatsScope() {
+  --running;
+  if (outermost_) {
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start_);
+    const std::uint64_t nanoseconds =
+        static_cast<std::uint64_t>(elapsed.count());
+    Counters& counters = CountersOf(operation_);
+    counters.nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+    counters.latency_buckets[Bucket(nanoseconds)].fetch_add(
+        1, std::memory_order_relaxed);
+    current = S21Operation::kOther;
+  }
+}
+
+void S21StatsRecordAllocation(std::size_t bytes) {
+  CountersOf(current).allocated_bytes.fetch_add(bytes,
+                                                std::memory_order_relaxed);
+}
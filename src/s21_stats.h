@@ -0,0 +1,125 @@
+#ifndef SRC_S21_STATS_H_
+#define SRC_S21_STATS_H_
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+
+// Per-operation statistics of S21BasicMatrix: calls, latency (total and a
+// histogram), nominal floating-point operations, bytes allocated and how
+// often each shape came up. Recording is compiled in only when the library
+// is built with -DS21_MATRIX_STATS (make STATS=1); otherwise the hooks in
+// the operations expand to nothing and do not even evaluate their
+// arguments. The snapshot, reset and dump functions exist either way and
+// report zeros in a build without statistics.
+//
+// Only the outermost operation of a thread records, so the Determinant an
+// InverseMatrix runs internally is not counted again, and an allocation is
+// charged to the operation running on its thread, or to kOther outside of
+// any. Recording is thread-safe; a snapshot taken while operations run may
+// see some counters of a call updated and others not yet.
+enum class S21Operation {
+  kSumMatrix,
+  kSubMatrix,
+  kMulNumber,
+  kMulMatrix,
+  kGemm,
+  kTranspose,
+  kCalcComplements,
+  kDeterminant,
+  kInverseMatrix,
+  kEqMatrix,
+  kSetRows,
+  kSetCols,
+  kOther,
+  kCount
+};
+
+const char* S21OperationName(S21Operation operation);
+
+// Operand shape: rows x cols, and for products the inner dimension as depth
+// (the left operand is rows x depth, the right depth x cols).
+struct S21Shape {
+  int rows;
+  int cols;
+  int depth;
+
+  bool operator<(const S21Shape& other) const {
+    return std::tie(rows, cols, depth) <
+           std::tie(other.rows, other.cols, other.depth);
+  }
+  // "rows x cols", or "rows x depth x cols" for products
+  std::string ToString() const;
+};
+
+struct S21OperationStats {
+  // Upper bounds of the latency buckets: 1 us, 4 us, ... 4^11 us (~4.2 s),
+  // and a last bucket without bound
+  static constexpr int kBuckets = 13;
+
+  std::uint64_t calls = 0;
+  std::uint64_t nanoseconds = 0;
+  std::array<std::uint64_t, kBuckets> latency_buckets{};
+  std::uint64_t flops = 0;
+  std::uint64_t allocated_bytes = 0;
+  std::map<S21Shape, std::uint64_t> shapes;
+
+  static double BucketBound(int bucket);
+};
+
+struct S21StatsSnapshot {
+  std::array<S21OperationStats, static_cast<int>(S21Operation::kCount)>
+      operations;
+
+  const S21OperationStats& operator[](S21Operation operation) const {
+    return operations[static_cast<int>(operation)];
+  }
+  // Prometheus text exposition format: counters for calls, FLOPs, bytes and
+  // shapes and a latency histogram, all labelled by operation
+  std::string ToPrometheus() const;
+  std::string ToJson() const;
+};
+
+// Whether this build records anything
+bool S21StatsEnabled();
+S21StatsSnapshot S21StatsSnapshotNow();
+void S21StatsReset();
+
+// Shapes tracked per operation; calls with further shapes count toward the
+// totals but not the shape distribution.
+constexpr std::size_t kS21StatsMaxShapes = 256;
+
+// Records one call of operation from construction to destruction, unless
+// another one is already running on the thread. Used through
+// S21_STATS_SCOPE.
+class S21StatsScope {
+ public:
+  S21StatsScope(S21Operation operation, S21Shape shape, double flops);
+  ~S21StatsScope();
+  S21StatsScope(const S21StatsScope&) = delete;
+  S21StatsScope& operator=(const S21StatsScope&) = delete;
+
+ private:
+  S21Operation operation_;
+  bool outermost_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+void S21StatsRecordAllocation(std::size_t bytes);
+
+#ifdef S21_MATRIX_STATS
+#define S21_STATS_SCOPE(operation, rows, cols, depth, flops)               \
+  const S21StatsScope s21_stats_scope((operation),                        \
+                                      S21Shape{(rows), (cols), (depth)}, \
+                                      (flops))
+#define S21_STATS_ALLOCATION(bytes) S21StatsRecordAllocation(bytes)
+#else
+#define S21_STATS_SCOPE(operation, rows, cols, depth, flops) ((void)0)
+#define S21_STATS_ALLOCATION(bytes) ((void)0)
+#endif
+
+#endif  // SRC_S21_STATS_H_
@@ -0,0 +1,351 @@
+#include "s21_strassen.h"
+
+#include <algorithm>
+#include <atomic>
+#include <complex>
+#include <type_traits>
+
+#include "s21_gemm.h"
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+// A single level breaks even with the classical kernel at about n = 128
+// and gains 5-15% from there; recursing down to products of 129 to 256
+// saves about 25% at n = 2048 (BM_MulMatrixStrassen).
+constexpr int kDefaultCrossover = 256;
+constexpr std::size_t kWorkAlignment = 64;
+
+std::atomic<S21MulAlgorithm> mul_algorithm{S21MulAlgorithm::kClassical};
+std::atomic<int> strassen_crossover{0};
+
+bool Classical(int m, int n, int k, int crossover) {
+  return std::min({m, n, k}) <= crossover;
+}
+
+// Temporaries start on 64-byte boundaries
+template <typename T>
+std::size_t Round(long elements) {
+  constexpr std::size_t step = std::max<std::size_t>(
+      1, kWorkAlignment / sizeof(T));
+  return (static_cast<std::size_t>(elements) + step - 1) / step * step;
+}
+
+// Workspace of the serial schedule: X and Y at each level, reused by every
+// product of that level
+template <typename T>
+std::size_t SerialWorkspace(int m, int n, int k, int crossover) {
+  std::size_t total = 0;
+  while (!Classical(m, n, k, crossover)) {
+    m /= 2;
+    n /= 2;
+    k /= 2;
+    total += Round<T>(static_cast<long>(m) * std::max(k, n)) +
+             Round<T>(static_cast<long>(k) * n);
+  }
+  return total;
+}
+
+// Workspace of the parallel top level: S1..S4, T1..T4, the three products
+// that do not fit in C, and a serial workspace per product
+template <typename T>
+std::size_t ParallelWorkspace(int m, int n, int k, int crossover) {
+  const int mh = m / 2;
+  const int nh = n / 2;
+  const int kh = k / 2;
+  return 4 * Round<T>(static_cast<long>(mh) * kh) +
+         4 * Round<T>(static_cast<long>(kh) * nh) +
+         3 * Round<T>(static_cast<long>(mh) * nh) +
+         7 * SerialWorkspace<T>(mh, nh, kh, crossover);
+}
+
+bool ParallelTopLevel() { return S21GetThreadCount() > 1; }
+
+// A block of a row-major matrix. Functions take their read-only operands
+// as ReadOnly, which leaves T to be deduced from the output alone, so a
+// mutable block converts where a read-only one is expected.
+template <typename T>
+struct Block {
+  using ReadOnly = Block<const T>;
+
+  Block(T* data_in, int ld_in) : data(data_in), ld(ld_in) {}
+  template <typename U, typename = std::enable_if_t<
+                            std::is_same<const U, T>::value &&
+                            !std::is_same<U, T>::value>>
+  Block(const Block<U>& other) : data(other.data), ld(other.ld) {}
+
+  T* Row(int i) const { return data + static_cast<std::ptrdiff_t>(i) * ld; }
+
+  T* data;
+  int ld;
+};
+
+// Quadrant (i, j) of a block split after row rows and column cols
+template <typename T>
+Block<T> Quadrant(Block<T> block, int i, int j, int rows, int cols) {
+  return {block.Row(i * rows) + j * cols, block.ld};
+}
+
+// z = x + y, or x - y when subtract, over rows x cols; z may be x or y
+template <typename T>
+void AddBlocks(int rows, int cols, typename Block<T>::ReadOnly x,
+               typename Block<T>::ReadOnly y, bool subtract, Block<T> z) {
+  const S21BasicSimdKernels<T>& simd = S21SimdActive<T>();
+  const std::size_t count = static_cast<std::size_t>(cols);
+  S21ParallelFor(0, rows, cols, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    for (std::ptrdiff_t i = begin; i < end; ++i) {
+      const int row = static_cast<int>(i);
+      T* z_row = z.Row(row);
+      const T* x_row = x.Row(row);
+      const T* y_row = y.Row(row);
+      if (z_row == y_row) {
+        // -y + x rounds exactly like x - y
+        if (subtract) simd.scale(z_row, T(-1), count);
+        simd.add(z_row, x_row, count);
+        continue;
+      }
+      if (z_row != x_row) simd.copy(z_row, x_row, count);
+      if (subtract) {
+        simd.sub(z_row, y_row, count);
+      } else {
+        simd.add(z_row, y_row, count);
+      }
+    }
+  });
+}
+
+template <typename T>
+void Add(int rows, int cols, typename Block<T>::ReadOnly x,
+         typename Block<T>::ReadOnly y, Block<T> z) {
+  AddBlocks(rows, cols, x, y, false, z);
+}
+
+template <typename T>
+void Sub(int rows, int cols, typename Block<T>::ReadOnly x,
+         typename Block<T>::ReadOnly y, Block<T> z) {
+  AddBlocks(rows, cols, x, y, true, z);
+}
+
+template <typename T>
+void Multiply(int m, int n, int k, typename Block<T>::ReadOnly a,
+              typename Block<T>::ReadOnly b, Block<T> c, T* work,
+              int crossover);
+
+// Winograd's form of Strassen's identities, for quadrants A11 .. B22:
+//   S1 = A21 + A22  S2 = S1 - A11   S3 = A11 - A21  S4 = A12 - S2
+//   T1 = B12 - B11  T2 = B22 - T1   T3 = B22 - B12  T4 = T2 - B21
+//   P1 = A11 * B11  P2 = A12 * B21  P3 = S4 * B22   P4 = A22 * T4
+//   P5 = S1 * T1    P6 = S2 * T2    P7 = S3 * T3
+//   U2 = P1 + P6    U3 = U2 + P7    U4 = U2 + P5
+//   C11 = U1 = P1 + P2   C12 = U5 = U4 + P3
+//   C21 = U6 = U3 - P4   C22 = U7 = U3 + P5
+
+// The even leading part of C = A * B, all of it from half-size products.
+// With X = work and Y after it, 22 steps in the order of Boyer, Dumas,
+// Pernet and Zhou, "Memory efficient scheduling of Strassen-Winograd's
+// matrix multiplication algorithm" (2009), keeping every product but one in
+// a quadrant of C.
+template <typename T>
+void WinogradSerial(int mh, int nh, int kh, typename Block<T>::ReadOnly a,
+                    typename Block<T>::ReadOnly b, Block<T> c, T* work,
+                    int crossover) {
+  const Block<const T> a11 = Quadrant(a, 0, 0, mh, kh);
+  const Block<const T> a12 = Quadrant(a, 0, 1, mh, kh);
+  const Block<const T> a21 = Quadrant(a, 1, 0, mh, kh);
+  const Block<const T> a22 = Quadrant(a, 1, 1, mh, kh);
+  const Block<const T> b11 = Quadrant(b, 0, 0, kh, nh);
+  const Block<const T> b12 = Quadrant(b, 0, 1, kh, nh);
+  const Block<const T> b21 = Quadrant(b, 1, 0, kh, nh);
+  const Block<const T> b22 = Quadrant(b, 1, 1, kh, nh);
+  const Block<T> c11 = Quadrant(c, 0, 0, mh, nh);
+  const Block<T> c12 = Quadrant(c, 0, 1, mh, nh);
+  const Block<T> c21 = Quadrant(c, 1, 0, mh, nh);
+  const Block<T> c22 = Quadrant(c, 1, 1, mh, nh);
+  const Block<T> x{work, std::max(kh, nh)};
+  T* const y_data = work + Round<T>(static_cast<long>(mh) * x.ld);
+  const Block<T> y{y_data, nh};
+  T* const next = y_data + Round<T>(static_cast<long>(kh) * nh);
+
+  Sub(mh, kh, a11, a21, x);                            // X = S3
+  Sub(kh, nh, b22, b12, y);                            // Y = T3
+  Multiply(mh, nh, kh, x, y, c21, next, crossover);    // C21 = P7
+  Add(mh, kh, a21, a22, x);                            // X = S1
+  Sub(kh, nh, b12, b11, y);                            // Y = T1
+  Multiply(mh, nh, kh, x, y, c22, next, crossover);    // C22 = P5
+  Sub(mh, kh, x, a11, x);                              // X = S2
+  Sub(kh, nh, b22, y, y);                              // Y = T2
+  Multiply(mh, nh, kh, x, y, c12, next, crossover);    // C12 = P6
+  Sub(mh, kh, a12, x, x);                              // X = S4
+  Multiply(mh, nh, kh, x, b22, c11, next, crossover);  // C11 = P3
+  Multiply(mh, nh, kh, a11, b11, x, next, crossover);  // X = P1
+  Add(mh, nh, c12, x, c12);                            // C12 = U2
+  Add(mh, nh, c21, c12, c21);                          // C21 = U3
+  Add(mh, nh, c12, c22, c12);                          // C12 = U4
+  Add(mh, nh, c22, c21, c22);                          // C22 = U7
+  Add(mh, nh, c12, c11, c12);                          // C12 = U5
+  Sub(kh, nh, y, b21, y);                              // Y = T4
+  Multiply(mh, nh, kh, a22, y, c11, next, crossover);  // C11 = P4
+  Sub(mh, nh, c21, c11, c21);                          // C21 = U6
+  Multiply(mh, nh, kh, a12, b21, c11, next, crossover);  // C11 = P2
+  Add(mh, nh, c11, x, c11);                            // C11 = U1
+}
+
+// The same level with the seven products run as parallel tasks. Every
+// operand is formed first, four products go to quadrants of C and three to
+// temporaries, and the sums follow once all of them are done.
+template <typename T>
+void WinogradParallel(int mh, int nh, int kh, typename Block<T>::ReadOnly a,
+                      typename Block<T>::ReadOnly b, Block<T> c, T* work,
+                      int crossover) {
+  const Block<const T> a11 = Quadrant(a, 0, 0, mh, kh);
+  const Block<const T> a12 = Quadrant(a, 0, 1, mh, kh);
+  const Block<const T> a21 = Quadrant(a, 1, 0, mh, kh);
+  const Block<const T> a22 = Quadrant(a, 1, 1, mh, kh);
+  const Block<const T> b11 = Quadrant(b, 0, 0, kh, nh);
+  const Block<const T> b12 = Quadrant(b, 0, 1, kh, nh);
+  const Block<const T> b21 = Quadrant(b, 1, 0, kh, nh);
+  const Block<const T> b22 = Quadrant(b, 1, 1, kh, nh);
+  const Block<T> c11 = Quadrant(c, 0, 0, mh, nh);
+  const Block<T> c12 = Quadrant(c, 0, 1, mh, nh);
+  const Block<T> c21 = Quadrant(c, 1, 0, mh, nh);
+  const Block<T> c22 = Quadrant(c, 1, 1, mh, nh);
+  // Carves the next rows x cols temporary out of work
+  const auto take = [&work](int rows, int cols) {
+    const Block<T> block(work, cols);
+    work += Round<T>(static_cast<long>(rows) * cols);
+    return block;
+  };
+  const Block<T> s1 = take(mh, kh);
+  const Block<T> s2 = take(mh, kh);
+  const Block<T> s3 = take(mh, kh);
+  const Block<T> s4 = take(mh, kh);
+  const Block<T> t1 = take(kh, nh);
+  const Block<T> t2 = take(kh, nh);
+  const Block<T> t3 = take(kh, nh);
+  const Block<T> t4 = take(kh, nh);
+  const Block<T> p1 = take(mh, nh);
+  const Block<T> p2 = take(mh, nh);
+  const Block<T> p4 = take(mh, nh);
+  const std::size_t child = SerialWorkspace<T>(mh, nh, kh, crossover);
+
+  Add(mh, kh, a21, a22, s1);
+  Sub(mh, kh, s1, a11, s2);
+  Sub(mh, kh, a11, a21, s3);
+  Sub(mh, kh, a12, s2, s4);
+  Sub(kh, nh, b12, b11, t1);
+  Sub(kh, nh, b22, t1, t2);
+  Sub(kh, nh, b22, b12, t3);
+  Sub(kh, nh, t2, b21, t4);
+  const Block<const T> left[7] = {a11, a12, s4, a22, s1, s2, s3};
+  const Block<const T> right[7] = {b11, b21, b22, t4, t1, t2, t3};
+  const Block<T> product[7] = {p1, p2, c11, p4, c22, c12, c21};
+  S21ParallelFor(0, 7, 2.0 * mh * nh * kh,
+                 [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                   for (std::ptrdiff_t i = begin; i < end; ++i) {
+                     Multiply(mh, nh, kh, left[i], right[i], product[i],
+                              work + i * child, crossover);
+                   }
+                 });
+  Add(mh, nh, c12, p1, c12);   // U2 = P1 + P6
+  Add(mh, nh, c21, c12, c21);  // U3 = U2 + P7
+  Add(mh, nh, c12, c22, c12);  // U4 = U2 + P5
+  Add(mh, nh, c22, c21, c22);  // U7 = U3 + P5
+  Add(mh, nh, c12, c11, c12);  // U5 = U4 + P3
+  Sub(mh, nh, c21, p4, c21);   // U6 = U3 - P4
+  Add(mh, nh, p1, p2, c11);    // U1 = P1 + P2
+}
+
+// The last row, column and rank-1 term left over by odd dimensions
+template <typename T>
+void Peel(int m, int n, int k, typename Block<T>::ReadOnly a,
+          typename Block<T>::ReadOnly b, Block<T> c) {
+  const int m2 = m - m % 2;
+  const int n2 = n - n % 2;
+  const int k2 = k - k % 2;
+  if (k2 != k) {
+    S21Gemm(m2, n2, 1, T(1), a.data + k2, a.ld, b.Row(k2), b.ld, T(1),
+            c.data, c.ld);
+  }
+  if (n2 != n) {
+    S21Gemm(m, 1, k, T(1), a.data, a.ld, b.data + n2, b.ld, T(0),
+            c.data + n2, c.ld);
+  }
+  if (m2 != m) {
+    S21Gemm(1, n2, k, T(1), a.Row(m2), a.ld, b.data, b.ld, T(0), c.Row(m2),
+            c.ld);
+  }
+}
+
+template <typename T>
+void Multiply(int m, int n, int k, typename Block<T>::ReadOnly a,
+              typename Block<T>::ReadOnly b, Block<T> c, T* work,
+              int crossover) {
+  if (Classical(m, n, k, crossover)) {
+    S21Gemm(m, n, k, T(1), a.data, a.ld, b.data, b.ld, T(0), c.data, c.ld);
+    return;
+  }
+  WinogradSerial(m / 2, n / 2, k / 2, a, b, c, work, crossover);
+  Peel(m, n, k, a, b, c);
+}
+
+}  // namespace
+
+void S21SetMulAlgorithm(S21MulAlgorithm algorithm) {
+  mul_algorithm.store(algorithm);
+}
+
+S21MulAlgorithm S21GetMulAlgorithm() { return mul_algorithm.load(); }
+
+void S21SetStrassenCrossover(int size) {
+  strassen_crossover.store(std::max(size, 0));
+}
+
+int S21GetStrassenCrossover() {
+  const int size = strassen_crossover.load();
+  return size > 0 ? size : kDefaultCrossover;
+}
+
+bool S21StrassenApplies(int m, int n, int k) {
+  return !Classical(m, n, k, S21GetStrassenCrossover());
+}
+
+template <typename T>
+std::size_t S21StrassenWorkspace(int m, int n, int k) {
+  const int crossover = S21GetStrassenCrossover();
+  if (Classical(m, n, k, crossover)) return 0;
+  return ParallelTopLevel() ? ParallelWorkspace<T>(m, n, k, crossover)
+                            : SerialWorkspace<T>(m, n, k, crossover);
+}
+
+template <typename T>
+void S21Strassen(int m, int n, int k, const T* a, int lda, const T* b,
+                 int ldb, T* c, int ldc, T* work) {
+  const int crossover = S21GetStrassenCrossover();
+  const Block<const T> a_block{a, lda};
+  const Block<const T> b_block{b, ldb};
+  const Block<T> c_block{c, ldc};
+  if (Classical(m, n, k, crossover) || !ParallelTopLevel()) {
+    Multiply(m, n, k, a_block, b_block, c_block, work, crossover);
+    return;
+  }
+  WinogradParallel(m / 2, n / 2, k / 2, a_block, b_block, c_block, work,
+                   crossover);
+  Peel(m, n, k, a_block, b_block, c_block);
+}
+
+template std::size_t S21StrassenWorkspace<float>(int, int, int);
+template std::size_t S21StrassenWorkspace<double>(int, int, int);
+template std::size_t S21StrassenWorkspace<long double>(int, int, int);
+template std::size_t S21StrassenWorkspace<std::complex<double>>(int, int,
+                                                                int);
+template void S21Strassen(int, int, int, const float*, int, const float*, int,
+                          float*, int, float*);
+template void S21Strassen(int, int, int, const double*, int, const double*,
+                          int, double*, int, double*);
+template void S21Strassen(int, int, int, const long double*, int,
+                          const long double*, int, long double*, int,
+                          long double*);
+template void S21Strassen(int, int, int, const std::complex<double>*, int,
+                          const std::complex<double>*, int,
+                          std::complex<double>*, int, std::complex<double>*);
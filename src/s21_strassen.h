@@ -0,0 +1,47 @@
+#ifndef SRC_S21_STRASSEN_H_
+#define SRC_S21_STRASSEN_H_
+
+#include <cstddef>
+
+// Strassen-Winograd multiplication: 7 half-size products and 15 block
+// additions per level instead of 8 products, recursing until a dimension
+// reaches the crossover and finishing with S21Gemm. Odd dimensions are
+// peeled: the even leading part recurses and the last row, column or
+// rank-1 term is added by S21Gemm. The error bound grows with the depth of
+// the recursion rather than staying elementwise as for the classical
+// product, which is why the mode is opt-in.
+
+// Which kernel MulMatrix and operator* use for the product of two
+// matrices. kStrassen only applies once every dimension of the product
+// exceeds the crossover; Gemm always runs the classical kernel. The
+// setting is process-wide, like the thread count.
+enum class S21MulAlgorithm { kClassical, kStrassen };
+
+void S21SetMulAlgorithm(S21MulAlgorithm algorithm);
+S21MulAlgorithm S21GetMulAlgorithm();
+// Products whose smallest dimension is at most size run classically.
+// Passing 0 restores the default, measured with BM_MulMatrixStrassen.
+void S21SetStrassenCrossover(int size);
+int S21GetStrassenCrossover();
+
+// True when S21Strassen would recurse at least once for an m x k by k x n
+// product.
+bool S21StrassenApplies(int m, int n, int k);
+
+// Elements of T that S21Strassen needs as workspace for this product under
+// the current crossover and thread count. With more than one thread the
+// seven products of the top level run in parallel, each with its own
+// operands and workspace, which takes several times the memory of the
+// serial schedule.
+template <typename T>
+std::size_t S21StrassenWorkspace(int m, int n, int k);
+
+// C = A * B for row-major A (m x k) and B (k x n) as in S21Gemm with
+// alpha = 1 and beta = 0. work holds S21StrassenWorkspace<T>(m, n, k)
+// elements, preferably 64-byte aligned, and the settings must not change
+// between the two calls. C must not overlap A, B or work.
+template <typename T>
+void S21Strassen(int m, int n, int k, const T* a, int lda, const T* b,
+                 int ldb, T* c, int ldc, T* work);
+
+#endif  // SRC_S21_STRASSEN_H_
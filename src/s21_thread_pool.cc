@@ -0,0 +1,219 @@
+#include "s21_thread_pool.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <utility>
+
+namespace {
+
+// Which pool, if any, the current thread works for, and its queue index.
+thread_local const S21ThreadPool* tls_pool = nullptr;
+thread_local int tls_queue = 0;
+
+// Upper bound on chunks per thread; more chunks balance better, fewer cost
+// less in queue traffic.
+constexpr std::ptrdiff_t kChunksPerThread = 4;
+
+std::mutex config_mutex;
+int configured_threads = 0;
+std::unique_ptr<S21ThreadPool> shared_pool;
+std::atomic<std::size_t> parallel_grain{std::size_t{1} << 14};
+std::atomic<std::size_t> serial_threshold{std::size_t{1} << 16};
+
+int DefaultThreadCount() {
+  int threads = 0;
+  if (const char* env = std::getenv("S21_NUM_THREADS")) {
+    threads = static_cast<int>(std::strtol(env, nullptr, 10));
+  }
+  if (threads <= 0) {
+    threads = static_cast<int>(std::thread::hardware_concurrency());
+  }
+  return std::max(threads, 1);
+}
+
+int ThreadCountLocked() {
+  return configured_threads > 0 ? configured_threads : DefaultThreadCount();
+}
+
+S21ThreadPool& SharedPool() {
+  std::lock_guard<std::mutex> lock(config_mutex);
+  if (!shared_pool) {
+    shared_pool = std::make_unique<S21ThreadPool>(ThreadCountLocked());
+  }
+  return *shared_pool;
+}
+
+}  // namespace
+
+// S21ThreadPool
+
+S21ThreadPool::S21ThreadPool(int threads) : queued_(0), stop_(false) {
+  const int workers = std::max(threads, 1) - 1;
+  for (int i = 0; i <= workers; ++i) {
+    queues_.push_back(std::make_unique<TaskQueue>());
+  }
+  for (int i = 1; i <= workers; ++i) {
+    workers_.emplace_back(&S21ThreadPool::WorkerLoop, this, i);
+  }
+}
+
+S21ThreadPool::~S21ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (std::thread& worker : workers_) worker.join();
+  // Workers drain the queues before they exit; without any, submitted
+  // tasks may still be waiting in the shared queue.
+  while (RunOne()) {}
+}
+
+int S21ThreadPool::GetThreadCount() const {
+  return static_cast<int>(workers_.size()) + 1;
+}
+
+void S21ThreadPool::ParallelFor(
+    std::ptrdiff_t begin, std::ptrdiff_t end, std::ptrdiff_t grain,
+    const std::function<void(std::ptrdiff_t, std::ptrdiff_t)>& body) {
+  const std::ptrdiff_t count = end - begin;
+  if (count <= 0) return;
+  grain = std::max<std::ptrdiff_t>(grain, 1);
+  const std::ptrdiff_t max_chunks =
+      kChunksPerThread * static_cast<std::ptrdiff_t>(GetThreadCount());
+  const std::ptrdiff_t chunks =
+      std::min((count + grain - 1) / grain, max_chunks);
+  if (chunks <= 1 || workers_.empty()) {
+    body(begin, end);
+    return;
+  }
+  const std::ptrdiff_t chunk_size = (count + chunks - 1) / chunks;
+  std::atomic<std::ptrdiff_t> remaining(chunks);
+  std::mutex error_mutex;
+  std::exception_ptr error;
+  auto run_chunk = [&](std::ptrdiff_t chunk) {
+    const std::ptrdiff_t chunk_begin = begin + chunk * chunk_size;
+    const std::ptrdiff_t chunk_end = std::min(end, chunk_begin + chunk_size);
+    try {
+      if (chunk_begin < chunk_end) body(chunk_begin, chunk_end);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(error_mutex);
+      if (!error) error = std::current_exception();
+    }
+    remaining.fetch_sub(1, std::memory_order_release);
+  };
+  for (std::ptrdiff_t chunk = chunks - 1; chunk > 0; --chunk) {
+    Push([&run_chunk, chunk] { run_chunk(chunk); });
+  }
+  run_chunk(0);
+  // Help out instead of blocking, so tasks queued behind this call by
+  // nested loops still make progress.
+  while (remaining.load(std::memory_order_acquire) > 0) {
+    if (!RunOne()) std::this_thread::yield();
+  }
+  if (error) std::rethrow_exception(error);
+}
+
+void S21ThreadPool::Submit(std::function<void()> task) {
+  Push(std::move(task));
+}
+
+bool S21ThreadPool::RunQueuedTask() { return RunOne(); }
+
+void S21ThreadPool::Push(Task task) {
+  TaskQueue& queue = *queues_[tls_pool == this ? tls_queue : 0];
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(std::move(task));
+  }
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    queued_.fetch_add(1, std::memory_order_relaxed);
+  }
+  wake_.notify_one();
+}
+
+bool S21ThreadPool::RunOne() {
+  const int self = tls_pool == this ? tls_queue : 0;
+  const int queue_count = static_cast<int>(queues_.size());
+  Task task;
+  for (int offset = 0; offset < queue_count && !task; ++offset) {
+    TaskQueue& queue = *queues_[(self + offset) % queue_count];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      // Newest task from our own queue, oldest one from anybody else's.
+      if (offset == 0) {
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+      } else {
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+      }
+    }
+  }
+  if (task) {
+    queued_.fetch_sub(1, std::memory_order_relaxed);
+    task();
+  }
+  return static_cast<bool>(task);
+}
+
+void S21ThreadPool::WorkerLoop(int index) {
+  tls_pool = this;
+  tls_queue = index;
+  for (;;) {
+    if (RunOne()) continue;
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    wake_.wait(lock, [this] {
+      return stop_ || queued_.load(std::memory_order_relaxed) > 0;
+    });
+    if (stop_ && queued_.load(std::memory_order_relaxed) == 0) return;
+  }
+}
+
+void S21Submit(std::function<void()> task) {
+  SharedPool().Submit(std::move(task));
+}
+
+bool S21RunQueuedTask() { return SharedPool().RunQueuedTask(); }
+
+// Configuration
+
+void S21SetThreadCount(int threads) {
+  std::lock_guard<std::mutex> lock(config_mutex);
+  configured_threads = std::max(threads, 0);
+  shared_pool.reset();
+}
+
+int S21GetThreadCount() {
+  std::lock_guard<std::mutex> lock(config_mutex);
+  return ThreadCountLocked();
+}
+
+void S21SetParallelGrain(std::size_t grain) {
+  parallel_grain.store(std::max<std::size_t>(grain, 1));
+}
+
+void S21SetSerialThreshold(std::size_t threshold) {
+  serial_threshold.store(threshold);
+}
+
+std::size_t S21GetParallelGrain() { return parallel_grain.load(); }
+
+std::size_t S21GetSerialThreshold() { return serial_threshold.load(); }
+
+void S21ParallelFor(std::ptrdiff_t begin, std::ptrdiff_t end,
+                    double cost_per_index, S21RangeBody body) {
+  const std::ptrdiff_t count = end - begin;
+  if (count <= 0) return;
+  cost_per_index = std::max(cost_per_index, 1.0);
+  if (count == 1 ||
+      count * cost_per_index < static_cast<double>(serial_threshold.load())) {
+    body(begin, end);
+    return;
+  }
+  const auto grain = static_cast<std::ptrdiff_t>(
+      static_cast<double>(parallel_grain.load()) / cost_per_index + 1);
+  SharedPool().ParallelFor(begin, end, grain, body);
+}
@@ -0,0 +1,114 @@
+#ifndef SRC_S21_THREAD_POOL_H_
+#define SRC_S21_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Work-stealing pool shared by every parallel S21Matrix kernel. Each worker
+// owns a deque: it pops its newest task and, once empty, steals the oldest
+// task of another queue. Threads outside the pool submit through an extra
+// shared queue. A thread waiting in ParallelFor keeps running queued tasks,
+// so nested parallel calls (a GEMM inside a parallel LU, say) cannot
+// deadlock the pool.
+class S21ThreadPool {
+ public:
+  // threads counts the calling thread, so threads - 1 workers are started.
+  explicit S21ThreadPool(int threads);
+  ~S21ThreadPool();
+  S21ThreadPool(const S21ThreadPool&) = delete;
+  S21ThreadPool& operator=(const S21ThreadPool&) = delete;
+
+  int GetThreadCount() const;
+  // Calls body(chunk_begin, chunk_end) over [begin, end) split into chunks
+  // of at least grain indices, and returns once all of them have run. The
+  // first exception thrown by body is rethrown here.
+  void ParallelFor(std::ptrdiff_t begin, std::ptrdiff_t end,
+                   std::ptrdiff_t grain,
+                   const std::function<void(std::ptrdiff_t, std::ptrdiff_t)>&
+                       body);
+  // Queues task without waiting for it. It runs on a worker, on a thread
+  // helping out in ParallelFor or RunQueuedTask, or at the latest when the
+  // pool is destroyed; with a single thread only the last two.
+  void Submit(std::function<void()> task);
+  // Runs one queued task on the calling thread; false when there was none.
+  bool RunQueuedTask();
+
+ private:
+  using Task = std::function<void()>;
+  struct TaskQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  void Push(Task task);
+  bool RunOne();
+  void WorkerLoop(int index);
+
+  // queues_[0] is the shared queue of outside threads, queues_[i] belongs to
+  // worker i.
+  std::vector<std::unique_ptr<TaskQueue>> queues_;
+  std::vector<std::thread> workers_;
+  std::atomic<long> queued_;
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  bool stop_;
+};
+
+// Threads used by parallel S21Matrix operations, the caller included. The
+// default comes from the S21_NUM_THREADS environment variable, falling back
+// to std::thread::hardware_concurrency(). Passing 0 restores that default.
+// Must not be called while a parallel operation is running.
+void S21SetThreadCount(int threads);
+int S21GetThreadCount();
+
+// Work is measured in the cost units each kernel passes to S21ParallelFor
+// (roughly one unit per element or multiply-add). Loops cheaper than the
+// serial threshold run on the calling thread; parallel chunks are sized to
+// at least the grain.
+void S21SetParallelGrain(std::size_t grain);
+void S21SetSerialThreshold(std::size_t threshold);
+std::size_t S21GetParallelGrain();
+std::size_t S21GetSerialThreshold();
+
+// Submit and RunQueuedTask on the shared pool, for work that outlives the
+// call that queues it (see s21_matrix_async.h).
+void S21Submit(std::function<void()> task);
+bool S21RunQueuedTask();
+
+// Non-owning reference to a callable taking a chunk [begin, end). Unlike
+// std::function it never allocates, so loops that stay serial make no
+// calls to the global allocator. The callable must outlive the reference.
+class S21RangeBody {
+ public:
+  template <typename F, typename = std::enable_if_t<!std::is_same_v<
+                            std::decay_t<F>, S21RangeBody>>>
+  S21RangeBody(F&& body)  // NOLINT(runtime/explicit)
+      : object_(const_cast<void*>(
+            static_cast<const void*>(std::addressof(body)))),
+        call_([](void* object, std::ptrdiff_t begin, std::ptrdiff_t end) {
+          (*static_cast<std::remove_reference_t<F>*>(object))(begin, end);
+        }) {}
+
+  void operator()(std::ptrdiff_t begin, std::ptrdiff_t end) const {
+    call_(object_, begin, end);
+  }
+
+ private:
+  void* object_;
+  void (*call_)(void*, std::ptrdiff_t, std::ptrdiff_t);
+};
+
+// Runs body over [begin, end) on the shared pool when the loop is worth it,
+// cost_per_index being the work of a single index.
+void S21ParallelFor(std::ptrdiff_t begin, std::ptrdiff_t end,
+                    double cost_per_index, S21RangeBody body);
+
+#endif  // SRC_S21_THREAD_POOL_H_
@@ -0,0 +1,137 @@
+#include "s21_transpose.h"
+
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "s21_thread_pool.h"
+
+namespace {
+
+// 32 x 32 doubles are 8 KiB per side, so a source and a destination tile
+// sit in L1 together.
+constexpr int kTile = 32;
+
+template <typename T>
+void TransposeTile(int rows, int cols, const T* src, int lds, T* dst,
+                   int ldd) {
+  for (int i = 0; i < rows; ++i) {
+    const T* src_row = src + static_cast<std::ptrdiff_t>(i) * lds;
+    for (int j = 0; j < cols; ++j) {
+      dst[static_cast<std::ptrdiff_t>(j) * ldd + i] = src_row[j];
+    }
+  }
+}
+
+template <typename T>
+void TransposeRecursive(int rows, int cols, const T* src, int lds, T* dst,
+                        int ldd) {
+  if (rows <= kTile && cols <= kTile) {
+    TransposeTile(rows, cols, src, lds, dst, ldd);
+  } else if (rows >= cols) {
+    const int half = rows / 2;
+    TransposeRecursive(half, cols, src, lds, dst, ldd);
+    TransposeRecursive(rows - half, cols,
+                       src + static_cast<std::ptrdiff_t>(half) * lds, lds,
+                       dst + half, ldd);
+  } else {
+    const int half = cols / 2;
+    TransposeRecursive(rows, half, src, lds, dst, ldd);
+    TransposeRecursive(rows, cols - half, src + half, lds,
+                       dst + static_cast<std::ptrdiff_t>(half) * ldd, ldd);
+  }
+}
+
+// Swaps tile (i, j) with the transpose of tile (j, i); both are rows x cols
+// seen from the first one.
+template <typename T>
+void SwapTiles(int rows, int cols, T* upper, T* lower, int lda) {
+  for (int i = 0; i < rows; ++i) {
+    T* upper_row = upper + static_cast<std::ptrdiff_t>(i) * lda;
+    for (int j = 0; j < cols; ++j) {
+      std::swap(upper_row[j], lower[static_cast<std::ptrdiff_t>(j) * lda + i]);
+    }
+  }
+}
+
+}  // namespace
+
+template <typename T>
+void S21Transpose(int rows, int cols, const T* src, int lds, T* dst, int ldd) {
+  // Bands of source rows are independent; each is transposed recursively.
+  const int bands = (rows + kTile - 1) / kTile;
+  S21ParallelFor(0, bands, static_cast<double>(kTile) * cols,
+                 [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                   const int row_begin = static_cast<int>(begin) * kTile;
+                   const int row_end =
+                       std::min(rows, static_cast<int>(end) * kTile);
+                   TransposeRecursive(
+                       row_end - row_begin, cols,
+                       src + static_cast<std::ptrdiff_t>(row_begin) * lds, lds,
+                       dst + row_begin, ldd);
+                 });
+}
+
+template <typename T>
+void S21TransposeSquare(int n, T* a, int lda) {
+  const int tiles = (n + kTile - 1) / kTile;
+  // Tile row ti owns the swaps with every tile to its right, so tasks never
+  // touch the same elements.
+  S21ParallelFor(
+      0, tiles, static_cast<double>(kTile) * n / 2,
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (int ti = static_cast<int>(begin); ti < end; ++ti) {
+          const int i0 = ti * kTile;
+          const int rows = std::min(kTile, n - i0);
+          T* diagonal = a + static_cast<std::ptrdiff_t>(i0) * lda + i0;
+          for (int i = 0; i < rows; ++i) {
+            for (int j = i + 1; j < rows; ++j) {
+              std::swap(diagonal[static_cast<std::ptrdiff_t>(i) * lda + j],
+                        diagonal[static_cast<std::ptrdiff_t>(j) * lda + i]);
+            }
+          }
+          for (int j0 = i0 + kTile; j0 < n; j0 += kTile) {
+            SwapTiles(rows, std::min(kTile, n - j0),
+                      a + static_cast<std::ptrdiff_t>(i0) * lda + j0,
+                      a + static_cast<std::ptrdiff_t>(j0) * lda + i0, lda);
+          }
+        }
+      });
+}
+
+template <typename T>
+void S21TransposePacked(int rows, int cols, T* a) {
+  const std::ptrdiff_t size = static_cast<std::ptrdiff_t>(rows) * cols;
+  // Element k = i * cols + j moves to j * rows + i; the first and last
+  // elements are fixed points.
+  std::vector<bool> moved(static_cast<std::size_t>(size));
+  for (std::ptrdiff_t start = 1; start + 1 < size; ++start) {
+    if (moved[start]) continue;
+    std::ptrdiff_t position = start;
+    T carried = a[start];
+    do {
+      const std::ptrdiff_t target =
+          (position % cols) * rows + position / cols;
+      std::swap(carried, a[target]);
+      moved[target] = true;
+      position = target;
+    } while (position != start);
+  }
+}
+
+template void S21Transpose(int, int, const float*, int, float*, int);
+template void S21Transpose(int, int, const double*, int, double*, int);
+template void S21Transpose(int, int, const long double*, int, long double*,
+                           int);
+template void S21Transpose(int, int, const std::complex<double>*, int,
+                           std::complex<double>*, int);
+template void S21TransposeSquare(int, float*, int);
+template void S21TransposeSquare(int, double*, int);
+template void S21TransposeSquare(int, long double*, int);
+template void S21TransposeSquare(int, std::complex<double>*, int);
+template void S21TransposePacked(int, int, float*);
+template void S21TransposePacked(int, int, double*);
+template void S21TransposePacked(int, int, long double*);
+template void S21TransposePacked(int, int, std::complex<double>*);
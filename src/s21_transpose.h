@@ -0,0 +1,25 @@
+#ifndef SRC_S21_TRANSPOSE_H_
+#define SRC_S21_TRANSPOSE_H_
+
+// Transpose kernels behind S21BasicMatrix::Transpose and TransposeInPlace.
+// All matrices are row-major with an explicit leading dimension. Defined for
+// float, double, long double and std::complex<double>.
+
+// dst (cols x rows) = src (rows x cols)^T. Cache-oblivious: the larger
+// dimension is halved until a block fits in L1, so both the reads and the
+// strided writes stay within a few pages at a time. src and dst must not
+// overlap.
+template <typename T>
+void S21Transpose(int rows, int cols, const T* src, int lds, T* dst, int ldd);
+
+// Transposes the square n x n matrix a in place by swapping mirrored tiles.
+template <typename T>
+void S21TransposeSquare(int n, T* a, int lda);
+
+// Transposes a packed rows x cols matrix (leading dimension cols) in place
+// into a packed cols x rows one by following the cycles of the permutation.
+// Needs one bit of scratch per element.
+template <typename T>
+void S21TransposePacked(int rows, int cols, T* a);
+
+#endif  // SRC_S21_TRANSPOSE_H_